@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/batch.h"
+#include "../src/parser.h"
+
+// строк в секунду для max(a, abs(b)) - sqr(c) * 8 над столбцами из range(0) строк
+// RowLoop - Expression::Evaluate на каждую строку (вектор значений переменных заполняется заново, но не выделяется),
+// Batch - BatchEvaluator, который выполняет каждую команду сразу над блоком строк
+
+static const std::string kFormula = "max(a, abs(b)) - sqr(c) * 8";
+
+struct Columns {
+    std::vector<int> a;
+    std::vector<int> b;
+    std::vector<int> c;
+};
+
+static Columns MakeColumns(size_t rows) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> value(-10000, 10000);
+    Columns columns;
+    for (size_t i = 0; i < rows; ++i) {
+        columns.a.push_back(value(rng));
+        columns.b.push_back(value(rng));
+        columns.c.push_back(value(rng));
+    }
+    return columns;
+}
+
+static void BM_RowLoop(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const Columns columns = MakeColumns(rows);
+    const Expression expression = Compile(kFormula);
+    std::vector<int> result(rows);
+    std::vector<int> values(3);
+    for (auto _ : state) {
+        for (size_t i = 0; i < rows; ++i) {
+            values[0] = columns.a[i];
+            values[1] = columns.b[i];
+            values[2] = columns.c[i];
+            result[i] = expression.Evaluate(values);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Batch(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const Columns columns = MakeColumns(rows);
+    BatchEvaluator batch(Compile(kFormula));
+    batch.Bind("a", columns.a.data());
+    batch.Bind("b", columns.b.data());
+    batch.Bind("c", columns.c.data());
+    std::vector<int> result(rows);
+    for (auto _ : state) {
+        batch.Evaluate(rows, result.data());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RowLoop)->ArgName("rows")->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Batch)->ArgName("rows")->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include "../src/batch_driver.h"
+
+// сквозная скорость BatchDriver в байтах входа в секунду на файле из kLines выражений (около 16 МБ)
+// ReadFile - нижняя граница: отобразить тот же файл и найти все концы строк, ничего не разбирая
+// Tokenize и Evaluate - BatchDriver в буфер, EvaluateFile - из файла в файл; аргумент threads - число рабочих потоков,
+// и масштабирование по нему видно только на машине, где ядер не меньше
+
+static constexpr size_t kLines = 1 << 18;
+
+static const std::string& InputPath() {
+    static const std::string path = [] {
+        const std::string file = (std::filesystem::temp_directory_path() / "calculator_driver_input.txt").string();
+        std::mt19937 rng(3);
+        std::string text;
+        for (size_t i = 0; i < kLines; ++i) {
+            auto n = [&rng] { return std::to_string(rng() % 1000); };
+            text += "(max(" + n() + ", abs(" + n() + " - " + n() + ")) - sqr(" + n() + ")) * " + n() + "\n";
+        }
+        std::FILE* out = std::fopen(file.c_str(), "wb");
+        std::fwrite(text.data(), 1, text.size(), out);
+        std::fclose(out);
+        return file;
+    }();
+    return path;
+}
+
+static void BM_ReadFile(benchmark::State& state) {
+    const MappedFile input(InputPath());
+    const std::string_view data = input.Data();
+    for (auto _ : state) {
+        size_t lines = 0;
+        for (const char* p = data.data(); (p = static_cast<const char*>(std::memchr(p, '\n', data.data() + data.size() - p)));
+             ++p) {
+            ++lines;
+        }
+        benchmark::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(data.size()));
+}
+
+template <DriverMode Mode>
+static void BM_Driver(benchmark::State& state) {
+    const MappedFile input(InputPath());
+    const BatchDriver driver(Mode, static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string output = driver.Run(input.Data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(input.Data().size()));
+}
+
+static void BM_EvaluateFile(benchmark::State& state) {
+    const std::string output = (std::filesystem::temp_directory_path() / "calculator_driver_output.txt").string();
+    const BatchDriver driver(DriverMode::kEvaluate, static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        driver.RunFile(InputPath(), output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(std::filesystem::file_size(InputPath())));
+    std::filesystem::remove(output);
+}
+
+BENCHMARK(BM_ReadFile)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Driver, DriverMode::kTokenize)->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Driver, DriverMode::kEvaluate)->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_EvaluateFile)->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <variant>
+#include "../src/parser.h"
+
+// вычислений в секунду на примере из main.cc; & в нем неизвестный токен, поэтому берется выражение без "& 9"
+// Bytecode - уже скомпилированное выражение, Ast - для сравнения обход дерева из std::variant, который байткод заменяет
+// (дерево строится из того же байткода, так что вычисляет ровно то же), Compile - каждый раз Tokenize, Parse и Evaluate
+
+static const std::string kSample = "(max(123, abs(456)) - sqr(7)) * 8";
+
+struct AstNode;
+using AstPtr = std::unique_ptr<AstNode>;
+struct AstNumber {
+    int value;
+};
+struct AstUnary {
+    OpCode op;
+    AstPtr operand;
+};
+struct AstBinary {
+    OpCode op;
+    AstPtr left;
+    AstPtr right;
+};
+struct AstNode {
+    std::variant<AstNumber, AstUnary, AstBinary> node;
+};
+
+static AstPtr BuildAst(const Expression& expression) {
+    std::vector<AstPtr> stack;
+    size_t constant = 0;
+    for (OpCode op : expression.Code()) {
+        if (op == OpCode::kPush) {
+            stack.push_back(std::make_unique<AstNode>(AstNode{AstNumber{expression.Constants()[constant++]}}));
+        } else if (op == OpCode::kNegate || op == OpCode::kAbs || op == OpCode::kSqr) {
+            AstPtr operand = std::move(stack.back());
+            stack.back() = std::make_unique<AstNode>(AstNode{AstUnary{op, std::move(operand)}});
+        } else {
+            AstPtr right = std::move(stack.back());
+            stack.pop_back();
+            AstPtr left = std::move(stack.back());
+            stack.back() = std::make_unique<AstNode>(AstNode{AstBinary{op, std::move(left), std::move(right)}});
+        }
+    }
+    return std::move(stack.back());
+}
+
+static int Apply(OpCode op, int a, int b) {
+    switch (op) {
+    case OpCode::kAdd: return WrapAdd(a, b);
+    case OpCode::kSubtract: return WrapSubtract(a, b);
+    case OpCode::kMultiply: return WrapMultiply(a, b);
+    case OpCode::kDivide: return CheckedDivide(a, b);
+    case OpCode::kModulo: return CheckedModulo(a, b);
+    case OpCode::kMin: return b < a ? b : a;
+    case OpCode::kMax: return b > a ? b : a;
+    case OpCode::kNegate: return WrapSubtract(0, a);
+    case OpCode::kAbs: return a < 0 ? WrapSubtract(0, a) : a;
+    case OpCode::kSqr: return WrapMultiply(a, a);
+    default: return a;
+    }
+}
+
+static int EvaluateAst(const AstNode& node) {
+    return std::visit([](const auto& n) -> int {
+        using Node = std::decay_t<decltype(n)>;
+        if constexpr (std::is_same_v<Node, AstNumber>) {
+            return n.value;
+        } else if constexpr (std::is_same_v<Node, AstUnary>) {
+            return Apply(n.op, EvaluateAst(*n.operand), 0);
+        } else {
+            return Apply(n.op, EvaluateAst(*n.left), EvaluateAst(*n.right));
+        }
+    }, node.node);
+}
+
+// =============================================================================
+
+static void BM_EvaluateBytecode(benchmark::State& state) {
+    const Expression expression = Compile(kSample);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expression.Evaluate());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_EvaluateAst(benchmark::State& state) {
+    const AstPtr ast = BuildAst(Compile(kSample));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(EvaluateAst(*ast));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_CompileAndEvaluate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Compile(kSample).Evaluate());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_EvaluateBytecode);
+BENCHMARK(BM_EvaluateAst);
+BENCHMARK(BM_CompileAndEvaluate);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/expression_cache.h"
+
+// вычислений в секунду на смеси выражений с распределением Ципфа: kDistinct разных строк, i-я по популярности
+// встречается с вероятностью, пропорциональной 1 / i^kZipfExponent; последовательность запросов строится заранее
+// NoCache - Compile и Evaluate на каждый запрос; Cache - ExpressionCache с бюджетом range(0) КБ, при 8192 КБ
+// помещаются все выражения, при меньших бюджетах часть вытесняется; hit_rate - доля попаданий за весь замер
+// Threads - те же запросы из нескольких потоков в один общий кэш
+
+static constexpr size_t kDistinct = 4096;
+static constexpr size_t kRequests = 1 << 20;
+static constexpr double kZipfExponent = 1.0;
+
+static const std::vector<std::string>& Expressions() {
+    static const std::vector<std::string> expressions = [] {
+        std::vector<std::string> result;
+        std::mt19937 rng(42);
+        for (size_t i = 0; i < kDistinct; ++i) {
+            auto n = [&rng] { return std::to_string(rng() % 1000); };
+            result.push_back("(max(" + n() + ", abs(" + n() + " - " + n() + ")) - sqr(" + n() + ")) * " + n() + " % (min("
+                             + n() + ", " + n() + ") + 1)");
+        }
+        return result;
+    }();
+    return expressions;
+}
+
+static const std::vector<unsigned>& Requests() {
+    static const std::vector<unsigned> requests = [] {
+        std::vector<double> cdf(kDistinct);
+        double sum = 0;
+        for (size_t i = 0; i < kDistinct; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), kZipfExponent);
+            cdf[i] = sum;
+        }
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> uniform(0, sum);
+        std::vector<unsigned> result(kRequests);
+        for (unsigned& request : result) {
+            const size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+            request = static_cast<unsigned>(std::min(rank, kDistinct - 1));
+        }
+        return result;
+    }();
+    return requests;
+}
+
+// =============================================================================
+
+static void BM_ZipfNoCache(benchmark::State& state) {
+    const auto& expressions = Expressions();
+    const auto& requests = Requests();
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Compile(expressions[requests[next]]).Evaluate());
+        next = (next + 1) % kRequests;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ZipfCache(benchmark::State& state) {
+    const auto& expressions = Expressions();
+    const auto& requests = Requests();
+    static ExpressionCache* cache = nullptr;
+    if (state.thread_index() == 0) {
+        cache = new ExpressionCache(static_cast<size_t>(state.range(0)) << 10);
+    }
+    size_t next = static_cast<size_t>(state.thread_index()) * (kRequests / 8);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache->Evaluate(expressions[requests[next]]));
+        next = (next + 1) % kRequests;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        const CacheStats stats = cache->Stats();
+        state.counters["hit_rate"] = static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses);
+        state.counters["evictions"] = static_cast<double>(stats.evictions);
+        state.counters["cache_kb"] = static_cast<double>(stats.bytes) / 1024;
+        delete cache;
+        cache = nullptr;
+    }
+}
+
+BENCHMARK(BM_ZipfNoCache);
+BENCHMARK(BM_ZipfCache)->ArgName("budget_kb")->Arg(8192)->Arg(1024)->Arg(256)->Arg(64);
+BENCHMARK(BM_ZipfCache)->ArgName("budget_kb")->Arg(1024)->Threads(2)->Threads(4);
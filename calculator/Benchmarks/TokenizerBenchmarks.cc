@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "../src/compact_tokens.h"
+#include "../src/tokenizer.h"
+
+// скорость разбора в байтах входа в секунду: Tokenize, строящий вектор Token, против потокового TokenStream
+// input 0 (Mixed) - обычные выражения с функциями, числами и короткими именами переменных
+// input 1 (Names) - длинные имена переменных, которым Tokenize выделяет строку на каждое (длиннее буфера короткой строки)
+// input 2 (Runs) - длинные серии пробелов, цифр и букв, на которых работает векторный пропуск серий в ядре разбора
+// StreamCollect складывает TokenView в вектор, чтобы отделить выигрыш от отсутствия копий от выигрыша от отсутствия вектора
+// Compact строит CompactTokens; bytes_per_token - память на токен: у Tokenize sizeof(Token) и строки имен в куче,
+// у Compact все его массивы
+
+static std::string Repeat(const std::string& piece, size_t bytes) {
+    std::string input;
+    input.reserve(bytes + piece.size());
+    while (input.size() < bytes) {
+        input += piece;
+    }
+    return input;
+}
+
+static const std::string& Input(int kind) {
+    static const std::string mixed = Repeat("(max(123, abs(x - 456)) - sqr(7)) * 8 % min(y, 9) & 10 / z, ", 1 << 20);
+    static const std::string names = Repeat("temperaturesensorvalue + accumulatedpressure * 2, ", 1 << 20);
+    static const std::string runs = Repeat("                                max(12345678, 87654321)\n\t\t\t\t"
+                                           "                    abcdefghijklmnopqrstuvwxyzabcdefghijklmn + 1, ", 1 << 20);
+    return kind == 0 ? mixed : kind == 1 ? names : runs;
+}
+
+// строки длиннее буфера короткой строки (15 символов в libstdc++) лежат в куче
+static double BytesPerToken(const std::vector<Token>& tokens) {
+    size_t bytes = tokens.size() * sizeof(Token);
+    for (const Token& token : tokens) {
+        if (const auto* variable = std::get_if<VariableToken>(&token); variable && variable->name.capacity() > 15) {
+            bytes += variable->name.capacity() + 1;
+        }
+    }
+    return static_cast<double>(bytes) / static_cast<double>(tokens.size());
+}
+
+static void BM_Tokenize(benchmark::State& state) {
+    const std::string& input = Input(static_cast<int>(state.range(0)));
+    Tokenizer tokenizer;
+    for (auto _ : state) {
+        std::vector<Token> tokens = tokenizer.Tokenize(input);
+        benchmark::DoNotOptimize(tokens.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(input.size()));
+    state.counters["bytes_per_token"] = BytesPerToken(tokenizer.Tokenize(input));
+}
+
+static void BM_TokenStream(benchmark::State& state) {
+    const std::string& input = Input(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        size_t count = 0;
+        for (const TokenView& token : TokenStream(input)) {
+            count += token.index();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(input.size()));
+}
+
+static void BM_TokenStreamCollect(benchmark::State& state) {
+    const std::string& input = Input(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        TokenStream stream(input);
+        std::vector<TokenView> tokens(stream.begin(), stream.end());
+        benchmark::DoNotOptimize(tokens.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(input.size()));
+}
+
+static void BM_Compact(benchmark::State& state) {
+    const std::string& input = Input(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        CompactTokens tokens = CompactTokens::Tokenize(input);
+        benchmark::DoNotOptimize(tokens.Span().kinds);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(input.size()));
+    const CompactTokens tokens = CompactTokens::Tokenize(input);
+    state.counters["bytes_per_token"] = static_cast<double>(tokens.Bytes()) / static_cast<double>(tokens.Size());
+}
+
+BENCHMARK(BM_Tokenize)->ArgName("input")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TokenStream)->ArgName("input")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TokenStreamCollect)->ArgName("input")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Compact)->ArgName("input")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
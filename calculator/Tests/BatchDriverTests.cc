@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "../src/batch_driver.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+// то же, что должен выдать драйвер: каждая строка разбирается отдельно через Compile, '\r' в конце отбрасывается
+std::string Expected(const std::string& input) {
+    std::string expected;
+    std::istringstream in(input);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        try {
+            expected += std::to_string(Compile(line).Evaluate());
+        } catch (const std::runtime_error& error) {
+            expected += std::string("error: ") + error.what();
+        }
+        expected += '\n';
+    }
+    return expected;
+}
+
+std::string MakeInput(size_t lines) {
+    std::mt19937 rng(9);
+    const char* pieces[] = {"1 + 2", "max(3, abs(-4)) * 2", "7 / 0", "", "x + 1", "sqr(12) % 5\r", "(1", "  42  ",
+                            "min(1,2,3)-9"};
+    std::string input;
+    for (size_t i = 0; i < lines; ++i) {
+        input += pieces[rng() % 9];
+        input += '\n';
+    }
+    return input;
+}
+
+}  // namespace
+
+// порядок строк сохраняется при любом числе потоков и любом размере куска, вплоть до куска на каждую строку
+TEST(BatchDriverTest, OrderAcrossChunks) {
+    std::string input;
+    for (int i = 0; i < 3000; ++i) {
+        input += std::to_string(i) + " * 2\n";
+    }
+    std::string expected;
+    for (int i = 0; i < 3000; ++i) {
+        expected += std::to_string(i * 2) + "\n";
+    }
+    for (size_t threads : {1, 2, 4, 7}) {
+        for (size_t chunk_bytes : {0, 1, 7, 100, 4096, 1 << 20}) {
+            ASSERT_EQ(BatchDriver(DriverMode::kEvaluate, threads, chunk_bytes).Run(input), expected)
+                << "threads " << threads << ", chunk " << chunk_bytes;
+        }
+    }
+}
+
+TEST(BatchDriverTest, MixedLines) {
+    const std::string input = MakeInput(5000);
+    const std::string expected = Expected(input);
+    for (size_t threads : {1, 3, 8}) {
+        for (size_t chunk_bytes : {1, 13, 1000}) {
+            ASSERT_EQ(BatchDriver(DriverMode::kEvaluate, threads, chunk_bytes).Run(input), expected);
+        }
+    }
+}
+
+TEST(BatchDriverTest, CarriageReturn) {
+    ASSERT_EQ(BatchDriver(DriverMode::kEvaluate, 2, 1).Run("1 + 2\r\n3 * 4\r\n\r\n"), "3\n12\nerror: parse error at token 0 (end of input): empty expression\n");
+    ASSERT_EQ(BatchDriver(DriverMode::kTokenize, 2, 1).Run("1 + 2\r\n\r\n"), "3\n0\n");
+    ASSERT_EQ(BatchDriver(DriverMode::kEvaluate).Run("5\r"), "5\n");
+}
+
+TEST(BatchDriverTest, ErrorLines) {
+    const std::string output = BatchDriver(DriverMode::kEvaluate, 2, 1).Run("1 / 0\n(1\n2 + 2\n& 1\n");
+    const std::string expected = "error: division by zero\n"
+                                 "error: parse error at token 2 (end of input): expected closing bracket for token 0\n"
+                                 "4\n"
+                                 "error: parse error at token 0 (UnknownToken &): unknown token\n";
+    ASSERT_EQ(output, expected);
+    ASSERT_EQ(output, Expected("1 / 0\n(1\n2 + 2\n& 1\n"));
+}
+
+TEST(BatchDriverTest, LastLineWithoutNewline) {
+    for (size_t chunk_bytes : {1, 3, 1 << 20}) {
+        const BatchDriver driver(DriverMode::kEvaluate, 3, chunk_bytes);
+        ASSERT_EQ(driver.Run("1 + 1\n5 * 5"), "2\n25\n");
+        ASSERT_EQ(driver.Run("7"), "7\n");
+        ASSERT_EQ(driver.Run("1\n\n"), Expected("1\n\n"));
+    }
+}
+
+TEST(BatchDriverTest, EmptyInput) {
+    ASSERT_EQ(BatchDriver(DriverMode::kEvaluate).Run(""), "");
+    ASSERT_EQ(BatchDriver(DriverMode::kEvaluate, 4, 1).Run("\n"), Expected("\n"));
+}
+
+TEST(BatchDriverTest, Tokenize) {
+    ASSERT_EQ(BatchDriver(DriverMode::kTokenize, 3, 1000).Run("1 + 2\nmax(1, 2)\n\n&"), "3\n6\n0\n1\n");
+}
+
+// медленный sink: рабочие потоки ждут его, а не копят результаты, и порядок не нарушается
+TEST(BatchDriverTest, SlowSink) {
+    const std::string input = MakeInput(400);
+    std::string output;
+    BatchDriver(DriverMode::kEvaluate, 4, 1).Run(input, [&output](std::string_view result) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        output.append(result);
+    });
+    ASSERT_EQ(output, Expected(input));
+}
+
+// исключение sink останавливает рабочие потоки и выходит из Run
+TEST(BatchDriverTest, SinkException) {
+    const std::string input = MakeInput(2000);
+    size_t calls = 0;
+    const BatchDriver driver(DriverMode::kEvaluate, 4, 10);
+    ASSERT_THROW(driver.Run(input, [&calls](std::string_view) {
+        if (++calls == 3) {
+            throw std::logic_error("sink");
+        }
+    }), std::logic_error);
+    ASSERT_EQ(calls, 3u);
+    ASSERT_EQ(driver.Run("1 + 1\n"), "2\n");
+}
+
+TEST(BatchDriverTest, RunFile) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string input_path = (directory / "calculator_driver_test_in.txt").string();
+    const std::string output_path = (directory / "calculator_driver_test_out.txt").string();
+    const std::string input = MakeInput(3000) + "5 * 5";
+    {
+        std::ofstream file(input_path, std::ios::binary);
+        file << input;
+    }
+    BatchDriver(DriverMode::kEvaluate, 4, 5000).RunFile(input_path, output_path);
+    std::ifstream file(output_path, std::ios::binary);
+    const std::string output((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(output, Expected(input));
+    {
+        std::ofstream empty(input_path, std::ios::binary);
+    }
+    BatchDriver(DriverMode::kEvaluate).RunFile(input_path, output_path);
+    ASSERT_EQ(std::filesystem::file_size(output_path), 0u);
+    std::filesystem::remove(input_path);
+    std::filesystem::remove(output_path);
+    ASSERT_THROW(BatchDriver(DriverMode::kEvaluate).RunFile((directory / "no_such_dir" / "in").string(), output_path),
+                 std::runtime_error);
+}
@@ -0,0 +1,197 @@
+#include "gtest/gtest.h"
+#include "../src/batch.h"
+#include "../src/parser.h"
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <string>
+#include <vector>
+
+// каждая строка BatchEvaluator должна совпадать с Expression::Evaluate на значениях переменных из этой строки
+
+namespace {
+
+struct Table {
+    std::vector<std::string> names;
+    std::vector<std::vector<int>> columns;
+};
+
+// значения по большей части небольшие, но с частыми INT_MIN, INT_MAX, -1 и 0
+Table MakeTable(const Expression& expression, size_t rows, unsigned seed) {
+    std::mt19937 rng(seed);
+    Table table;
+    table.names = expression.Variables();
+    for (size_t v = 0; v < table.names.size(); ++v) {
+        std::vector<int> column(rows);
+        for (int& value : column) {
+            switch (rng() % 8) {
+            case 0:
+                value = INT_MIN;
+                break;
+            case 1:
+                value = INT_MAX;
+                break;
+            case 2:
+                value = -1;
+                break;
+            default:
+                value = static_cast<int>(rng() % 2001) - 1000;
+                break;
+            }
+        }
+        table.columns.push_back(std::move(column));
+    }
+    return table;
+}
+
+void ExpectRowsMatch(const std::string& text, size_t rows, unsigned seed = 1) {
+    const Expression expression = Compile(text);
+    const Table table = MakeTable(expression, rows, seed);
+    BatchEvaluator batch(expression);
+    for (size_t v = 0; v < table.names.size(); ++v) {
+        batch.Bind(table.names[v], table.columns[v].data());
+    }
+    std::vector<int> result(rows);
+    batch.Evaluate(rows, result.data());
+    std::vector<int> values(table.names.size());
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t v = 0; v < values.size(); ++v) {
+            values[v] = table.columns[v][i];
+        }
+        ASSERT_EQ(result[i], expression.Evaluate(values)) << text << ", row " << i << " of " << rows;
+    }
+}
+
+const size_t kRowCounts[] = {1, 7, 8, 9, 13, 1000, 1023, 1024, 1025, 2049, 5000};
+
+}  // namespace
+
+TEST(BatchTest, MatchesEvaluateRowByRow) {
+    const char* texts[] = {"max(a, abs(b)) - sqr(c) * 8", "a", "-a + b * a - c", "a * b * c * a * b * c",
+                           "sqr(sqr(a)) + abs(-b) - max(c)", "((a - (b - (c - (a - (b - (c * 2)))))))",
+                           "min(a, b, c, 7) - max(a, 3 - b)"};
+    for (const char* text : texts) {
+        for (size_t rows : kRowCounts) {
+            ExpectRowsMatch(text, rows);
+        }
+    }
+}
+
+TEST(BatchTest, ConstantOnly) {
+    for (size_t rows : kRowCounts) {
+        const BatchEvaluator batch(Compile("(max(123, abs(456)) - sqr(7)) * 8"));
+        std::vector<int> result(rows, 0);
+        batch.Evaluate(rows, result.data());
+        ASSERT_EQ(result, std::vector<int>(rows, 3256));
+    }
+    ExpectRowsMatch("7", 9);
+}
+
+TEST(BatchTest, VariableUsedTwice) {
+    const BatchEvaluator probe(Compile("a * a - a"));
+    ASSERT_EQ(probe.GetExpression().Variables().size(), 1u);
+    for (size_t rows : kRowCounts) {
+        ExpectRowsMatch("a * a - a", rows, 3);
+        ExpectRowsMatch("a / (abs(a) % 7 + 1) + b - a", rows, 4);
+    }
+}
+
+TEST(BatchTest, DivisionWithoutZero) {
+    for (size_t rows : kRowCounts) {
+        ExpectRowsMatch("a / (abs(b) % 5 + 1) + a % (sqr(c) % 3 + 4)", rows, 5);
+    }
+}
+
+TEST(BatchTest, UnboundVariable) {
+    BatchEvaluator batch(Compile("a + b"));
+    const std::vector<int> a(4, 1);
+    batch.Bind("a", a.data());
+    std::vector<int> result(4);
+    ASSERT_THROW(batch.Evaluate(4, result.data()), std::runtime_error);
+    ASSERT_THROW(batch.Bind("c", a.data()), std::runtime_error);
+    // без строк ничего не читается, и непривязанный столбец не ошибка
+    batch.Evaluate(0, nullptr);
+}
+
+TEST(BatchTest, EmptyExpression) {
+    const BatchEvaluator batch{Expression()};
+    int result = 0;
+    ASSERT_THROW(batch.Evaluate(1, &result), std::runtime_error);
+}
+
+// ноль только во втором блоке из kBlock строк, первый блок уже посчитан к моменту ошибки
+TEST(BatchTest, DivisionByZeroInSecondBlock) {
+    const size_t rows = 3000;
+    std::vector<int> a(rows, 10);
+    std::vector<int> b(rows, 2);
+    b[1500] = 0;
+    for (const char* text : {"a / b", "a % b"}) {
+        BatchEvaluator batch(Compile(text));
+        batch.Bind("a", a.data());
+        batch.Bind("b", b.data());
+        std::vector<int> result(rows, -1);
+        ASSERT_THROW(batch.Evaluate(rows, result.data()), std::runtime_error);
+        ASSERT_EQ(result[0], std::string(text) == "a / b" ? 5 : 0);
+        ASSERT_EQ(result[1023], result[0]);
+        ASSERT_EQ(result[1024], -1);
+    }
+}
+
+TEST(BatchTest, IntMinWraparound) {
+    for (const char* text : {"abs(a)", "a * -1", "-a", "a * b", "a - 1", "sqr(a)", "a / b", "a % b"}) {
+        const Expression expression = Compile(text);
+        BatchEvaluator batch(expression);
+        std::vector<int> a(19, INT_MIN);
+        std::vector<int> b(19, -1);
+        batch.Bind("a", a.data());
+        if (expression.Variables().size() > 1) {
+            batch.Bind("b", b.data());
+        }
+        std::vector<int> result(19);
+        batch.Evaluate(19, result.data());
+        const int expected = expression.Variables().size() > 1 ? expression.Evaluate({INT_MIN, -1}) : expression.Evaluate({INT_MIN});
+        ASSERT_EQ(result, std::vector<int>(19, expected)) << text;
+    }
+    ASSERT_EQ(Compile("abs(a)").Evaluate({INT_MIN}), INT_MIN);
+    ASSERT_EQ(Compile("a * -1").Evaluate({INT_MIN}), INT_MIN);
+}
+
+// скалярное и AVX2-ядро команды (AVX2 - если процессор его умеет) против поэлементного вычисления
+// по Wrap*-функциям байткода, на длинах, кратных и не кратных 8
+template <OpCode Op>
+void ExpectKernelsMatch(int (*reference)(int, int)) {
+    const std::vector<int> a = {INT_MIN, INT_MIN, INT_MAX, -1, 0, 1, 46341, -46341, INT_MIN, 7, -7, 1000, INT_MAX, 3, -2,
+                                INT_MIN, 65536, -65536, 2};
+    const std::vector<int> b = {-1, INT_MIN, INT_MAX, -1, 0, INT_MIN, 46341, 46341, 1, -7, 7, -1000, 1, INT_MIN, -2,
+                                INT_MAX, 65536, 65536, INT_MIN};
+    for (size_t count : {size_t(1), size_t(8), size_t(13), a.size()}) {
+        std::vector<int> expected(count);
+        for (size_t i = 0; i < count; ++i) {
+            expected[i] = reference(a[i], b[i]);
+        }
+        std::vector<int> out(count);
+        KernelScalar<Op>(a.data(), b.data(), out.data(), count);
+        ASSERT_EQ(out, expected) << "scalar, op " << static_cast<int>(Op) << ", count " << count;
+#ifdef CALCULATOR_SIMD
+        if (HasAvx2()) {
+            std::fill(out.begin(), out.end(), 0);
+            KernelAvx2<Op>(a.data(), b.data(), out.data(), count);
+            ASSERT_EQ(out, expected) << "avx2, op " << static_cast<int>(Op) << ", count " << count;
+        }
+#endif
+        std::fill(out.begin(), out.end(), 0);
+        RunKernel(Op, a.data(), b.data(), out.data(), count);
+        ASSERT_EQ(out, expected) << "dispatch, op " << static_cast<int>(Op) << ", count " << count;
+    }
+}
+
+TEST(BatchTest, Kernels) {
+    ExpectKernelsMatch<OpCode::kAdd>(WrapAdd);
+    ExpectKernelsMatch<OpCode::kSubtract>(WrapSubtract);
+    ExpectKernelsMatch<OpCode::kMultiply>(WrapMultiply);
+    ExpectKernelsMatch<OpCode::kMin>([](int a, int b) { return std::min(a, b); });
+    ExpectKernelsMatch<OpCode::kMax>([](int a, int b) { return std::max(a, b); });
+    ExpectKernelsMatch<OpCode::kNegate>([](int a, int) { return WrapSubtract(0, a); });
+    ExpectKernelsMatch<OpCode::kAbs>([](int a, int) { return a < 0 ? WrapSubtract(0, a) : a; });
+    ExpectKernelsMatch<OpCode::kSqr>([](int a, int) { return WrapMultiply(a, a); });
+}
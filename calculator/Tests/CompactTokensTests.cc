@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "../src/compact_tokens.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string ToString(const std::vector<Token>& tokens) {
+    std::ostringstream out;
+    for (const Token& token : tokens) {
+        out << token << '|';
+    }
+    return out.str();
+}
+
+void ExpectSameTokens(const std::string& input) {
+    ASSERT_EQ(ToString(CompactTokens::Tokenize(input).ToTokens(input)), ToString(Tokenizer().Tokenize(input)))
+        << "input: \"" << input << "\"";
+}
+
+}  // namespace
+
+TEST(CompactTokensTest, MatchesTokenizer) {
+    const std::vector<std::string> inputs = {"", "   ", "(max(123, abs(456)) - sqr(7)) * 8 & 9", "alpha * beta - alpha",
+        "x1y2 % z / 0", "mi maxx sq abs(min)", "2147483648 + 99999999999", "\x80\xff&^ [x]", "a+b,c)(",
+        std::string(100, 'v') + " + " + std::string(40, '7')};
+    for (const std::string& input : inputs) {
+        ExpectSameTokens(input);
+    }
+}
+
+TEST(CompactTokensTest, RandomInputs) {
+    std::mt19937 rng(13);
+    const std::string alphabet = "abcxyzMAXminsqr0123456789+-*/%(),  \t\n&^\x80\xff";
+    for (int round = 0; round < 2000; ++round) {
+        std::string input;
+        const size_t length = rng() % 100;
+        for (size_t i = 0; i < length; ++i) {
+            input += alphabet[rng() % alphabet.size()];
+        }
+        ExpectSameTokens(input);
+    }
+}
+
+// смещение и длина каждого токена - его место во входе, текст имен и неизвестных символов берется оттуда же
+TEST(CompactTokensTest, OffsetsAndLengths) {
+    const std::string input = " max(12,  name)&  ";
+    const CompactTokens tokens = CompactTokens::Tokenize(input);
+    const TokenKind kinds[] = {TokenKind::kMax, TokenKind::kOpeningBracket, TokenKind::kNumber, TokenKind::kComma,
+                               TokenKind::kVariable, TokenKind::kClosingBracket, TokenKind::kUnknown};
+    const std::uint32_t offsets[] = {1, 4, 5, 7, 10, 14, 15};
+    const std::uint32_t lengths[] = {3, 1, 2, 1, 4, 1, 1};
+    ASSERT_EQ(tokens.Size(), 7u);
+    const CompactTokenSpan span = tokens.Span();
+    ASSERT_EQ(span.size, 7u);
+    for (size_t i = 0; i < tokens.Size(); ++i) {
+        ASSERT_EQ(tokens.Kind(i), kinds[i]) << i;
+        ASSERT_EQ(span.kinds[i], kinds[i]) << i;
+        ASSERT_EQ(span.offsets[i], offsets[i]) << i;
+        ASSERT_EQ(span.lengths[i], lengths[i]) << i;
+        ASSERT_EQ(tokens.Text(i, input), input.substr(offsets[i], lengths[i])) << i;
+    }
+    ASSERT_EQ(tokens.Text(4, input), "name");
+    ASSERT_EQ(tokens.Text(4, input).data(), input.data() + 10);
+    ASSERT_EQ(tokens.Text(6, input), "&");
+}
+
+TEST(CompactTokensTest, Numbers) {
+    const std::string input = "1 + max(20, 300) - 4000000000";
+    const CompactTokens tokens = CompactTokens::Tokenize(input);
+    ASSERT_EQ(tokens.Numbers(), (std::vector<int>{1, 20, 300, static_cast<int>(4000000000u)}));
+    const CompactTokenSpan span = tokens.Span();
+    ASSERT_EQ(span.number_count, 4u);
+    ASSERT_EQ(span.numbers[2], 300);
+}
+
+// 9 байт на токен и 4 на число, емкость векторов не считается
+TEST(CompactTokensTest, Bytes) {
+    ASSERT_EQ(CompactTokens().Bytes(), 0u);
+    ASSERT_EQ(CompactTokens::Tokenize("").Bytes(), 0u);
+    ASSERT_EQ(CompactTokens::Tokenize("   ").Bytes(), 0u);
+    ASSERT_EQ(CompactTokens::Tokenize("(a)").Bytes(), 3 * 9u);
+    ASSERT_EQ(CompactTokens::Tokenize("12 + 345").Bytes(), 3 * 9u + 2 * 4u);
+    ASSERT_EQ(CompactTokens::Tokenize("(max(123, abs(456)) - sqr(7)) * 8").Bytes(), 18 * 9u + 4 * 4u);
+}
+
+TEST(CompactTokensTest, Empty) {
+    const CompactTokens tokens = CompactTokens::Tokenize("");
+    ASSERT_EQ(tokens.Size(), 0u);
+    ASSERT_TRUE(tokens.ToTokens("").empty());
+    ASSERT_EQ(tokens.Span().size, 0u);
+    ASSERT_EQ(tokens.Span().number_count, 0u);
+}
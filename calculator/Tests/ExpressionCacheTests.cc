@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "../src/expression_cache.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ExpressionCacheTest, HitsAndMisses) {
+    ExpressionCache cache(1 << 20, 4);
+    ASSERT_EQ(cache.Evaluate("1 + 2"), 3);
+    ASSERT_EQ(cache.Evaluate("1 + 2"), 3);
+    ASSERT_EQ(cache.Evaluate("2 * 3"), 6);
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 2u);
+    ASSERT_EQ(stats.evictions, 0u);
+    ASSERT_EQ(stats.entries, 2u);
+    ASSERT_GT(stats.bytes, 0u);
+    ASSERT_EQ(cache.Get("1 + 2"), cache.Get("1 + 2"));
+}
+
+TEST(ExpressionCacheTest, Variables) {
+    ExpressionCache cache(1 << 20);
+    ASSERT_EQ(cache.Evaluate("a * b + a", {2, 5}), 12);
+    ASSERT_EQ(cache.Evaluate("a * b + a", {3, 1}), 6);
+    ASSERT_EQ(cache.Stats().hits, 1u);
+    ASSERT_THROW(cache.Evaluate("a * b + a"), std::runtime_error);
+}
+
+TEST(ExpressionCacheTest, EvictionKeepsBytesWithinBudget) {
+    const size_t budget = 4096;
+    ExpressionCache cache(budget, 1);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(cache.Evaluate(std::to_string(i) + " * 2"), i * 2);
+        ASSERT_LE(cache.Stats().bytes, budget);
+    }
+    const CacheStats stats = cache.Stats();
+    ASSERT_GT(stats.entries, 0u);
+    ASSERT_LT(stats.entries, 100u);
+    ASSERT_EQ(stats.misses, 100u);
+    ASSERT_EQ(stats.evictions, 100u - stats.entries);
+}
+
+// недавно использованная запись переживает вытеснение, самая старая - нет
+TEST(ExpressionCacheTest, LeastRecentlyUsedIsEvicted) {
+    ExpressionCache cache(4096, 1);
+    cache.Evaluate("1 + 1");
+    size_t fill = 2;
+    while (cache.Stats().evictions == 0) {
+        cache.Evaluate("1 + 1");
+        cache.Evaluate(std::to_string(fill++) + " + 1");
+    }
+    const size_t misses = cache.Stats().misses;
+    cache.Evaluate("1 + 1");
+    ASSERT_EQ(cache.Stats().misses, misses);
+    cache.Evaluate("2 + 1");
+    ASSERT_EQ(cache.Stats().misses, misses + 1);
+}
+
+// при бюджете меньше kMinShardBudget на шард шардов становится меньше, и запись все равно помещается
+TEST(ExpressionCacheTest, SmallBudgetUsesFewerShards) {
+    ExpressionCache small(4096);
+    ASSERT_EQ(small.ShardCount(), 1u);
+    small.Evaluate("1 + 2");
+    small.Evaluate("1 + 2");
+    ASSERT_EQ(small.Stats().hits, 1u);
+    ASSERT_EQ(small.Stats().entries, 1u);
+    ASSERT_EQ(ExpressionCache(1 << 30).ShardCount(), 16u);
+    ASSERT_EQ(ExpressionCache(0).ShardCount(), 1u);
+    ASSERT_EQ(ExpressionCache(1 << 30, 0).ShardCount(), 1u);
+}
+
+TEST(ExpressionCacheTest, OversizedEntryIsNotCached) {
+    ExpressionCache tiny(10, 1);
+    ASSERT_EQ(tiny.Evaluate("2 * 3"), 6);
+    ASSERT_EQ(tiny.Stats().entries, 0u);
+    ASSERT_EQ(tiny.Stats().bytes, 0u);
+
+    ExpressionCache cache(4096, 1);
+    cache.Evaluate("1");
+    std::string sum = "1";
+    for (int i = 0; i < 1000; ++i) {
+        sum += " + 1";
+    }
+    ASSERT_EQ(cache.Evaluate(sum), 1001);
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.entries, 1u);
+    ASSERT_EQ(stats.evictions, 0u);
+    cache.Evaluate("1");
+    ASSERT_EQ(cache.Stats().hits, 1u);
+}
+
+TEST(ExpressionCacheTest, ErrorsAreNotCached) {
+    ExpressionCache cache(1 << 20);
+    ASSERT_THROW(cache.Evaluate("1 +"), std::runtime_error);
+    ASSERT_THROW(cache.Evaluate("1 +"), std::runtime_error);
+    ASSERT_THROW(cache.Evaluate("(1"), std::runtime_error);
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.misses, 3u);
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.entries, 0u);
+    ASSERT_EQ(stats.bytes, 0u);
+    // деление на ноль - ошибка вычисления, а не компиляции, поэтому выражение в кэше остается
+    ASSERT_THROW(cache.Evaluate("1 / 0"), std::runtime_error);
+    ASSERT_EQ(cache.Stats().entries, 1u);
+}
+
+// длинные имена и неизвестный текст лежат в куче и учитываются в размере записи
+TEST(ExpressionCacheTest, BytesCountHeapStrings) {
+    const std::string text = std::string(100, 'a') + " + " + std::string(100, 'b') + " & 1";
+    const CachedExpression long_names{Tokenizer().Tokenize(text), Compile(text.substr(0, 203))};
+    const CachedExpression short_names{Tokenizer().Tokenize("a + b & 1"), Compile("a + b")};
+    // по две копии каждого имени (токен и Variables()) по 100 символов и завершающему нулю
+    ASSERT_GE(long_names.Bytes(), short_names.Bytes() + 4 * 101);
+}
+
+TEST(ExpressionCacheTest, Clear) {
+    ExpressionCache cache(1 << 20);
+    cache.Evaluate("1 + 2");
+    cache.Clear();
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.entries, 0u);
+    ASSERT_EQ(stats.bytes, 0u);
+    ASSERT_EQ(stats.misses, 1u);
+    cache.Evaluate("1 + 2");
+    ASSERT_EQ(cache.Stats().misses, 2u);
+}
+
+TEST(ExpressionCacheTest, ConcurrentSameKey) {
+    ExpressionCache cache(1 << 20, 4);
+    std::atomic<bool> wrong(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                if (cache.Evaluate("max(3, 4) * 5") != 20) {
+                    wrong = true;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_FALSE(wrong);
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.hits + stats.misses, 16000u);
+    ASSERT_EQ(stats.entries, 1u);
+    ASSERT_LE(stats.misses, 8u);
+}
+
+TEST(ExpressionCacheTest, ConcurrentDifferentKeys) {
+    const size_t budget = 1 << 16;
+    ExpressionCache cache(budget, 4);
+    std::atomic<bool> wrong(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5000; ++i) {
+                const int k = (i * 7 + t) % 300;
+                if (cache.Evaluate(std::to_string(k) + " + 1") != k + 1) {
+                    wrong = true;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_FALSE(wrong);
+    const CacheStats stats = cache.Stats();
+    ASSERT_EQ(stats.hits + stats.misses, 20000u);
+    ASSERT_LE(stats.bytes, budget);
+    ASSERT_GT(stats.hits, 0u);
+}
@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "../src/parser.h"
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+// текст ошибки компиляции или вычисления, пустая строка - ошибки не было
+static std::string ErrorOf(const std::string& input) {
+    try {
+        Compile(input).Evaluate();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+static void ExpectError(const std::string& input, const std::string& part) {
+    const std::string error = ErrorOf(input);
+    ASSERT_NE(error.find(part), std::string::npos) << "input: " << input << ", error: " << error;
+}
+
+TEST(ParserTest, Precedence) {
+    ASSERT_EQ(Compile("1 + 2 * 3").Evaluate(), 7);
+    ASSERT_EQ(Compile("(1 + 2) * 3").Evaluate(), 9);
+    ASSERT_EQ(Compile("10 - 6 / 3").Evaluate(), 8);
+    ASSERT_EQ(Compile("1 + 7 % 4 * 2").Evaluate(), 7);
+}
+
+TEST(ParserTest, LeftAssociativity) {
+    ASSERT_EQ(Compile("10 - 4 - 3").Evaluate(), 3);
+    ASSERT_EQ(Compile("100 / 10 / 5").Evaluate(), 2);
+    ASSERT_EQ(Compile("7 % 4 * 3").Evaluate(), 9);
+    ASSERT_EQ(Compile("2 * 9 / 4").Evaluate(), 4);
+}
+
+TEST(ParserTest, UnaryMinus) {
+    ASSERT_EQ(Compile("-5").Evaluate(), -5);
+    ASSERT_EQ(Compile("- -5").Evaluate(), 5);
+    ASSERT_EQ(Compile("+5").Evaluate(), 5);
+    ASSERT_EQ(Compile("-2 * 3").Evaluate(), -6);
+    ASSERT_EQ(Compile("4 - -2").Evaluate(), 6);
+    ASSERT_EQ(Compile("-(1 + 2)").Evaluate(), -3);
+    ASSERT_EQ(Compile("-7 / 2").Evaluate(), -3);
+    ASSERT_EQ(Compile("-7 % 2").Evaluate(), -1);
+}
+
+TEST(ParserTest, Functions) {
+    ASSERT_EQ(Compile("(max(123, abs(456)) - sqr(7)) * 8").Evaluate(), 3256);
+    ASSERT_EQ(Compile("min(4)").Evaluate(), 4);
+    ASSERT_EQ(Compile("max(1, 5, 3)").Evaluate(), 5);
+    ASSERT_EQ(Compile("min(3, -1, 2)").Evaluate(), -1);
+    ASSERT_EQ(Compile("abs(-4) + sqr(-3)").Evaluate(), 13);
+    ASSERT_EQ(Compile("max(1 + 2, 2 * 2)").Evaluate(), 4);
+}
+
+TEST(ParserTest, FunctionArity) {
+    ExpectError("abs(1, 2)", "abs takes 1 argument, got 2");
+    ExpectError("sqr(1, 2, 3)", "sqr takes 1 argument, got 3");
+    ExpectError("min()", "expected operand");
+    ExpectError("max()", "expected operand");
+    ExpectError("abs()", "expected operand");
+    ExpectError("max 1", "expected opening bracket after max");
+    ExpectError("min(1,)", "expected operand");
+}
+
+TEST(ParserTest, UnbalancedBrackets) {
+    ExpectError("(1", "expected closing bracket for token 0");
+    ExpectError("1)", "unexpected token");
+    ExpectError("((1 + 2)", "expected closing bracket");
+    ExpectError("max(1, 2", "expected closing bracket");
+    ExpectError("()", "expected operand");
+    ExpectError(")", "expected operand");
+}
+
+TEST(ParserTest, StrayComma) {
+    ExpectError("1, 2", "parse error at token 1 (CommaToken): unexpected token");
+    ExpectError("(1, 2)", "expected closing bracket");
+    ExpectError(",", "expected operand");
+}
+
+TEST(ParserTest, UnknownToken) {
+    ExpectError("(max(123, abs(456)) - sqr(7)) * 8 & 9", "parse error at token 18 (UnknownToken &): unknown token");
+    ExpectError("& 1", "parse error at token 0 (UnknownToken &): unknown token");
+    ExpectError("(1 & 2)", "unknown token");
+}
+
+TEST(ParserTest, MissingOperand) {
+    ExpectError("1 +", "(end of input): missing operand");
+    ExpectError("* 3", "expected operand");
+    ExpectError("1 2", "unexpected token");
+    ExpectError("sqr(", "missing operand");
+}
+
+TEST(ParserTest, EmptyInput) {
+    ExpectError("", "empty expression");
+    ExpectError("   \t ", "empty expression");
+    ASSERT_THROW(Expression().Evaluate(), std::runtime_error);
+}
+
+TEST(ParserTest, NestingTooDeep) {
+    ExpectError(std::string(100000, '(') + "1", "expression is nested too deeply");
+    ExpectError(std::string(100000, '-') + "1", "expression is nested too deeply");
+    std::string nested = "1";
+    for (int i = 0; i < 200; ++i) {
+        nested = "(1 + " + nested + ")";
+    }
+    const Expression expression = Compile(nested);
+    ASSERT_EQ(expression.Evaluate(), 201);
+    ASSERT_GT(expression.StackDepth(), 64u);
+}
+
+TEST(ParserTest, LongFlatExpression) {
+    std::string sum = "1";
+    for (int i = 0; i < 100000; ++i) {
+        sum += " + 1";
+    }
+    const Expression expression = Compile(sum);
+    ASSERT_EQ(expression.Evaluate(), 100001);
+    ASSERT_EQ(expression.StackDepth(), 2u);
+}
+
+TEST(ParserTest, DivisionByZero) {
+    ExpectError("1 / 0", "division by zero");
+    ExpectError("5 % (2 - 2)", "modulo by zero");
+    ExpectError("max(1, 1 / (3 - 3))", "division by zero");
+}
+
+TEST(ParserTest, IntMinWraparound) {
+    ASSERT_EQ(Compile("2147483647 + 1").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("-2147483647 - 1").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("(-2147483647 - 1) / -1").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("(-2147483647 - 1) % -1").Evaluate(), 0);
+    ASSERT_EQ(Compile("abs(-2147483647 - 1)").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("-(-2147483647 - 1)").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("(-2147483647 - 1) * -1").Evaluate(), INT_MIN);
+    ASSERT_EQ(Compile("sqr(65536)").Evaluate(), 0);
+}
+
+TEST(ParserTest, Bytecode) {
+    const Expression expression = Compile("max(1, 2) * -3");
+    const std::vector<OpCode> code = {OpCode::kPush, OpCode::kPush, OpCode::kMax, OpCode::kPush, OpCode::kNegate,
+                                      OpCode::kMultiply};
+    ASSERT_EQ(expression.Code(), code);
+    ASSERT_EQ(expression.Constants(), (std::vector<int>{1, 2, 3}));
+    ASSERT_EQ(expression.StackDepth(), 2u);
+}
+
+TEST(ParserTest, Variables) {
+    const Expression expression = Compile("a * b - a");
+    ASSERT_EQ(expression.Variables(), (std::vector<std::string>{"a", "b"}));
+    ASSERT_EQ(expression.Evaluate({3, 4}), 9);
+    ASSERT_THROW(expression.Evaluate(), std::runtime_error);
+    ASSERT_THROW(expression.Evaluate({1}), std::runtime_error);
+}
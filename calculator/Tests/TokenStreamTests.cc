@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "../src/tokenizer.h"
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::string ToString(const TokenView& token) {
+    std::ostringstream out;
+    out << token;
+    return out.str();
+}
+
+TEST(TokenStreamTest, NextAtEnd) {
+    TokenStream stream("1");
+    ASSERT_TRUE(stream.Next().has_value());
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_EQ(stream.Position(), 1u);
+    ASSERT_EQ(stream.TokenStart(), 1u);
+}
+
+TEST(TokenStreamTest, NextAtEndAfterTrailingSpaces) {
+    TokenStream stream("x \t\n ");
+    ASSERT_TRUE(stream.Next().has_value());
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_EQ(stream.Position(), 5u);
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_EQ(stream.Position(), 5u);
+}
+
+// по каждому виду токена: что вернул Next, где он начался и где остановился поток
+TEST(TokenStreamTest, PositionAfterEachKind) {
+    const std::string input = " ( ) , min max abs sqr + - * % / 1234 name & minx";
+    struct Expected {
+        std::string token;
+        size_t start;
+        size_t end;
+    };
+    const Expected expected[] = {
+        {"OpeningBracketToken", 1, 2}, {"ClosingBracketToken", 3, 4}, {"CommaToken", 5, 6}, {"MinToken", 7, 10},
+        {"MaxToken", 11, 14}, {"AbsToken", 15, 18}, {"SqrToken", 19, 22}, {"PlusToken", 23, 24},
+        {"MinusToken", 25, 26}, {"MultiplyToken", 27, 28}, {"ModuloToken", 29, 30}, {"DivideToken", 31, 32},
+        {"NumberToken 1234", 33, 37}, {"VariableToken name", 38, 42}, {"UnknownToken &", 43, 44},
+        {"VariableToken minx", 45, 49}};
+    TokenStream stream(input);
+    for (const Expected& e : expected) {
+        const std::optional<TokenView> token = stream.Next();
+        ASSERT_TRUE(token.has_value()) << e.token;
+        ASSERT_EQ(ToString(*token), e.token);
+        ASSERT_EQ(stream.TokenStart(), e.start) << e.token;
+        ASSERT_EQ(stream.Position(), e.end) << e.token;
+    }
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_EQ(stream.Position(), input.size());
+}
+
+TEST(TokenStreamTest, AdjacentTokens) {
+    TokenStream stream("12ab(");
+    ASSERT_EQ(ToString(*stream.Next()), "NumberToken 12");
+    ASSERT_EQ(stream.Position(), 2u);
+    ASSERT_EQ(ToString(*stream.Next()), "VariableToken ab");
+    ASSERT_EQ(stream.TokenStart(), 2u);
+    ASSERT_EQ(stream.Position(), 4u);
+    ASSERT_EQ(ToString(*stream.Next()), "OpeningBracketToken");
+    ASSERT_EQ(stream.TokenStart(), 4u);
+    ASSERT_EQ(stream.Position(), 5u);
+}
+
+TEST(TokenStreamTest, EmptyInput) {
+    TokenStream stream("");
+    ASSERT_TRUE(stream.begin() == stream.end());
+    ASSERT_FALSE(stream.Next().has_value());
+    ASSERT_EQ(stream.Position(), 0u);
+}
+
+TEST(TokenStreamTest, WhitespaceOnlyInput) {
+    TokenStream stream(" \t\n\v\f\r   ");
+    ASSERT_TRUE(stream.begin() == stream.end());
+    const std::string spaces(100, ' ');
+    TokenStream long_stream(spaces);
+    ASSERT_TRUE(long_stream.begin() == long_stream.end());
+}
+
+TEST(TokenStreamTest, Iterator) {
+    TokenStream stream("max(1, x)");
+    std::string tokens;
+    for (const TokenView& token : stream) {
+        tokens += ToString(token) + "|";
+    }
+    ASSERT_EQ(tokens, "MaxToken|OpeningBracketToken|NumberToken 1|CommaToken|VariableToken x|ClosingBracketToken|");
+}
+
+// имена и неизвестные символы - участки строки вызывающего, а не копии
+TEST(TokenStreamTest, ViewsPointIntoInput) {
+    const std::string input = "alpha + \x80 * beta";
+    TokenStream stream(input);
+    std::vector<std::string_view> views;
+    for (const TokenView& token : stream) {
+        if (const auto* name = std::get_if<VariableTokenView>(&token)) {
+            views.push_back(name->name);
+        } else if (const auto* unknown = std::get_if<UnknownTokenView>(&token)) {
+            views.push_back(unknown->value);
+        }
+    }
+    ASSERT_EQ(views.size(), 3u);
+    ASSERT_EQ(views[0].data(), input.data());
+    ASSERT_EQ(views[0], "alpha");
+    ASSERT_EQ(views[1].data(), input.data() + 8);
+    ASSERT_EQ(views[1].size(), 1u);
+    ASSERT_EQ(views[2].data(), input.data() + 12);
+    ASSERT_EQ(views[2], "beta");
+}
+
+TEST(TokenStreamTest, ToTokenCopiesText) {
+    std::string input = "abc";
+    const Token token = ToToken(*TokenStream(input).Next());
+    input[0] = 'x';
+    ASSERT_EQ(std::get<VariableToken>(token).name, "abc");
+}
@@ -0,0 +1,201 @@
+#include "gtest/gtest.h"
+#include "../src/tokenizer.h"
+#include <cctype>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// прежний Tokenizer на словарях symbol2Token и func2Token и функциях std::isspace, std::isdigit, std::isalpha,
+// с которым сверяется таблица символов, perfect hash функций и SIMD-пропуск серий в TokenStream
+// отличия от прежнего кода только те, что появились потом: имя не функции - VariableToken, а не UnknownToken,
+// и число собирается в unsigned, чтобы переполнение не было UB
+
+namespace {
+
+class ReferenceTokenizer {
+public:
+    std::vector<Token> Tokenize(const std::string& input);
+
+private:
+    static const std::unordered_map<char, Token> symbol2Token;
+    static const std::unordered_map<std::string, Token> func2Token;
+    NumberToken ParseNumber(const std::string& input, size_t& pos);
+    Token ParseName(const std::string& input, size_t& pos);
+};
+
+const std::unordered_map<char, Token> ReferenceTokenizer::symbol2Token {
+    {'+', PlusToken{}},
+    {'-', MinusToken{}},
+    {'*', MultiplyToken{}},
+    {'/', DivideToken{}},
+    {'%', ModuloToken{}},
+    {'(', OpeningBracketToken{}},
+    {')', ClosingBracketToken{}},
+    {',', CommaToken{}}
+};
+
+const std::unordered_map<std::string, Token> ReferenceTokenizer::func2Token {
+    {"abs", AbsToken{}},
+    {"min", MinToken{}},
+    {"max", MaxToken{}},
+    {"sqr", SqrToken{}}
+};
+
+NumberToken ReferenceTokenizer::ParseNumber(const std::string& input, size_t& pos) {
+    unsigned value = 0;
+    while (pos < input.size() && std::isdigit(static_cast<unsigned char>(input[pos]))) {
+        value = value * 10 + static_cast<unsigned>(input[pos++] - '0');
+    }
+    return NumberToken{static_cast<int>(value)};
+}
+
+Token ReferenceTokenizer::ParseName(const std::string& input, size_t& pos) {
+    std::string str;
+    while (pos < input.size() && std::isalpha(static_cast<unsigned char>(input[pos]))) {
+        str.push_back(input[pos++]);
+    }
+    if (auto it = func2Token.find(str); it != func2Token.end()) {
+        return it->second;
+    }
+    if (str.empty()) {
+        return UnknownToken{std::string(1, input[pos++])};
+    }
+    return VariableToken{str};
+}
+
+std::vector<Token> ReferenceTokenizer::Tokenize(const std::string& input) {
+    std::vector<Token> tokens;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        const auto symbol = static_cast<unsigned char>(input[pos]);
+        if (std::isspace(symbol)) {
+            ++pos;
+        } else if (std::isdigit(symbol)) {
+            tokens.emplace_back(ParseNumber(input, pos));
+        } else if (auto it = symbol2Token.find(symbol); it != symbol2Token.end()) {
+            tokens.emplace_back(it->second);
+            ++pos;
+        } else {
+            tokens.emplace_back(ParseName(input, pos));
+        }
+    }
+    return tokens;
+}
+
+std::string ToString(const std::vector<Token>& tokens) {
+    std::ostringstream out;
+    for (const Token& token : tokens) {
+        out << token << '|';
+    }
+    return out.str();
+}
+
+void ExpectSame(const std::string& input) {
+    ASSERT_EQ(ToString(Tokenizer().Tokenize(input)), ToString(ReferenceTokenizer().Tokenize(input)))
+        << "input: \"" << input << "\"";
+}
+
+}  // namespace
+
+TEST(TokenizerTest, Example) {
+    ASSERT_EQ(ToString(Tokenizer().Tokenize("(max(123, abs(456)) - sqr(7)) * 8 & 9")),
+              "OpeningBracketToken|MaxToken|OpeningBracketToken|NumberToken 123|CommaToken|AbsToken|OpeningBracketToken|"
+              "NumberToken 456|ClosingBracketToken|ClosingBracketToken|MinusToken|SqrToken|OpeningBracketToken|"
+              "NumberToken 7|ClosingBracketToken|ClosingBracketToken|MultiplyToken|NumberToken 8|UnknownToken &|"
+              "NumberToken 9|");
+}
+
+TEST(TokenizerTest, Keywords) {
+    for (const std::string input : {"min", "max", "abs", "sqr", "mi", "maxx", "sq", "ab", "absabs", "Min", "MAX",
+                                    "sqrt", "m", "mn", "mix", "sar", "bas", "xmax", "minmax", "max1", "abs(", "sqr,sqr"}) {
+        ExpectSame(input);
+        ExpectSame(" " + input + " ");
+    }
+    ASSERT_EQ(ToString(Tokenizer().Tokenize("mi maxx sq")), "VariableToken mi|VariableToken maxx|VariableToken sq|");
+}
+
+TEST(TokenizerTest, SymbolsAndHighBytes) {
+    ExpectSame("+-*/%(),");
+    ExpectSame("&^_!?[]{}`@#$~.;:'\"<>=|\\");
+    ExpectSame("\x80\xff\xc3\xa9 abc\x80" "def \xff" "123");
+    ExpectSame(std::string("a\0b", 3));
+    for (int c = 0; c < 256; ++c) {
+        ExpectSame(std::string(1, static_cast<char>(c)));
+        ExpectSame("x" + std::string(1, static_cast<char>(c)) + "1");
+    }
+}
+
+// серии от 8 символов проходят через SSE2 и AVX2; серия заканчивается в конце входа, ровно на границе 16 и 32 байт
+// и сразу за ней, в том числе когда за ней идет байт от 0x80
+TEST(TokenizerTest, LongRuns) {
+    const std::string fillers[] = {" ", "\t", "\n", " \t\r\n\v\f", "7", "9", "a", "Z", "xyz"};
+    const std::string tails[] = {"", "+", "1", "b", " ", "\x80", "\xff", "max"};
+    for (const std::string& filler : fillers) {
+        for (size_t prefix = 0; prefix < 3; ++prefix) {
+            for (size_t length = 1; length <= 70; ++length) {
+                std::string run;
+                while (run.size() < length) {
+                    run += filler;
+                }
+                run.resize(length);
+                for (const std::string& tail : tails) {
+                    ExpectSame(std::string(prefix, '(') + run + tail);
+                }
+            }
+        }
+    }
+}
+
+TEST(TokenizerTest, RunsAtBufferBoundaries) {
+    for (size_t length : {8, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65}) {
+        ExpectSame(std::string(length, ' '));
+        ExpectSame(std::string(length, 'q'));
+        ExpectSame(std::string(length, '1'));
+        ExpectSame("max" + std::string(length, ' ') + "min");
+        ExpectSame(std::string(length, 'a') + "\x80" + std::string(length, 'b'));
+        ExpectSame(std::string(length, ' ') + std::string(length, '5') + std::string(length, 'c'));
+    }
+}
+
+TEST(TokenizerTest, NumberWraparound) {
+    ExpectSame("2147483647 2147483648 4294967295 4294967296 99999999999999999999");
+    ASSERT_EQ(ToString(Tokenizer().Tokenize("2147483648")), "NumberToken -2147483648|");
+}
+
+TEST(TokenizerTest, RandomInputs) {
+    std::mt19937 rng(7);
+    const std::string alphabet = "abcdefghijklmnopqrstuvwxyzABCXYZ0123456789+-*/%(),  \t\n\v\f\r&^_!?\x80\xff\xc3\xa9[]{}`@";
+    for (int round = 0; round < 20000; ++round) {
+        std::string input;
+        const int pieces = rng() % 12;
+        for (int piece = 0; piece < pieces; ++piece) {
+            const int length = rng() % 80;
+            switch (rng() % 5) {
+            case 0:
+                input.append(length, " \t\n"[rng() % 3]);
+                break;
+            case 1:
+                for (int i = 0; i < length; ++i) {
+                    input += static_cast<char>('0' + rng() % 10);
+                }
+                break;
+            case 2:
+                for (int i = 0; i < length; ++i) {
+                    input += static_cast<char>((rng() % 2 ? 'a' : 'A') + rng() % 26);
+                }
+                break;
+            case 3:
+                input += rng() % 2 ? "max" : "sqr";
+                break;
+            default:
+                for (int i = 0; i < length % 20; ++i) {
+                    input += alphabet[rng() % alphabet.size()];
+                }
+                break;
+            }
+        }
+        ExpectSame(input);
+    }
+}
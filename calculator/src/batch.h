@@ -0,0 +1,221 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bytecode.h"
+#include "cpu_features.h"
+
+// вычисление одного выражения над многими строками данных: переменные привязываются к столбцам (непрерывным
+// массивам int одной длины), и каждая команда байткода выполняется сразу над блоком из kBlock строк
+// так стековая машина разбирает команду один раз на блок, а не на каждую строку, и сама команда - простой цикл
+// по массивам: + - * min max abs neg sqr на AVX2 считаются по 8 строк за раз (если процессор его умеет, проверяется
+// один раз через HasAvx2 из cpu_features.h), иначе компилятор векторизует эти же циклы под SSE2; / и % - обычные
+// циклы с проверкой на ноль, которые бросают std::runtime_error, как и Expression::Evaluate
+
+// ячейка стека - указатель на блок значений: load кладет указатель прямо в столбец без копирования, а push
+// и результаты команд пишутся в свой буфер на каждую ячейку; результат для строки i такой же, как у
+// Expression::Evaluate со значениями переменных из i-й строки столбцов
+
+class BatchEvaluator {
+public:
+    explicit BatchEvaluator(Expression expression);
+
+    void Bind(const std::string& name, const int* column);
+    void Evaluate(size_t rows, int* result) const;
+
+    const Expression& GetExpression() const { return expression_; }
+
+private:
+    static constexpr size_t kBlock = 1024;
+
+    Expression expression_;
+    std::vector<const int*> columns_;
+};
+
+// =============================================================================
+
+inline BatchEvaluator::BatchEvaluator(Expression expression)
+    : expression_(std::move(expression)), columns_(expression_.Variables().size(), nullptr) {}
+
+// столбец должен жить и содержать не меньше rows значений на время каждого Evaluate
+inline void BatchEvaluator::Bind(const std::string& name, const int* column) {
+    const auto& variables = expression_.Variables();
+    const auto it = std::find(variables.begin(), variables.end(), name);
+    if (it == variables.end()) {
+        throw std::runtime_error("expression has no variable " + name);
+    }
+    columns_[it - variables.begin()] = column;
+}
+
+// =============================================================================
+
+inline bool IsUnary(OpCode op) {
+    return op == OpCode::kNegate || op == OpCode::kAbs || op == OpCode::kSqr;
+}
+
+template <OpCode Op>
+inline int ApplyScalar(int a, int b) {
+    if constexpr (Op == OpCode::kAdd) {
+        return WrapAdd(a, b);
+    } else if constexpr (Op == OpCode::kSubtract) {
+        return WrapSubtract(a, b);
+    } else if constexpr (Op == OpCode::kMultiply) {
+        return WrapMultiply(a, b);
+    } else if constexpr (Op == OpCode::kDivide) {
+        return CheckedDivide(a, b);
+    } else if constexpr (Op == OpCode::kModulo) {
+        return CheckedModulo(a, b);
+    } else if constexpr (Op == OpCode::kMin) {
+        return b < a ? b : a;
+    } else if constexpr (Op == OpCode::kMax) {
+        return b > a ? b : a;
+    } else if constexpr (Op == OpCode::kNegate) {
+        return WrapSubtract(0, a);
+    } else if constexpr (Op == OpCode::kAbs) {
+        return a < 0 ? WrapSubtract(0, a) : a;
+    } else {
+        return WrapMultiply(a, a);
+    }
+}
+
+// у унарных команд b не используется; out может совпадать с a или b
+template <OpCode Op>
+inline void KernelScalar(const int* a, const int* b, int* out, size_t count, size_t from = 0) {
+    for (size_t i = from; i < count; ++i) {
+        if constexpr (Op == OpCode::kNegate || Op == OpCode::kAbs || Op == OpCode::kSqr) {
+            out[i] = ApplyScalar<Op>(a[i], 0);
+        } else {
+            out[i] = ApplyScalar<Op>(a[i], b[i]);
+        }
+    }
+}
+
+#ifdef CALCULATOR_SIMD
+
+template <OpCode Op>
+__attribute__((target("avx2"))) inline __m256i ApplyAvx2(__m256i a, __m256i b) {
+    if constexpr (Op == OpCode::kAdd) {
+        return _mm256_add_epi32(a, b);
+    } else if constexpr (Op == OpCode::kSubtract) {
+        return _mm256_sub_epi32(a, b);
+    } else if constexpr (Op == OpCode::kMultiply) {
+        return _mm256_mullo_epi32(a, b);
+    } else if constexpr (Op == OpCode::kMin) {
+        return _mm256_min_epi32(a, b);
+    } else if constexpr (Op == OpCode::kMax) {
+        return _mm256_max_epi32(a, b);
+    } else if constexpr (Op == OpCode::kNegate) {
+        return _mm256_sub_epi32(_mm256_setzero_si256(), a);
+    } else if constexpr (Op == OpCode::kAbs) {
+        return _mm256_abs_epi32(a);
+    } else {
+        return _mm256_mullo_epi32(a, a);
+    }
+}
+
+// команды переходят через ноль так же, как скалярные: abs(INT_MIN) остается INT_MIN
+template <OpCode Op>
+__attribute__((target("avx2"))) inline void KernelAvx2(const int* a, const int* b, int* out, size_t count) {
+    const bool unary = Op == OpCode::kNegate || Op == OpCode::kAbs || Op == OpCode::kSqr;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i y = unary ? x : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), ApplyAvx2<Op>(x, y));
+    }
+    KernelScalar<Op>(a, b, out, count, i);
+}
+
+#endif  // CALCULATOR_SIMD
+
+template <OpCode Op>
+inline void Kernel(const int* a, const int* b, int* out, size_t count) {
+#ifdef CALCULATOR_SIMD
+    if constexpr (Op != OpCode::kDivide && Op != OpCode::kModulo) {
+        if (HasAvx2()) {
+            KernelAvx2<Op>(a, b, out, count);
+            return;
+        }
+    }
+#endif
+    KernelScalar<Op>(a, b, out, count);
+}
+
+inline void RunKernel(OpCode op, const int* a, const int* b, int* out, size_t count) {
+    switch (op) {
+    case OpCode::kAdd:
+        return Kernel<OpCode::kAdd>(a, b, out, count);
+    case OpCode::kSubtract:
+        return Kernel<OpCode::kSubtract>(a, b, out, count);
+    case OpCode::kMultiply:
+        return Kernel<OpCode::kMultiply>(a, b, out, count);
+    case OpCode::kDivide:
+        return Kernel<OpCode::kDivide>(a, b, out, count);
+    case OpCode::kModulo:
+        return Kernel<OpCode::kModulo>(a, b, out, count);
+    case OpCode::kMin:
+        return Kernel<OpCode::kMin>(a, b, out, count);
+    case OpCode::kMax:
+        return Kernel<OpCode::kMax>(a, b, out, count);
+    case OpCode::kNegate:
+        return Kernel<OpCode::kNegate>(a, b, out, count);
+    case OpCode::kAbs:
+        return Kernel<OpCode::kAbs>(a, b, out, count);
+    case OpCode::kSqr:
+        return Kernel<OpCode::kSqr>(a, b, out, count);
+    default:
+        throw std::runtime_error("not an arithmetic opcode");
+    }
+}
+
+// =============================================================================
+
+// буферы ячеек выделяются один раз на вызов, дальше блоки идут без выделений памяти
+// при rows == 0 ничего не делает, столбцы в этом случае могут быть и не привязаны (data() пустого вектора - nullptr)
+inline void BatchEvaluator::Evaluate(size_t rows, int* result) const {
+    const auto& code = expression_.Code();
+    if (code.empty()) {
+        throw std::runtime_error("empty expression");
+    }
+    if (rows == 0) {
+        return;
+    }
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (!columns_[i]) {
+            throw std::runtime_error("variable " + expression_.Variables()[i] + " is not bound");
+        }
+    }
+    const size_t depth = expression_.StackDepth();
+    std::vector<int> buffers(depth * kBlock);
+    std::vector<const int*> stack(depth);
+    for (size_t start = 0; start < rows; start += kBlock) {
+        const size_t count = std::min(kBlock, rows - start);
+        const int* constant = expression_.Constants().data();
+        size_t top = 0;
+        for (OpCode op : code) {
+            if (op == OpCode::kPush) {
+                int* buffer = buffers.data() + top * kBlock;
+                std::fill(buffer, buffer + count, *constant++);
+                stack[top++] = buffer;
+            } else if (op == OpCode::kLoad) {
+                stack[top++] = columns_[*constant++] + start;
+            } else if (IsUnary(op)) {
+                int* buffer = buffers.data() + (top - 1) * kBlock;
+                RunKernel(op, stack[top - 1], nullptr, buffer, count);
+                stack[top - 1] = buffer;
+            } else {
+                int* buffer = buffers.data() + (top - 2) * kBlock;
+                RunKernel(op, stack[top - 2], stack[top - 1], buffer, count);
+                stack[top - 2] = buffer;
+                --top;
+            }
+        }
+        std::copy(stack[0], stack[0] + count, result + start);
+    }
+}
+
+#endif  // BATCH_H
@@ -0,0 +1,308 @@
+#ifndef BATCH_DRIVER_H
+#define BATCH_DRIVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "parser.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+// пакетный разбор файлов, в которых по выражению на строку: файл отображается в память (mmap), делится на куски
+// примерно по chunk_bytes байт по границам строк, и куски разбирают рабочие потоки, забирая их по очереди
+// у каждого потока свой буфер токенов, который переиспользуется от строки к строке, так что потоки не делят
+// ничего, кроме счетчика следующего куска
+// результат каждого куска - текст по строке на каждую строку входа; вызывающий поток отдает результаты кусков
+// строго в порядке входа (в файл или в буфер), как только готов очередной кусок, и сразу освобождает их;
+// рабочие потоки уходят вперед не больше чем на kPendingChunksPerThread кусков на поток
+
+// режимы: kEvaluate пишет значение выражения, kTokenize - число токенов строки (так измеряется скорость
+// разбора без парсера); ошибка в строке не останавливает разбор, а пишется вместо результата как "error: ..."
+// строки разделяются '\n', '\r' в конце строки отбрасывается, последняя строка может не заканчиваться '\n'
+
+enum class DriverMode {
+    kTokenize,
+    kEvaluate
+};
+
+// файл, отображенный в память только для чтения; пустой файл не отображается и дает пустой Data()
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    std::string_view Data() const { return std::string_view(data_, size_); }
+
+private:
+    const char* data_;
+    size_t size_;
+#if !defined(__unix__) && !defined(__APPLE__)
+    std::string buffer_;
+#endif
+};
+
+class BatchDriver {
+public:
+    explicit BatchDriver(DriverMode mode, size_t threads = std::thread::hardware_concurrency(),
+                         size_t chunk_bytes = kDefaultChunkBytes);
+
+    std::string Run(std::string_view input) const;
+    void Run(std::string_view input, const std::function<void(std::string_view)>& sink) const;
+    void RunFile(const std::string& input_path, const std::string& output_path) const;
+
+private:
+    static constexpr size_t kDefaultChunkBytes = 1 << 20;
+    static constexpr size_t kPendingChunksPerThread = 2;
+
+    std::vector<std::string_view> Split(std::string_view input) const;
+    void Process(std::string_view chunk, std::vector<Token>& tokens, std::string& output) const;
+
+    DriverMode mode_;
+    size_t threads_;
+    size_t chunk_bytes_;
+};
+
+// =============================================================================
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// ядро читает файл с опережением, так как он проходится один раз подряд (MADV_SEQUENTIAL)
+inline MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error("cannot stat " + path + ": " + std::strerror(error));
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            const int error = errno;
+            close(fd);
+            throw std::runtime_error("cannot map " + path + ": " + std::strerror(error));
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+    close(fd);
+}
+
+inline MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#else
+
+// без mmap файл просто читается в память целиком
+inline MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+inline MappedFile::~MappedFile() {}
+
+#endif
+
+// =============================================================================
+
+// threads 0 (hardware_concurrency не смог ответить) считается за 1, chunk_bytes 0 - за 1 байт
+inline BatchDriver::BatchDriver(DriverMode mode, size_t threads, size_t chunk_bytes)
+    : mode_(mode), threads_(threads == 0 ? 1 : threads), chunk_bytes_(chunk_bytes == 0 ? 1 : chunk_bytes) {}
+
+inline std::string BatchDriver::Run(std::string_view input) const {
+    std::string output;
+    Run(input, [&output](std::string_view result) { output.append(result); });
+    return output;
+}
+
+// рабочие потоки берут куски по атомарному счетчику; вызывающий поток ждет куски по порядку и отдает их в sink
+// поток, взявший кусок i, ждет, пока i не окажется меньше чем на window кусков впереди последнего отданного, так что
+// готовых, но еще не отданных результатов в памяти не больше window, даже если sink медленнее разбора
+// исключение рабочего потока (не ошибка строки, а, например, bad_alloc) или sink останавливает остальных:
+// необработанные куски пропускаются, все потоки дожидаются, и первое исключение пробрасывается из Run
+inline void BatchDriver::Run(std::string_view input, const std::function<void(std::string_view)>& sink) const {
+    const std::vector<std::string_view> chunks = Split(input);
+    std::vector<std::string> outputs(chunks.size());
+    std::vector<char> ready(chunks.size(), 0);
+    const size_t count = std::min(threads_, chunks.size());
+    const size_t window = count * kPendingChunksPerThread;
+    std::atomic<size_t> next(0);
+    size_t written = 0;
+    bool stopped = false;
+    std::exception_ptr failure;
+    std::mutex mutex;
+    std::condition_variable progress;
+
+    auto stop = [&](std::exception_ptr error) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure) {
+                failure = error;
+            }
+            stopped = true;
+        }
+        progress.notify_all();
+    };
+    auto work = [&] {
+        try {
+            std::vector<Token> tokens;
+            for (size_t i = next.fetch_add(1); i < chunks.size(); i = next.fetch_add(1)) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    progress.wait(lock, [&] { return stopped || i < written + window; });
+                    if (stopped) {
+                        return;
+                    }
+                }
+                Process(chunks[i], tokens, outputs[i]);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready[i] = 1;
+                }
+                progress.notify_all();
+            }
+        } catch (...) {
+            stop(std::current_exception());
+        }
+    };
+    std::vector<std::thread> workers;
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            workers.emplace_back(work);
+        }
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                progress.wait(lock, [&] { return stopped || ready[i] != 0; });
+                if (stopped) {
+                    break;
+                }
+            }
+            sink(outputs[i]);
+            std::string().swap(outputs[i]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++written;
+            }
+            progress.notify_all();
+        }
+    } catch (...) {
+        stop(std::current_exception());
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+inline void BatchDriver::RunFile(const std::string& input_path, const std::string& output_path) const {
+    const MappedFile input(input_path);
+    std::FILE* file = std::fopen(output_path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot open " + output_path + ": " + std::strerror(errno));
+    }
+    try {
+        Run(input.Data(), [file, &output_path](std::string_view result) {
+            if (std::fwrite(result.data(), 1, result.size(), file) != result.size()) {
+                throw std::runtime_error("cannot write " + output_path);
+            }
+        });
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("cannot write " + output_path);
+    }
+}
+
+// =============================================================================
+
+// граница куска сдвигается вперед до ближайшего конца строки, поэтому строка не попадает в два куска
+inline std::vector<std::string_view> BatchDriver::Split(std::string_view input) const {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+    while (start < input.size()) {
+        size_t end = std::min(start + chunk_bytes_, input.size());
+        if (end < input.size()) {
+            const size_t newline = input.find('\n', end - 1);
+            end = newline == std::string_view::npos ? input.size() : newline + 1;
+        }
+        chunks.push_back(input.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+// tokens - буфер потока для парсера: clear оставляет его емкость, поэтому после первых строк вектор больше не растет
+// для подсчета токенов вектор не нужен, они считаются прямо из TokenStream
+inline void BatchDriver::Process(std::string_view chunk, std::vector<Token>& tokens, std::string& output) const {
+    output.reserve(chunk.size() / 2);
+    size_t start = 0;
+    while (start < chunk.size()) {
+        size_t end = chunk.find('\n', start);
+        end = end == std::string_view::npos ? chunk.size() : end;
+        std::string_view line = chunk.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        start = end + 1;
+        char number[16];
+        try {
+            int value = 0;
+            if (mode_ == DriverMode::kTokenize) {
+                for (TokenStream stream(line); stream.Next();) {
+                    ++value;
+                }
+            } else {
+                tokens.clear();
+                for (const TokenView& token : TokenStream(line)) {
+                    tokens.push_back(ToToken(token));
+                }
+                value = Parser(tokens).Parse().Evaluate();
+            }
+            const auto result = std::to_chars(number, number + sizeof(number), value);
+            output.append(number, result.ptr);
+        } catch (const std::runtime_error& error) {
+            output.append("error: ").append(error.what());
+        }
+        output.push_back('\n');
+    }
+}
+
+#endif  // BATCH_DRIVER_H
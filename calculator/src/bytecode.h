@@ -0,0 +1,199 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// скомпилированное выражение: байткод для стековой машины вместо дерева из std::variant
+// код - последовательность однобайтовых команд, у команд нет операндов: kPush берет следующее число из constants
+// по порядку, поэтому числа лежат отдельным плотным массивом и читаются одним указателем; kLoad так же берет
+// из constants номер переменной в Variables() и кладет ее значение
+// максимальная глубина стека известна после компиляции, и Evaluate не выделяет память, если она не больше kInlineStack
+// выражения строит Parser (parser.h), сам Expression ничего не знает о токенах
+// значения переменных передаются в Evaluate в порядке Variables(), то есть в порядке их первого появления в тексте;
+// чтобы вычислить выражение над целыми столбцами значений, есть BatchEvaluator (batch.h)
+
+// арифметика целочисленная, как у NumberToken: + - * и sqr при переполнении int переходят через ноль (как unsigned),
+// деление и остаток округляют к нулю, деление и остаток на ноль - ошибка std::runtime_error
+
+enum class OpCode : std::uint8_t {
+    kPush,
+    kLoad,
+    kAdd,
+    kSubtract,
+    kMultiply,
+    kDivide,
+    kModulo,
+    kNegate,
+    kMin,
+    kMax,
+    kAbs,
+    kSqr
+};
+
+std::ostream& operator<<(std::ostream& os, OpCode op);
+
+class Expression {
+public:
+    Expression() : depth_(0) {};
+    Expression(std::vector<OpCode> code, std::vector<int> constants, std::vector<std::string> variables, size_t depth);
+
+    int Evaluate() const;
+    int Evaluate(const std::vector<int>& values) const;
+
+    const std::vector<OpCode>& Code() const { return code_; }
+    const std::vector<int>& Constants() const { return constants_; }
+    const std::vector<std::string>& Variables() const { return variables_; }
+    size_t StackDepth() const { return depth_; }
+
+private:
+    static constexpr size_t kInlineStack = 64;
+
+    int Run(int* stack, const int* values) const;
+
+    std::vector<OpCode> code_;
+    std::vector<int> constants_;
+    std::vector<std::string> variables_;
+    size_t depth_;
+};
+
+std::ostream& operator<<(std::ostream& os, const Expression& expression);
+
+// =============================================================================
+
+inline std::ostream& operator<<(std::ostream& os, OpCode op) {
+    static const char* const names[] = {"push", "load", "add", "sub", "mul", "div", "mod", "neg", "min", "max", "abs", "sqr"};
+    return os << names[static_cast<size_t>(op)];
+}
+
+// код должен быть корректным: Parser следит, чтобы каждой команде хватало операндов и в конце осталось одно значение
+inline Expression::Expression(std::vector<OpCode> code, std::vector<int> constants, std::vector<std::string> variables,
+                              size_t depth)
+    : code_(std::move(code)), constants_(std::move(constants)), variables_(std::move(variables)), depth_(depth) {}
+
+// по строке на команду, у push - число, которое она положит, у load - имя переменной
+inline std::ostream& operator<<(std::ostream& os, const Expression& expression) {
+    size_t constant = 0;
+    for (OpCode op : expression.Code()) {
+        os << op;
+        if (op == OpCode::kPush) {
+            os << ' ' << expression.Constants()[constant++];
+        } else if (op == OpCode::kLoad) {
+            os << ' ' << expression.Variables()[expression.Constants()[constant++]];
+        }
+        os << '\n';
+    }
+    return os;
+}
+
+// =============================================================================
+
+// сложение, вычитание и умножение в unsigned дают переход через ноль без UB
+inline int WrapAdd(int a, int b) {
+    return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+}
+
+inline int WrapSubtract(int a, int b) {
+    return static_cast<int>(static_cast<unsigned>(a) - static_cast<unsigned>(b));
+}
+
+inline int WrapMultiply(int a, int b) {
+    return static_cast<int>(static_cast<unsigned>(a) * static_cast<unsigned>(b));
+}
+
+// INT_MIN / -1 не помещается в int и тоже переходит через ноль, а INT_MIN % -1 равно нулю
+inline int CheckedDivide(int a, int b) {
+    if (b == 0) {
+        throw std::runtime_error("division by zero");
+    }
+    return b == -1 ? WrapSubtract(0, a) : a / b;
+}
+
+inline int CheckedModulo(int a, int b) {
+    if (b == 0) {
+        throw std::runtime_error("modulo by zero");
+    }
+    return b == -1 ? 0 : a % b;
+}
+
+inline int Expression::Evaluate() const {
+    return Evaluate({});
+}
+
+// стек на kInlineStack значений лежит на стеке вызова, более глубокие выражения получают его в куче
+inline int Expression::Evaluate(const std::vector<int>& values) const {
+    if (code_.empty()) {
+        throw std::runtime_error("empty expression");
+    }
+    if (values.size() != variables_.size()) {
+        throw std::runtime_error("expression has " + std::to_string(variables_.size()) + " variables, got "
+                                 + std::to_string(values.size()) + " values");
+    }
+    if (depth_ > kInlineStack) {
+        std::vector<int> stack(depth_);
+        return Run(stack.data(), values.data());
+    }
+    int stack[kInlineStack];
+    return Run(stack, values.data());
+}
+
+// top - следующая свободная ячейка стека, бинарная команда кладет результат на место левого операнда
+inline int Expression::Run(int* top, const int* values) const {
+    const int* constant = constants_.data();
+    for (OpCode op : code_) {
+        switch (op) {
+        case OpCode::kPush:
+            *top++ = *constant++;
+            break;
+        case OpCode::kLoad:
+            *top++ = values[*constant++];
+            break;
+        case OpCode::kAdd:
+            --top;
+            top[-1] = WrapAdd(top[-1], top[0]);
+            break;
+        case OpCode::kSubtract:
+            --top;
+            top[-1] = WrapSubtract(top[-1], top[0]);
+            break;
+        case OpCode::kMultiply:
+            --top;
+            top[-1] = WrapMultiply(top[-1], top[0]);
+            break;
+        case OpCode::kDivide:
+            --top;
+            top[-1] = CheckedDivide(top[-1], top[0]);
+            break;
+        case OpCode::kModulo:
+            --top;
+            top[-1] = CheckedModulo(top[-1], top[0]);
+            break;
+        case OpCode::kNegate:
+            top[-1] = WrapSubtract(0, top[-1]);
+            break;
+        case OpCode::kMin:
+            --top;
+            top[-1] = top[0] < top[-1] ? top[0] : top[-1];
+            break;
+        case OpCode::kMax:
+            --top;
+            top[-1] = top[0] > top[-1] ? top[0] : top[-1];
+            break;
+        case OpCode::kAbs:
+            top[-1] = top[-1] < 0 ? WrapSubtract(0, top[-1]) : top[-1];
+            break;
+        case OpCode::kSqr:
+            top[-1] = WrapMultiply(top[-1], top[-1]);
+            break;
+        }
+    }
+    return top[-1];
+}
+
+#endif  // BYTECODE_H
@@ -0,0 +1,147 @@
+#ifndef COMPACT_TOKENS_H
+#define COMPACT_TOKENS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "tokenizer.h"
+
+// компактное представление разобранной строки: вместо вектора Token (std::variant размером с std::string, который
+// надо копировать и разрушать по одному) - структура массивов: вид токена в 1 байт, смещение и длина его текста
+// во входе по 4 байта и отдельный массив значений чисел, в котором только числа, по порядку
+// на токен уходит 9 байт плюс 4 на каждое число; все массивы из тривиально копируемых значений, поэтому
+// CompactTokens копируется и освобождается как четыре буфера, а CompactTokenSpan - просто набор указателей
+// текст имен и неизвестных символов не копируется: его берут из исходной строки по смещению и длине,
+// поэтому она должна жить, пока нужен этот текст; вход длиннее 4 ГБ не помещается в 32-битные смещения
+
+// для отладки ToTokens переводит все обратно в обычные Token, и их можно печатать через operator<<
+
+// номера видов совпадают с номерами альтернатив Token и TokenView
+enum class TokenKind : std::uint8_t {
+    kOpeningBracket,
+    kClosingBracket,
+    kComma,
+    kMin,
+    kMax,
+    kAbs,
+    kSqr,
+    kPlus,
+    kMinus,
+    kMultiply,
+    kModulo,
+    kDivide,
+    kNumber,
+    kVariable,
+    kUnknown
+};
+
+static_assert(std::variant_size_v<Token> == static_cast<size_t>(TokenKind::kUnknown) + 1, "TokenKind must follow Token");
+static_assert(std::variant_size_v<TokenView> == std::variant_size_v<Token>, "TokenView must follow Token");
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(TokenKind::kNumber), Token>, NumberToken>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(TokenKind::kVariable), Token>, VariableToken>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(TokenKind::kUnknown), Token>, UnknownToken>);
+
+// невладеющий вид на CompactTokens, тривиально копируемый, его можно передавать по значению
+struct CompactTokenSpan {
+    const TokenKind* kinds;
+    const std::uint32_t* offsets;
+    const std::uint32_t* lengths;
+    const int* numbers;
+    size_t size;
+    size_t number_count;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactTokenSpan>);
+
+class CompactTokens {
+public:
+    CompactTokens() {};
+
+    static CompactTokens Tokenize(std::string_view input);
+
+    size_t Size() const { return kinds_.size(); }
+    size_t Bytes() const;
+    CompactTokenSpan Span() const;
+
+    TokenKind Kind(size_t index) const { return kinds_[index]; }
+    std::string_view Text(size_t index, std::string_view input) const { return input.substr(offsets_[index], lengths_[index]); }
+    const std::vector<int>& Numbers() const { return numbers_; }
+
+    std::vector<Token> ToTokens(std::string_view input) const;
+
+private:
+    std::vector<TokenKind> kinds_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint32_t> lengths_;
+    std::vector<int> numbers_;
+};
+
+// =============================================================================
+
+// размер токенов заранее неизвестен, поэтому массивы резервируются по оценке "токен на каждые 4 байта входа"
+inline CompactTokens CompactTokens::Tokenize(std::string_view input) {
+    if (input.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("input is too large for compact tokens");
+    }
+    CompactTokens tokens;
+    tokens.kinds_.reserve(input.size() / 4);
+    tokens.offsets_.reserve(input.size() / 4);
+    tokens.lengths_.reserve(input.size() / 4);
+    TokenStream stream(input);
+    while (const std::optional<TokenView> token = stream.Next()) {
+        const auto kind = static_cast<TokenKind>(token->index());
+        tokens.kinds_.push_back(kind);
+        tokens.offsets_.push_back(static_cast<std::uint32_t>(stream.TokenStart()));
+        tokens.lengths_.push_back(static_cast<std::uint32_t>(stream.Position() - stream.TokenStart()));
+        if (kind == TokenKind::kNumber) {
+            tokens.numbers_.push_back(std::get<NumberToken>(*token).value);
+        }
+    }
+    return tokens;
+}
+
+// по занятым элементам, без запаса емкости векторов
+inline size_t CompactTokens::Bytes() const {
+    return kinds_.size() * (sizeof(TokenKind) + 2 * sizeof(std::uint32_t)) + numbers_.size() * sizeof(int);
+}
+
+inline CompactTokenSpan CompactTokens::Span() const {
+    return CompactTokenSpan{kinds_.data(), offsets_.data(), lengths_.data(), numbers_.data(), kinds_.size(), numbers_.size()};
+}
+
+// вид токена, кроме числа, имени и неизвестного символа, однозначно задает его альтернативу Token,
+// а у этих трех значение берется из массива чисел или из текста входа
+inline std::vector<Token> CompactTokens::ToTokens(std::string_view input) const {
+    static const Token kPlain[] = {OpeningBracketToken{}, ClosingBracketToken{}, CommaToken{}, MinToken{}, MaxToken{},
+                                   AbsToken{}, SqrToken{}, PlusToken{}, MinusToken{}, MultiplyToken{}, ModuloToken{},
+                                   DivideToken{}};
+    std::vector<Token> result;
+    result.reserve(Size());
+    size_t number = 0;
+    for (size_t i = 0; i < Size(); ++i) {
+        switch (kinds_[i]) {
+        case TokenKind::kNumber:
+            result.emplace_back(NumberToken{numbers_[number++]});
+            break;
+        case TokenKind::kVariable:
+            result.emplace_back(VariableToken{std::string(Text(i, input))});
+            break;
+        case TokenKind::kUnknown:
+            result.emplace_back(UnknownToken{std::string(Text(i, input))});
+            break;
+        default:
+            result.push_back(kPlain[static_cast<size_t>(kinds_[i])]);
+            break;
+        }
+    }
+    return result;
+}
+
+#endif  // COMPACT_TOKENS_H
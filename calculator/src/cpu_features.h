@@ -0,0 +1,23 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// общие для токенайзера и пакетного вычисления проверки процессора
+// CALCULATOR_SIMD определен, если компилятор - GCC или Clang под x86 с SSE2: тогда доступны интринсики из immintrin.h,
+// а AVX2-функции собираются с __attribute__((target("avx2"))) и вызываются, только если HasAvx2()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define CALCULATOR_SIMD 1
+#include <immintrin.h>
+#endif
+
+#ifdef CALCULATOR_SIMD
+
+// процессор опрашивается один раз при первом вызове
+inline bool HasAvx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#endif  // CALCULATOR_SIMD
+
+#endif  // CPU_FEATURES_H
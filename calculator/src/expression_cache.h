@@ -0,0 +1,211 @@
+#ifndef EXPRESSION_CACHE_H
+#define EXPRESSION_CACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "parser.h"
+
+// кэш скомпилированных выражений для цикла калькулятора, который вычисляет одни и те же строки снова и снова
+// по тексту выражения хранятся его токены и байткод, поэтому горячие выражения не проходят ни Tokenize, ни Parser
+// вытесняется давно не использованное выражение (LRU), когда суммарный размер записей превышает бюджет памяти
+
+// потокобезопасность: кэш разбит на шарды по хешу текста, у каждого шарда свой мьютекс, свой список LRU и своя
+// доля бюджета, так что потоки с разными выражениями почти не ждут друг друга
+// Get отдает shared_ptr, и запись, вытесненную другим потоком, можно спокойно вычислять дальше
+// выражение компилируется вне мьютекса; если два потока одновременно промахнулись по одному тексту, оба его
+// скомпилируют, а в кэше останется первая запись
+// ошибочные выражения не кэшируются: Get бросает то же std::runtime_error, что и Compile, и считает промах
+
+// размер записи - оценка: текст, токены, байткод, числа, имена переменных (вместе с их текстом в куче, если он не
+// поместился в саму строку) и служебные поля списка и хеш-таблицы (CachedExpression::Bytes)
+// выражение, которое не влезает в долю бюджета одного шарда, компилируется и возвращается, но не кэшируется
+// у каждого шарда не меньше kMinShardBudget байт бюджета: при маленьком бюджете шардов становится меньше, вплоть до
+// одного, иначе доля каждого шарда была бы меньше одной записи и кэш не хранил бы ничего
+
+struct CachedExpression {
+    std::vector<Token> tokens;
+    Expression expression;
+
+    size_t Bytes() const;
+};
+
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+class ExpressionCache {
+public:
+    explicit ExpressionCache(size_t memory_budget, size_t shards = kDefaultShards);
+    ExpressionCache(const ExpressionCache&) = delete;
+    ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+    std::shared_ptr<const CachedExpression> Get(std::string_view text);
+    int Evaluate(std::string_view text);
+    int Evaluate(std::string_view text, const std::vector<int>& values);
+
+    CacheStats Stats() const;
+    size_t MemoryBudget() const { return budget_; }
+    size_t ShardCount() const { return shards_.size(); }
+    void Clear();
+
+private:
+    static constexpr size_t kDefaultShards = 16;
+    static constexpr size_t kMinShardBudget = 64 << 10;
+
+    struct Entry {
+        std::string text;
+        std::shared_ptr<const CachedExpression> value;
+        size_t bytes;
+    };
+
+    // ключ хеш-таблицы - string_view на текст внутри записи списка, поэтому поиск по string_view не строит строку
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    static size_t EntryBytes(const Entry& entry);
+    void Insert(Shard& shard, std::string_view text, const std::shared_ptr<const CachedExpression>& value);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t budget_;
+    size_t shard_budget_;
+};
+
+// =============================================================================
+
+// строка короче 16 символов хранится в самом объекте (SSO), длиннее - в куче вместе с завершающим нулем
+inline size_t StringHeapBytes(const std::string& text) {
+    return text.capacity() > 15 ? text.capacity() + 1 : 0;
+}
+
+inline size_t CachedExpression::Bytes() const {
+    size_t bytes = sizeof(CachedExpression) + tokens.capacity() * sizeof(Token) + expression.Code().capacity() * sizeof(OpCode)
+        + expression.Constants().capacity() * sizeof(int) + expression.Variables().capacity() * sizeof(std::string);
+    for (const Token& token : tokens) {
+        if (const auto* variable = std::get_if<VariableToken>(&token)) {
+            bytes += StringHeapBytes(variable->name);
+        } else if (const auto* unknown = std::get_if<UnknownToken>(&token)) {
+            bytes += StringHeapBytes(unknown->value);
+        }
+    }
+    for (const std::string& name : expression.Variables()) {
+        bytes += StringHeapBytes(name);
+    }
+    return bytes;
+}
+
+// shards 0 считается за 1; шардов не больше, чем помещается долей по kMinShardBudget в бюджет
+inline ExpressionCache::ExpressionCache(size_t memory_budget, size_t shards) : budget_(memory_budget) {
+    shards = std::max<size_t>(1, std::min(shards, budget_ / kMinShardBudget));
+    for (size_t i = 0; i < shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+    shard_budget_ = budget_ / shards;
+}
+
+// запись списка (два указателя и Entry), узел хеш-таблицы (ключ, итератор, указатель и хеш) и блок shared_ptr
+inline size_t ExpressionCache::EntryBytes(const Entry& entry) {
+    const size_t list_node = 2 * sizeof(void*) + sizeof(Entry);
+    const size_t map_node = sizeof(void*) + sizeof(std::string_view) + sizeof(std::list<Entry>::iterator) + sizeof(size_t);
+    const size_t control_block = 2 * sizeof(void*);
+    return list_node + map_node + control_block + StringHeapBytes(entry.text) + entry.value->Bytes();
+}
+
+// =============================================================================
+
+// попадание переносит запись в начало списка; промах компилирует выражение без мьютекса и добавляет его в кэш
+inline std::shared_ptr<const CachedExpression> ExpressionCache::Get(std::string_view text) {
+    Shard& shard = *shards_[std::hash<std::string_view>()(text) % shards_.size()];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (auto it = shard.index.find(text); it != shard.index.end()) {
+            ++shard.hits;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return it->second->value;
+        }
+        ++shard.misses;
+    }
+    auto value = std::make_shared<CachedExpression>();
+    value->tokens = Tokenizer().Tokenize(std::string(text));
+    value->expression = Parser(value->tokens).Parse();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (auto it = shard.index.find(text); it != shard.index.end()) {
+        return it->second->value;
+    }
+    Insert(shard, text, value);
+    return value;
+}
+
+inline int ExpressionCache::Evaluate(std::string_view text) {
+    return Get(text)->expression.Evaluate();
+}
+
+// values - значения переменных в порядке Variables() скомпилированного выражения
+inline int ExpressionCache::Evaluate(std::string_view text, const std::vector<int>& values) {
+    return Get(text)->expression.Evaluate(values);
+}
+
+// вызывается под мьютексом шарда; вытесняет записи с конца списка, пока новая не поместится в долю бюджета
+inline void ExpressionCache::Insert(Shard& shard, std::string_view text, const std::shared_ptr<const CachedExpression>& value) {
+    shard.lru.push_front(Entry{std::string(text), value, 0});
+    Entry& entry = shard.lru.front();
+    entry.bytes = EntryBytes(entry);
+    if (entry.bytes > shard_budget_) {
+        shard.lru.pop_front();
+        return;
+    }
+    while (shard.bytes + entry.bytes > shard_budget_) {
+        const Entry& victim = shard.lru.back();
+        shard.bytes -= victim.bytes;
+        shard.index.erase(victim.text);
+        shard.lru.pop_back();
+        ++shard.evictions;
+    }
+    shard.index.emplace(entry.text, shard.lru.begin());
+    shard.bytes += entry.bytes;
+}
+
+// шарды опрашиваются по очереди, поэтому при одновременной работе других потоков сумма - не мгновенный снимок
+inline CacheStats ExpressionCache::Stats() const {
+    CacheStats stats;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.entries += shard->lru.size();
+        stats.bytes += shard->bytes;
+    }
+    return stats;
+}
+
+// удаляет все записи, счетчики попаданий, промахов и вытеснений сохраняются
+inline void ExpressionCache::Clear() {
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+        shard->bytes = 0;
+    }
+}
+
+#endif  // EXPRESSION_CACHE_H
@@ -1,4 +1,4 @@
-#include "tokenizer.h"
+#include "parser.h"
 
 
 int main() {
@@ -9,5 +9,21 @@ int main() {
     std::cout << "Tokens:" << std::endl;
     for (const auto& token : tokens)
         std::cout << token << std::endl;
+
+    // те же токены потоком, без вектора и без копий текста
+    std::cout << "Streamed tokens:" << std::endl;
+    for (const auto& token : TokenStream(input))
+        std::cout << token << std::endl;
+
+    // & - неизвестный токен, поэтому пример целиком не вычисляется, а выражение без него - вычисляется
+    for (const std::string& source : {input, std::string("(max(123, abs(456)) - sqr(7)) * 8")}) {
+        try {
+            Expression expression = Compile(source);
+            std::cout << "Bytecode of " << source << ":" << std::endl << expression;
+            std::cout << "Result: " << expression.Evaluate() << std::endl;
+        } catch (const std::runtime_error& error) {
+            std::cout << "Error in " << source << ": " << error.what() << std::endl;
+        }
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,240 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bytecode.h"
+#include "tokenizer.h"
+
+// парсер Пратта: переводит вектор токенов сразу в байткод Expression, не строя дерево
+// грамматика:
+//     выражение = операнд { (+ | - | * | / | %) операнд }, у * / % приоритет выше, все операторы левоассоциативные
+//     операнд   = число | переменная | (- | +) операнд | ( выражение ) | функция ( выражение { , выражение } )
+// min и max принимают одно и больше выражений, abs и sqr - ровно одно
+// переменная - любое имя из букв, кроме имен функций; одинаковые имена - одна переменная
+// токенайзер неправильный ввод не проверяет, поэтому все ошибки ввода находит парсер: неизвестный токен, лишняя
+// или недостающая скобка, запятая вне аргументов функции, пропущенный операнд, неверное число аргументов
+// ошибка - std::runtime_error с номером токена (считая с нуля) и описанием
+// вложенность скобок и унарных минусов ограничена kMaxNesting, чтобы длинная цепочка "((((" не переполнила стек вызовов
+
+class Parser {
+public:
+    explicit Parser(const std::vector<Token>& tokens) : tokens_(tokens), pos_(0), nesting_(0), depth_(0), max_depth_(0) {};
+
+    Expression Parse();
+
+private:
+    static constexpr size_t kMaxNesting = 256;
+
+    void ParseExpression(int min_power);
+    void ParseOperand();
+    void ParseCall(OpCode op, size_t min_args, size_t max_args, const char* name);
+    void Expect(size_t opened, const char* what);
+    int VariableIndex(const std::string& name);
+    void Emit(OpCode op);
+    [[noreturn]] void Fail(const std::string& message) const;
+
+    const std::vector<Token>& tokens_;
+    size_t pos_;
+    size_t nesting_;
+    std::vector<OpCode> code_;
+    std::vector<int> constants_;
+    std::vector<std::string> variables_;
+    size_t depth_;
+    size_t max_depth_;
+};
+
+// разбирает строку целиком: Tokenizer, затем Parser
+Expression Compile(const std::string& input);
+
+// =============================================================================
+
+// сила связывания бинарного оператора, 0 - токен не бинарный оператор
+inline int BindingPower(const Token& token, OpCode& op) {
+    if (std::holds_alternative<PlusToken>(token)) {
+        op = OpCode::kAdd;
+        return 1;
+    }
+    if (std::holds_alternative<MinusToken>(token)) {
+        op = OpCode::kSubtract;
+        return 1;
+    }
+    if (std::holds_alternative<MultiplyToken>(token)) {
+        op = OpCode::kMultiply;
+        return 2;
+    }
+    if (std::holds_alternative<DivideToken>(token)) {
+        op = OpCode::kDivide;
+        return 2;
+    }
+    if (std::holds_alternative<ModuloToken>(token)) {
+        op = OpCode::kModulo;
+        return 2;
+    }
+    return 0;
+}
+
+inline Expression Parser::Parse() {
+    if (tokens_.empty()) {
+        Fail("empty expression");
+    }
+    ParseExpression(0);
+    if (pos_ < tokens_.size()) {
+        Fail("unexpected token");
+    }
+    return Expression(std::move(code_), std::move(constants_), std::move(variables_), max_depth_);
+}
+
+// после операнда забирает бинарные операторы, которые связывают сильнее min_power; правый операнд разбирается
+// с силой самого оператора, поэтому оператор того же приоритета достанется внешнему циклу (левая ассоциативность)
+inline void Parser::ParseExpression(int min_power) {
+    ParseOperand();
+    while (pos_ < tokens_.size()) {
+        if (std::holds_alternative<UnknownToken>(tokens_[pos_])) {
+            Fail("unknown token");
+        }
+        OpCode op = OpCode::kAdd;
+        const int power = BindingPower(tokens_[pos_], op);
+        if (power <= min_power) {
+            return;
+        }
+        ++pos_;
+        ParseExpression(power);
+        Emit(op);
+    }
+}
+
+inline void Parser::ParseOperand() {
+    if (pos_ == tokens_.size()) {
+        Fail("missing operand");
+    }
+    if (++nesting_ > kMaxNesting) {
+        Fail("expression is nested too deeply");
+    }
+    const Token& token = tokens_[pos_];
+    if (const auto* number = std::get_if<NumberToken>(&token)) {
+        ++pos_;
+        constants_.push_back(number->value);
+        Emit(OpCode::kPush);
+    } else if (const auto* variable = std::get_if<VariableToken>(&token)) {
+        ++pos_;
+        constants_.push_back(VariableIndex(variable->name));
+        Emit(OpCode::kLoad);
+    } else if (std::holds_alternative<MinusToken>(token)) {
+        ++pos_;
+        ParseOperand();
+        Emit(OpCode::kNegate);
+    } else if (std::holds_alternative<PlusToken>(token)) {
+        ++pos_;
+        ParseOperand();
+    } else if (std::holds_alternative<OpeningBracketToken>(token)) {
+        const size_t open = pos_++;
+        ParseExpression(0);
+        Expect(open, "closing bracket");
+    } else if (std::holds_alternative<MinToken>(token)) {
+        ParseCall(OpCode::kMin, 1, SIZE_MAX, "min");
+    } else if (std::holds_alternative<MaxToken>(token)) {
+        ParseCall(OpCode::kMax, 1, SIZE_MAX, "max");
+    } else if (std::holds_alternative<AbsToken>(token)) {
+        ParseCall(OpCode::kAbs, 1, 1, "abs");
+    } else if (std::holds_alternative<SqrToken>(token)) {
+        ParseCall(OpCode::kSqr, 1, 1, "sqr");
+    } else if (std::holds_alternative<UnknownToken>(token)) {
+        Fail("unknown token");
+    } else {
+        Fail("expected operand");
+    }
+    --nesting_;
+}
+
+// у min и max каждый аргумент после первого сразу сворачивается с накопленным значением, так что стек не растет
+// с числом аргументов; у abs и sqr команда идет после единственного аргумента
+inline void Parser::ParseCall(OpCode op, size_t min_args, size_t max_args, const char* name) {
+    const size_t call = pos_++;
+    if (pos_ == tokens_.size() || !std::holds_alternative<OpeningBracketToken>(tokens_[pos_])) {
+        Fail(std::string("expected opening bracket after ") + name);
+    }
+    ++pos_;
+    size_t args = 0;
+    for (;;) {
+        ParseExpression(0);
+        if (++args > 1) {
+            Emit(op);
+        }
+        if (pos_ == tokens_.size() || !std::holds_alternative<CommaToken>(tokens_[pos_])) {
+            break;
+        }
+        ++pos_;
+    }
+    Expect(call, "closing bracket");
+    if (args < min_args || args > max_args) {
+        pos_ = call;
+        Fail(std::string(name) + " takes " + std::to_string(min_args) + " argument" + (min_args == 1 ? "" : "s")
+             + (max_args == min_args ? "" : " or more") + ", got " + std::to_string(args));
+    }
+    if (max_args == 1) {
+        Emit(op);
+    }
+}
+
+// ждет закрывающую скобку; opened - номер токена, который ее открыл, он попадает в сообщение
+inline void Parser::Expect(size_t opened, const char* what) {
+    if (pos_ < tokens_.size() && std::holds_alternative<ClosingBracketToken>(tokens_[pos_])) {
+        ++pos_;
+        return;
+    }
+    Fail(std::string("expected ") + what + " for token " + std::to_string(opened));
+}
+
+// номер переменной в порядке первого появления; переменных в выражении мало, поэтому поиск линейный
+inline int Parser::VariableIndex(const std::string& name) {
+    for (size_t i = 0; i < variables_.size(); ++i) {
+        if (variables_[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    variables_.push_back(name);
+    return static_cast<int>(variables_.size() - 1);
+}
+
+// глубина стека считается по ходу компиляции: push и load добавляют значение, бинарная команда забирает одно
+inline void Parser::Emit(OpCode op) {
+    switch (op) {
+    case OpCode::kPush:
+    case OpCode::kLoad:
+        ++depth_;
+        break;
+    case OpCode::kNegate:
+    case OpCode::kAbs:
+    case OpCode::kSqr:
+        break;
+    default:
+        --depth_;
+        break;
+    }
+    code_.push_back(op);
+    max_depth_ = depth_ > max_depth_ ? depth_ : max_depth_;
+}
+
+inline void Parser::Fail(const std::string& message) const {
+    std::ostringstream os;
+    os << "parse error at token " << pos_;
+    if (pos_ < tokens_.size()) {
+        os << " (" << tokens_[pos_] << ")";
+    } else {
+        os << " (end of input)";
+    }
+    os << ": " << message;
+    throw std::runtime_error(os.str());
+}
+
+inline Expression Compile(const std::string& input) {
+    const std::vector<Token> tokens = Tokenizer().Tokenize(input);
+    return Parser(tokens).Parse();
+}
+
+#endif  // PARSER_H
@@ -1,10 +1,17 @@
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
 
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <variant>
-#include <unordered_map>
+#include "cpu_features.h"
 
 // отличие от java объекты в c++ не наследуют класс object, и соотвественно метода toString() нет у классов
 // в связи с этим репликации как таковой нет, это означает, что для каждой структуры пришлость опрядлять оператор <<
@@ -51,15 +58,19 @@ struct NumberToken {
     int value;
     friend std::ostream& operator<<(std::ostream& os, const NumberToken& token) { return os << "NumberToken " << token.value; }
 };
+struct VariableToken {
+    std::string name;
+    friend std::ostream& operator<<(std::ostream& os, const VariableToken& token) { return os << "VariableToken " << token.name; }
+};
 struct UnknownToken {
     std::string value;
     friend std::ostream& operator<<(std::ostream& os, const UnknownToken& token) { return os << "UnknownToken "<< token.value; }
 };
 
 using Token = std::variant<OpeningBracketToken, ClosingBracketToken, CommaToken, MinToken, MaxToken, AbsToken, SqrToken,
-    PlusToken, MinusToken, MultiplyToken, ModuloToken, DivideToken, NumberToken, UnknownToken>;
+    PlusToken, MinusToken, MultiplyToken, ModuloToken, DivideToken, NumberToken, VariableToken, UnknownToken>;
 
-std::ostream& operator<<(std::ostream& os, const Token& token) {
+inline std::ostream& operator<<(std::ostream& os, const Token& token) {
     std::visit([&os](const auto& t) { os << t; }, token);
     return os;
 }
@@ -67,120 +78,364 @@ std::ostream& operator<<(std::ostream& os, const Token& token) {
 // так как в задании явно не сказано, что токенайзер должен обрабатывать неправильный ввод, 
 // то обязанность обработки ошибочного ввода, будет передана парсеру
 
-// поскольку калькулятор будет работать в цикле то, лучшим решением будет объявить 
-// symbol2Token и func2Token статичными приватными полями класса Tokenizer, чтобы не было накладных расходов
+// =============================================================================
 
-// единственным доступным методом Tokenizer является Tokenize, поскольку от него больше ничего не требуется
-// методы ToDigit, ParseNumber, ParseName объявлены приватными, поскольку к достпуному функционалу не имеют причастия
+// потоковый разбор: TokenStream принимает std::string_view и выдает токены по одному через Next или итератор,
+// не строя вектор; имена переменных и неизвестный текст в нем - VariableTokenView и UnknownTokenView, то есть участки
+// исходной строки, а не копии, поэтому разбор любой длины ничего не выделяет; исходная строка должна жить,
+// пока используются такие токены
+// ToToken превращает TokenView в обычный Token с копией текста, на этом построен Tokenizer::Tokenize
 
-class Tokenizer {
-public:
-    Tokenizer() {};
+struct VariableTokenView {
+    std::string_view name;
+    friend std::ostream& operator<<(std::ostream& os, const VariableTokenView& token) { return os << "VariableToken " << token.name; }
+};
 
-    std::vector<Token> Tokenize(const std::string& input);
+struct UnknownTokenView {
+    std::string_view value;
+    friend std::ostream& operator<<(std::ostream& os, const UnknownTokenView& token) { return os << "UnknownToken " << token.value; }
+};
 
-private:
-    static const std::unordered_map<char, Token> symbol2Token;
-    static const std::unordered_map<std::string, Token> func2Token;
-    int ToDigit(unsigned char symbol);
-    NumberToken ParseNumber(const std::string& input, size_t& pos);
-    Token ParseName(const std::string& input, size_t& pos);
-};
-
-const std::unordered_map<char, Token> Tokenizer::symbol2Token {
-    {'+', PlusToken{}},
-    {'-', MinusToken{}},
-    {'*', MultiplyToken{}},
-    {'/', DivideToken{}},
-    {'%', ModuloToken{}},
-    {'(', OpeningBracketToken{}},
-    {')', ClosingBracketToken{}},
-    {',', CommaToken{}}
-};
-
-const std::unordered_map<std::string, Token> Tokenizer::func2Token {
-    {"abs", AbsToken{}},
-    {"min", MinToken{}},
-    {"max", MaxToken{}},
-    {"sqr", SqrToken{}}
-};
-
-
-// принимает символ в качестве аргумента и возвращает соответствующее числовое значение
-int Tokenizer::ToDigit(unsigned char symbol) {
-    return symbol - '0';
-}
-
-// принимает в качестве аргумента исходную строку и позицию в ней
-// возвращает NumberToken, содержащий число
-// число определяется циклом в котором происходит перемещение по символам
-NumberToken Tokenizer::ParseNumber(const std::string& input, size_t& pos) {
-    int value = 0;
-    auto symbol = static_cast<unsigned char>(input[pos]);
-    
-    while (std::isdigit(symbol)) {
-        value = value * 10 + ToDigit(symbol);
-        if (pos == input.size() - 1) {
-            ++pos;
-            break;
+using TokenView = std::variant<OpeningBracketToken, ClosingBracketToken, CommaToken, MinToken, MaxToken, AbsToken, SqrToken,
+    PlusToken, MinusToken, MultiplyToken, ModuloToken, DivideToken, NumberToken, VariableTokenView, UnknownTokenView>;
+
+inline std::ostream& operator<<(std::ostream& os, const TokenView& token) {
+    std::visit([&os](const auto& t) { os << t; }, token);
+    return os;
+}
+
+inline Token ToToken(const TokenView& token) {
+    return std::visit([](const auto& t) -> Token {
+        using View = std::decay_t<decltype(t)>;
+        if constexpr (std::is_same_v<View, VariableTokenView>) {
+            return VariableToken{std::string(t.name)};
+        } else if constexpr (std::is_same_v<View, UnknownTokenView>) {
+            return UnknownToken{std::string(t.value)};
+        } else {
+            return t;
+        }
+    }, token);
+}
+
+// =============================================================================
+
+// ядро разбора не зовет std::isspace, std::isdigit и std::isalpha: они зависят от локали и вызываются на каждый символ
+// вместо них класс символа берется из таблицы на 256 байт, построенной при компиляции по правилам локали "C"
+// (пробелы - ' ' и \t \n \v \f \r, буквы - только латиница, байты от 128 - прочие символы)
+// у символов-операторов в таблице хранится номер их токена в kSymbolTokens, так что поиска по словарю тоже нет
+
+enum CharClass : unsigned char {
+    kOtherChar,
+    kSpaceChar,
+    kDigitChar,
+    kAlphaChar,
+    kSymbolChar
+};
+
+struct CharInfo {
+    CharClass cls;
+    unsigned char symbol;
+};
+
+inline constexpr std::string_view kSymbolChars = "+-*/%(),";
+inline constexpr TokenView kSymbolTokens[] = {PlusToken{}, MinusToken{}, MultiplyToken{}, DivideToken{}, ModuloToken{},
+                                              OpeningBracketToken{}, ClosingBracketToken{}, CommaToken{}};
+
+constexpr std::array<CharInfo, 256> MakeCharTable() {
+    std::array<CharInfo, 256> table{};
+    for (size_t c = 0; c < table.size(); ++c) {
+        table[c] = CharInfo{kOtherChar, 0};
+        if (c == ' ' || (c >= '\t' && c <= '\r')) {
+            table[c].cls = kSpaceChar;
+        } else if (c >= '0' && c <= '9') {
+            table[c].cls = kDigitChar;
+        } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+            table[c].cls = kAlphaChar;
         }
-        symbol = static_cast<unsigned char>(input[++pos]);
     }
+    for (size_t i = 0; i < kSymbolChars.size(); ++i) {
+        table[static_cast<unsigned char>(kSymbolChars[i])] = CharInfo{kSymbolChar, static_cast<unsigned char>(i)};
+    }
+    return table;
+}
+
+inline constexpr std::array<CharInfo, 256> kCharTable = MakeCharTable();
 
-    return NumberToken{value};
+// имена функций ищутся по совершенному хешу: позиция в таблице из kFuncSlots ячеек считается по первому и последнему
+// символу и длине имени с множителем kFuncSeed, который подбирается при компиляции так, чтобы имена не совпали
+// по ячейкам; поиск - одно вычисление хеша и одно сравнение, без построения строки
+// чтобы добавить функцию, достаточно дописать ее имя в kFuncNames и токен в kFuncTokens на то же место
+
+inline constexpr std::string_view kFuncNames[] = {"abs", "min", "max", "sqr"};
+inline constexpr TokenView kFuncTokens[] = {AbsToken{}, MinToken{}, MaxToken{}, SqrToken{}};
+inline constexpr size_t kFuncSlots = 8;
+inline constexpr unsigned char kNoFunc = 0xFF;
+
+constexpr size_t FuncHash(std::string_view name, unsigned seed) {
+    return (static_cast<unsigned char>(name.front()) * seed + static_cast<unsigned char>(name.back()) + name.size()) % kFuncSlots;
+}
+
+// наименьший множитель, при котором все имена попадают в разные ячейки, или 0, если такого нет
+constexpr unsigned FindFuncSeed() {
+    for (unsigned seed = 1; seed < 256; ++seed) {
+        bool used[kFuncSlots] = {};
+        bool perfect = true;
+        for (std::string_view name : kFuncNames) {
+            const size_t slot = FuncHash(name, seed);
+            perfect = perfect && !used[slot];
+            used[slot] = true;
+        }
+        if (perfect) {
+            return seed;
+        }
+    }
+    return 0;
 }
 
-// принимает в качестве аргумента исходную строку и позицию в ней
-// возвращает Token, представляющий имя функции или неизвестный токен
-// пока текущая позиция является символом, он добавляет его к строке str
-// токен опредляется циклом в котором str, является либо элементом func2Token, либо не является
-Token Tokenizer::ParseName(const std::string& input, size_t& pos) {
-    auto symbol = input[pos];
-    std::string str;
+inline constexpr unsigned kFuncSeed = FindFuncSeed();
+static_assert(kFuncSeed != 0, "function names need a larger kFuncSlots");
+
+// в ячейке - номер имени в kFuncNames или kNoFunc
+constexpr std::array<unsigned char, kFuncSlots> MakeFuncTable() {
+    std::array<unsigned char, kFuncSlots> table{};
+    for (unsigned char& slot : table) {
+        slot = kNoFunc;
+    }
+    for (size_t i = 0; i < std::size(kFuncNames); ++i) {
+        table[FuncHash(kFuncNames[i], kFuncSeed)] = static_cast<unsigned char>(i);
+    }
+    return table;
+}
+
+inline constexpr std::array<unsigned char, kFuncSlots> kFuncTable = MakeFuncTable();
+
+// =============================================================================
+
+// длинные серии пробелов, цифр и букв проходятся по 16 байт (SSE2) или по 32 байта (AVX2, если процессор его умеет,
+// проверяется один раз при первом вызове): сравнение с диапазоном делается вычитанием нижней границы и беззнаковым
+// сравнением через min, а конец серии - первый нулевой бит маски movemask
+// обычно серии короткие (числа и имена в несколько символов, одиночные пробелы), поэтому первые kScalarRun символов
+// проверяются по таблице и до векторного пути доходят только длинные серии; вектор не читает за концом входа
 
-    while (std::isalpha(symbol)) {
-        str.push_back(symbol);
-        if (pos == input.size() - 1) {
-            ++pos;
-            break;
+inline constexpr size_t kScalarRun = 8;
+
+#ifdef CALCULATOR_SIMD
+
+// байты x из диапазона [low, low + width]
+inline __m128i InRange16(__m128i x, char low, char width) {
+    const __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(width)), shifted);
+}
+
+__attribute__((target("avx2"))) inline __m256i InRange32(__m256i x, char low, char width) {
+    const __m256i shifted = _mm256_sub_epi8(x, _mm256_set1_epi8(low));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(width)), shifted);
+}
+
+template <CharClass Class>
+inline __m128i ClassMask16(__m128i bytes) {
+    if constexpr (Class == kSpaceChar) {
+        return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), InRange16(bytes, '\t', '\r' - '\t'));
+    } else if constexpr (Class == kDigitChar) {
+        return InRange16(bytes, '0', 9);
+    } else {
+        return InRange16(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), 'a', 'z' - 'a');
+    }
+}
+
+template <CharClass Class>
+__attribute__((target("avx2"))) inline __m256i ClassMask32(__m256i bytes) {
+    if constexpr (Class == kSpaceChar) {
+        return _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), InRange32(bytes, '\t', '\r' - '\t'));
+    } else if constexpr (Class == kDigitChar) {
+        return InRange32(bytes, '0', 9);
+    } else {
+        return InRange32(_mm256_or_si256(bytes, _mm256_set1_epi8(0x20)), 'a', 'z' - 'a');
+    }
+}
+
+template <CharClass Class>
+inline size_t SkipRunSse2(const char* data, size_t pos, size_t size) {
+    while (pos + 16 <= size) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(ClassMask16<Class>(bytes)));
+        if (mask != 0xFFFF) {
+            return pos + static_cast<size_t>(__builtin_ctz(~mask));
         }
-        symbol = input[++pos];
+        pos += 16;
     }
+    return pos;
+}
 
-    if (auto it = func2Token.find(str); it != func2Token.end()) {
-        return it->second;
+template <CharClass Class>
+__attribute__((target("avx2"))) inline size_t SkipRunAvx2(const char* data, size_t pos, size_t size) {
+    while (pos + 32 <= size) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(ClassMask32<Class>(bytes)));
+        if (mask != 0xFFFFFFFFu) {
+            return pos + static_cast<size_t>(__builtin_ctz(~mask));
+        }
+        pos += 32;
     }
+    return SkipRunSse2<Class>(data, pos, size);
+}
 
-    if (str.empty()) {
+#endif  // CALCULATOR_SIMD
+
+// возвращает позицию первого символа не из класса Class, начиная с pos
+template <CharClass Class>
+inline size_t SkipRun(const char* data, size_t pos, size_t size) {
+    for (size_t i = 0; i < kScalarRun; ++i, ++pos) {
+        if (pos == size || kCharTable[static_cast<unsigned char>(data[pos])].cls != Class) {
+            return pos;
+        }
+    }
+#ifdef CALCULATOR_SIMD
+    pos = HasAvx2() ? SkipRunAvx2<Class>(data, pos, size) : SkipRunSse2<Class>(data, pos, size);
+#endif
+    while (pos < size && kCharTable[static_cast<unsigned char>(data[pos])].cls == Class) {
         ++pos;
-        str.push_back(symbol);
     }
+    return pos;
+}
+
+// =============================================================================
+
+// Position - смещение первого еще не прочитанного символа, по нему можно указать место ошибки во входе
+// TokenStart - смещение начала токена, который последним вернул Next, так что текст токена - [TokenStart, Position)
+
+class TokenStream {
+public:
+    class Iterator;
+
+    explicit TokenStream(std::string_view input) : input_(input), pos_(0), token_start_(0) {}
+
+    std::optional<TokenView> Next();
+    size_t Position() const { return pos_; }
+    size_t TokenStart() const { return token_start_; }
+
+    Iterator begin();
+    Iterator end();
+
+private:
+    static std::optional<TokenView> FuncToken(std::string_view name);
+    NumberToken ParseNumber();
+    TokenView ParseName();
+
+    std::string_view input_;
+    size_t pos_;
+    size_t token_start_;
+};
+
+// однопроходный итератор: хранит текущий токен, ++ читает следующий, по концу входа становится равным end()
+class TokenStream::Iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = TokenView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const TokenView*;
+    using reference = const TokenView&;
+
+    Iterator() : stream_(nullptr) {}
+    explicit Iterator(TokenStream* stream) : stream_(stream) { ++*this; }
+
+    reference operator*() const { return *token_; }
+    pointer operator->() const { return &*token_; }
+    Iterator& operator++() {
+        token_ = stream_->Next();
+        if (!token_) {
+            stream_ = nullptr;
+        }
+        return *this;
+    }
+    bool operator==(const Iterator& other) const { return stream_ == other.stream_; }
+    bool operator!=(const Iterator& other) const { return stream_ != other.stream_; }
+
+private:
+    TokenStream* stream_;
+    std::optional<TokenView> token_;
+};
+
+inline TokenStream::Iterator TokenStream::begin() {
+    return Iterator(this);
+}
+
+inline TokenStream::Iterator TokenStream::end() {
+    return Iterator();
+}
+
+// пропускает пробелы и возвращает следующий токен или nullopt, если вход закончился
+// символ, который не начинает ни один токен, становится неизвестным токеном из одного этого символа
+inline std::optional<TokenView> TokenStream::Next() {
+    pos_ = SkipRun<kSpaceChar>(input_.data(), pos_, input_.size());
+    token_start_ = pos_;
+    if (pos_ == input_.size()) {
+        return std::nullopt;
+    }
+    const CharInfo info = kCharTable[static_cast<unsigned char>(input_[pos_])];
+    switch (info.cls) {
+    case kDigitChar:
+        return ParseNumber();
+    case kAlphaChar:
+        return ParseName();
+    case kSymbolChar:
+        ++pos_;
+        return kSymbolTokens[info.symbol];
+    default:
+        ++pos_;
+        return UnknownTokenView{input_.substr(pos_ - 1, 1)};
+    }
+}
+
+inline std::optional<TokenView> TokenStream::FuncToken(std::string_view name) {
+    const unsigned char index = kFuncTable[FuncHash(name, kFuncSeed)];
+    if (index != kNoFunc && kFuncNames[index] == name) {
+        return kFuncTokens[index];
+    }
+    return std::nullopt;
+}
 
-    return UnknownToken{str};
+// число собирается в беззнаковом типе: при переполнении int значение переходит через ноль, как и раньше, но без UB
+inline NumberToken TokenStream::ParseNumber() {
+    const size_t end = SkipRun<kDigitChar>(input_.data(), pos_, input_.size());
+    unsigned value = 0;
+    for (; pos_ < end; ++pos_) {
+        value = value * 10 + static_cast<unsigned>(input_[pos_] - '0');
+    }
+    return NumberToken{static_cast<int>(value)};
+}
+
+// последовательность букв - функция или имя переменной
+inline TokenView TokenStream::ParseName() {
+    const size_t start = pos_;
+    pos_ = SkipRun<kAlphaChar>(input_.data(), pos_, input_.size());
+    const std::string_view name = input_.substr(start, pos_ - start);
+    if (auto token = FuncToken(name)) {
+        return *token;
+    }
+    return VariableTokenView{name};
 }
 
+// =============================================================================
+
+// единственным доступным методом Tokenizer является Tokenize, поскольку от него больше ничего не требуется
+// раньше у Tokenizer было собственное ядро со словарями symbol2Token и func2Token, теперь Tokenize собирает
+// в вектор токены TokenStream, копируя имена переменных и текст неизвестных токенов, так что оба способа разбора дают одно и то же
+
+class Tokenizer {
+public:
+    Tokenizer() {};
+
+    std::vector<Token> Tokenize(const std::string& input);
+};
+
 // принимает в качестве аргумента исходную строку
 // возвращает вектор токенов, полученных из строки
-// вектор заполняется перемещением по каждому символу строки, анализируя соотвестующими методами
-std::vector<Token> Tokenizer::Tokenize(const std::string& input) {
+inline std::vector<Token> Tokenizer::Tokenize(const std::string& input) {
     std::vector<Token> tokens;
-    const size_t size = input.size();
-    size_t pos = 0;
-
-    while (pos < size) {
-        const auto symbol = static_cast<unsigned char>(input[pos]);
-        if (std::isspace(symbol)) {
-            ++pos;
-        } else if (std::isdigit(symbol)) {
-            tokens.emplace_back(ParseNumber(input, pos));
-        } else if (auto it = symbol2Token.find(symbol); it != symbol2Token.end()) {
-            tokens.emplace_back(it->second);
-            ++pos;
-        } else {
-            tokens.emplace_back(ParseName(input, pos));
-        }
+    for (const TokenView& token : TokenStream(input)) {
+        tokens.push_back(ToToken(token));
     }
-
     return tokens;
 }
 
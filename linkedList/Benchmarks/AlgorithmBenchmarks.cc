@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../src/linked_list.h"
+
+// sort на узлах LinkedList против копирования в вектор, std::stable_sort и сборки нового списка
+
+static LinkedList<int> MakeShuffled(int size) {
+    std::mt19937 gen(42);
+    LinkedList<int> list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(static_cast<int>(gen()));
+    }
+    return list;
+}
+
+static void BM_SortNodes(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        LinkedList<int> list = MakeShuffled(size);
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_SortViaVector(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        LinkedList<int> list = MakeShuffled(size);
+        state.ResumeTiming();
+        std::vector<int> values;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            values.push_back(*it);
+        }
+        std::stable_sort(values.begin(), values.end());
+        LinkedList<int> sorted;
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            sorted.push_front(*it);
+        }
+        list = std::move(sorted);
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_Reverse(benchmark::State& state) {
+    LinkedList<int> list = MakeShuffled(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        list.reverse();
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SortNodes)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SortViaVector)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Reverse)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
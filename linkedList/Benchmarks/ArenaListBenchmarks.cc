@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include "../src/arena_list.h"
+#include "../src/linked_list.h"
+
+// память на элемент и скорость обхода ArenaList<int> против LinkedList<int>
+// bytes_per_element считается по памяти, которую контейнер взял у аллокатора, включая незанятые ячейки
+
+static double BytesPerElement(const LinkedList<int>& list, int size) {
+    return static_cast<double>(list.get_allocator().pool().bytes_reserved()) / size;
+}
+
+static double BytesPerElement(const ArenaList<int>& list, int size) {
+    return static_cast<double>(list.memory_bytes()) / size;
+}
+
+template <class List>
+static void Traverse(benchmark::State& state, const List& list, int size) {
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["bytes_per_element"] = BytesPerElement(list, size);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class List>
+static void BM_ArenaTraverse(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    Traverse(state, list, size);
+}
+
+// после compact() обход идет по возрастанию адресов, до него - по убыванию, в порядке вставки
+static void BM_ArenaTraverseCompacted(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    ArenaList<int> list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    list.compact();
+    Traverse(state, list, size);
+}
+
+BENCHMARK_TEMPLATE(BM_ArenaTraverse, LinkedList<int>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_ArenaTraverse, ArenaList<int>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ArenaTraverseCompacted)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "../src/concurrent_list.h"
+#include "../src/linked_list.h"
+#include <mutex>
+
+// масштабирование push_front/pop_front по числу потоков:
+// ConcurrentList против LinkedList, каждая операция которого защищена мьютексом
+
+static ConcurrentList<int> concurrent_list;
+
+static void BM_ConcurrentPushPop(benchmark::State& state) {
+    for (auto _ : state) {
+        concurrent_list.push_front(1);
+        benchmark::DoNotOptimize(concurrent_list.pop_front());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+static std::mutex list_mutex;
+static LinkedList<int, std::allocator<int>> locked_list;
+
+static void BM_MutexPushPop(benchmark::State& state) {
+    for (auto _ : state) {
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            locked_list.push_front(1);
+        }
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            if (!locked_list.empty()) {
+                benchmark::DoNotOptimize(locked_list.front());
+                locked_list.pop_front();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// половина потоков читает список через contains, пока остальные меняют его голову
+static void BM_ConcurrentContainsUnderChurn(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        for (int i = 0; i < 1024; ++i) {
+            concurrent_list.push_front(i);
+        }
+    }
+    for (auto _ : state) {
+        if (state.thread_index() % 2 == 0) {
+            concurrent_list.push_front(-1);
+            benchmark::DoNotOptimize(concurrent_list.pop_front());
+        } else {
+            benchmark::DoNotOptimize(concurrent_list.contains(512));
+        }
+    }
+    if (state.thread_index() == 0) {
+        while (concurrent_list.pop_front()) {
+        }
+    }
+}
+
+BENCHMARK(BM_ConcurrentPushPop)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_MutexPushPop)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ConcurrentContainsUnderChurn)->ThreadRange(2, 16)->UseRealTime();
@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <vector>
+#include "../src/linked_list.h"
+
+// сравнение LinkedList со стандартными контейнерами: forward_list, list, vector, deque
+// операции: вставка и удаление на дешевом конце при постоянном размере, копирование, обход, поиск
+// существующего (из середины) и отсутствующего значения, уничтожение
+// размеры от 10 до 10M для int и до 1M для структур в 64 и 256 байт, чтобы 10M больших элементов не занимали гигабайты
+// у vector дешевый конец - back, у остальных - front
+// результаты удобно сохранять в JSON целью make bench-json и сравнивать между коммитами
+
+template <std::size_t Bytes>
+struct Payload {
+    int key;
+    char padding[Bytes - sizeof(int)];
+
+    Payload(int key = 0) : key(key), padding() {}
+    bool operator==(const Payload& other) const { return key == other.key; }
+};
+
+static int Key(int value) {
+    return value;
+}
+
+template <std::size_t Bytes>
+static int Key(const Payload<Bytes>& value) {
+    return value.key;
+}
+
+// =============================================================================
+
+template <class C, class T>
+static void Fill(C& container, const std::vector<T>& source) {
+    container = C(source.begin(), source.end());
+}
+
+template <class T>
+static void Fill(LinkedList<T>& list, const std::vector<T>& source) {
+    list.append(source.begin(), source.end());
+}
+
+template <class C>
+static void Make(C& container, std::size_t size) {
+    using T = typename C::value_type;
+    std::vector<T> source;
+    source.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        source.emplace_back(static_cast<int>(i));
+    }
+    Fill(container, source);
+}
+
+template <class C, class T>
+static void PushCheap(C& container, const T& value) {
+    container.push_front(value);
+}
+
+template <class T>
+static void PushCheap(std::vector<T>& vector, const T& value) {
+    vector.push_back(value);
+}
+
+template <class C>
+static void PopCheap(C& container) {
+    container.pop_front();
+}
+
+template <class T>
+static void PopCheap(std::vector<T>& vector) {
+    vector.pop_back();
+}
+
+template <class C, class T>
+static bool Contains(const C& container, const T& value) {
+    return std::find(container.cbegin(), container.cend(), value) != container.cend();
+}
+
+template <class T>
+static bool Contains(const LinkedList<T>& list, const T& value) {
+    return list.find(value) != list.cend();
+}
+
+// =============================================================================
+
+template <class C>
+static void BM_CompareChurn(benchmark::State& state) {
+    using T = typename C::value_type;
+    C container;
+    Make(container, static_cast<std::size_t>(state.range(0)));
+    const T value(1);
+    for (auto _ : state) {
+        PushCheap(container, value);
+        PopCheap(container);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class C>
+static void BM_CompareCopy(benchmark::State& state) {
+    C container;
+    Make(container, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        C copy(container);
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class C>
+static void BM_CompareTraverse(benchmark::State& state) {
+    C container;
+    Make(container, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto it = container.cbegin(); it != container.cend(); ++it) {
+            sum += Key(*it);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long long>(sizeof(typename C::value_type)));
+}
+
+template <class C>
+static void BM_CompareFindHit(benchmark::State& state) {
+    using T = typename C::value_type;
+    C container;
+    Make(container, static_cast<std::size_t>(state.range(0)));
+    const T value(static_cast<int>(state.range(0) / 2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Contains(container, value));
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) / 2 + 1));
+}
+
+template <class C>
+static void BM_CompareFindMiss(benchmark::State& state) {
+    using T = typename C::value_type;
+    C container;
+    Make(container, static_cast<std::size_t>(state.range(0)));
+    const T value(-1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Contains(container, value));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// уничтожение замеряется вручную: за итерацию строится пачка контейнеров примерно на 64K элементов, чтобы маленькие
+// размеры не тонули в погрешности часов; время итерации - уничтожение всей пачки, сравнивать размеры удобнее по items/s
+template <class C>
+static void BM_CompareDestroy(benchmark::State& state) {
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const std::size_t batch = std::max<std::size_t>(1, (1 << 16) / size);
+    for (auto _ : state) {
+        std::vector<C> containers(batch);
+        for (C& container : containers) {
+            Make(container, size);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        containers.clear();
+        const auto finish = std::chrono::steady_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(finish - start).count());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(batch) * state.range(0));
+    state.counters["containers"] = static_cast<double>(batch);
+}
+
+// =============================================================================
+
+static void IntSizes(benchmark::internal::Benchmark* benchmark) {
+    for (long long size : {10LL, 1000LL, 100000LL, 10000000LL}) {
+        benchmark->Arg(size);
+    }
+}
+
+static void PayloadSizes(benchmark::internal::Benchmark* benchmark) {
+    for (long long size : {10LL, 1000LL, 100000LL, 1000000LL}) {
+        benchmark->Arg(size);
+    }
+}
+
+template <void (*Sizes)(benchmark::internal::Benchmark*)>
+static void WithManualTime(benchmark::internal::Benchmark* benchmark) {
+    Sizes(benchmark);
+    benchmark->UseManualTime();
+}
+
+#define COMPARE_CONTAINERS(function, T, sizes)                                   \
+    BENCHMARK_TEMPLATE(function, LinkedList<T>)->Apply(sizes);                   \
+    BENCHMARK_TEMPLATE(function, std::forward_list<T>)->Apply(sizes);            \
+    BENCHMARK_TEMPLATE(function, std::list<T>)->Apply(sizes);                    \
+    BENCHMARK_TEMPLATE(function, std::vector<T>)->Apply(sizes);                  \
+    BENCHMARK_TEMPLATE(function, std::deque<T>)->Apply(sizes)
+
+#define COMPARE_ALL(T, sizes)                                                    \
+    COMPARE_CONTAINERS(BM_CompareChurn, T, sizes);                               \
+    COMPARE_CONTAINERS(BM_CompareCopy, T, sizes);                                \
+    COMPARE_CONTAINERS(BM_CompareTraverse, T, sizes);                            \
+    COMPARE_CONTAINERS(BM_CompareFindHit, T, sizes);                             \
+    COMPARE_CONTAINERS(BM_CompareFindMiss, T, sizes);                            \
+    COMPARE_CONTAINERS(BM_CompareDestroy, T, WithManualTime<sizes>)
+
+using Payload64 = Payload<64>;
+using Payload256 = Payload<256>;
+
+COMPARE_ALL(int, IntSizes);
+COMPARE_ALL(Payload64, PayloadSizes);
+COMPARE_ALL(Payload256, PayloadSizes);
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include "../src/indexed_list.h"
+#include "../src/linked_list.h"
+#include <random>
+
+// find случайного существующего значения: хеш-индекс против линейного обхода LinkedList
+// на маленьких списках обход дешевле вычисления хеша, по результатам видно, где проходит граница
+
+template <class List>
+static void BM_FindHit(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    std::minstd_rand random(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*list.find(static_cast<int>(random() % size)));
+    }
+}
+
+// цена поддержки индекса при вставке и удалении
+template <class List>
+static void BM_PushPop(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    int value = 0;
+    for (auto _ : state) {
+        list.push_front(value++ % size);
+        list.pop_front();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_FindHit, LinkedList<int>)->RangeMultiplier(2)->Range(1, 1 << 14);
+BENCHMARK_TEMPLATE(BM_FindHit, IndexedList<int>)->RangeMultiplier(2)->Range(1, 1 << 14);
+BENCHMARK_TEMPLATE(BM_PushPop, LinkedList<int>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_PushPop, IndexedList<int>)->Arg(1 << 10);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../src/intrusive_list.h"
+#include "../src/linked_list.h"
+
+// push/pop на объектах, которые уже лежат в пуле (векторе):
+// LinkedList<Object> копирует объект в новый узел, LinkedList<Object*> выделяет узел под указатель,
+// IntrusiveList только связывает объекты через встроенный крючок
+
+struct Object {
+    long long payload[7];
+    IntrusiveHook<Object> hook;
+};
+
+static void BM_ChurnLinkedListCopy(benchmark::State& state) {
+    std::vector<Object> objects(static_cast<std::size_t>(state.range(0)));
+    LinkedList<Object> list;
+    for (auto _ : state) {
+        for (Object& object : objects) {
+            list.push_front(object);
+        }
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ChurnLinkedListPointer(benchmark::State& state) {
+    std::vector<Object> objects(static_cast<std::size_t>(state.range(0)));
+    LinkedList<Object*> list;
+    for (auto _ : state) {
+        for (Object& object : objects) {
+            list.push_front(&object);
+        }
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ChurnIntrusiveList(benchmark::State& state) {
+    std::vector<Object> objects(static_cast<std::size_t>(state.range(0)));
+    IntrusiveList<Object, &Object::hook> list;
+    for (auto _ : state) {
+        for (Object& object : objects) {
+            list.push_front(object);
+        }
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ChurnLinkedListCopy)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_ChurnLinkedListPointer)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_ChurnIntrusiveList)->Range(1 << 6, 1 << 16);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include "../src/linked_list.h"
+
+// цена статистики: те же операции над LinkedList с NoListStats и с ListStats
+// с NoListStats код должен совпадать с обычным списком, с ListStats добавляется инкремент счетчика на каждый шаг
+
+using PlainList = LinkedList<int, PoolAllocator<int>, NoListStats>;
+using CountedList = LinkedList<int, PoolAllocator<int>, ListStats>;
+
+template <class List>
+static void BM_StatsTraverse(benchmark::State& state) {
+    List list;
+    for (int i = 0; i < state.range(0); ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class List>
+static void BM_StatsFindMiss(benchmark::State& state) {
+    List list;
+    for (int i = 0; i < state.range(0); ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.find(-1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class List>
+static void BM_StatsChurn(benchmark::State& state) {
+    List list;
+    for (int i = 0; i < state.range(0); ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        list.push_front(1);
+        list.pop_front();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_StatsTraverse, PlainList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_StatsTraverse, CountedList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_StatsFindMiss, PlainList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_StatsFindMiss, CountedList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_StatsChurn, PlainList)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_StatsChurn, CountedList)->Arg(1 << 10);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <map>
+#include <string>
+#include "../src/mapped_list.h"
+
+// время старта: открытие сохраненного списка через MappedList против пересборки LinkedList из того же файла
+// файлы создаются один раз на размер и удаляются при выходе, 100M элементов int занимают на диске 1.6 ГБ
+
+class MappedFiles {
+public:
+    ~MappedFiles() {
+        for (const auto& entry : paths_) {
+            std::remove(entry.second.c_str());
+        }
+    }
+
+    const std::string& get(long long size) {
+        auto it = paths_.find(size);
+        if (it != paths_.end()) {
+            return it->second;
+        }
+        const std::string path = "/tmp/mapped_list_bench_" + std::to_string(size);
+        {
+            LinkedList<int> list;
+            for (long long i = 0; i < size; ++i) {
+                list.push_front(static_cast<int>(i));
+            }
+            save_list(list, path);
+        }
+        return paths_.emplace(size, path).first->second;
+    }
+
+private:
+    std::map<long long, std::string> paths_;
+};
+
+static MappedFiles g_files;
+
+static void BM_MappedOpen(benchmark::State& state) {
+    const std::string& path = g_files.get(state.range(0));
+    for (auto _ : state) {
+        MappedList<int> mapped(path);
+        benchmark::DoNotOptimize(mapped.front());
+    }
+}
+
+// открытие и поиск последнего элемента, то есть полный проход по отображенному файлу
+static void BM_MappedOpenAndFind(benchmark::State& state) {
+    const std::string& path = g_files.get(state.range(0));
+    for (auto _ : state) {
+        MappedList<int> mapped(path);
+        benchmark::DoNotOptimize(mapped.find(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// то, что приходится делать без MappedList: прочитать все элементы и собрать из них список в памяти
+static void BM_RebuildFromFile(benchmark::State& state) {
+    const std::string& path = g_files.get(state.range(0));
+    for (auto _ : state) {
+        MappedList<int> mapped(path);
+        LinkedList<int> list;
+        auto tail = list.before_begin();
+        for (auto it = mapped.cbegin(); it != mapped.cend(); ++it) {
+            tail = list.insert_after(tail, *it);
+        }
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MappedOpen)->Arg(1 << 10)->Arg(1 << 20)->Arg(100000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MappedOpenAndFind)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RebuildFromFile)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24)->Unit(benchmark::kMicrosecond);
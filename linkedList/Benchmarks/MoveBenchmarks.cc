@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "../src/linked_list.h"
+
+// вставка больших std::string и std::vector копией и перемещением
+// Counted считает копирования полезной нагрузки, счетчик copies показывает их число на одну операцию
+
+static long long g_copies = 0;
+
+template <class Payload>
+struct Counted {
+    Payload payload;
+
+    explicit Counted(Payload payload) : payload(std::move(payload)) {}
+    Counted(const Counted& other) : payload(other.payload) { ++g_copies; }
+    Counted(Counted&& other) noexcept = default;
+    Counted& operator=(const Counted& other) { payload = other.payload; ++g_copies; return *this; }
+    Counted& operator=(Counted&& other) noexcept = default;
+};
+
+static std::string MakePayload(std::string*, int bytes) {
+    return std::string(static_cast<std::size_t>(bytes), 'x');
+}
+
+static std::vector<int> MakePayload(std::vector<int>*, int bytes) {
+    return std::vector<int>(static_cast<std::size_t>(bytes) / sizeof(int), 1);
+}
+
+template <class Payload>
+static void BM_PushFrontCopy(benchmark::State& state) {
+    Counted<Payload> value(MakePayload(static_cast<Payload*>(nullptr), static_cast<int>(state.range(0))));
+    LinkedList<Counted<Payload>> list;
+    g_copies = 0;
+    for (auto _ : state) {
+        list.push_front(value);
+        benchmark::DoNotOptimize(list.front().payload.data());
+        list.pop_front();
+    }
+    state.counters["copies"] = benchmark::Counter(static_cast<double>(g_copies), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// элемент перемещается в список и обратно через take_front, буфер ни разу не копируется
+template <class Payload>
+static void BM_PushFrontMove(benchmark::State& state) {
+    Counted<Payload> value(MakePayload(static_cast<Payload*>(nullptr), static_cast<int>(state.range(0))));
+    LinkedList<Counted<Payload>> list;
+    g_copies = 0;
+    for (auto _ : state) {
+        list.push_front(std::move(value));
+        benchmark::DoNotOptimize(list.front().payload.data());
+        value = list.take_front();
+    }
+    state.counters["copies"] = benchmark::Counter(static_cast<double>(g_copies), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_PushFrontCopy, std::string)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushFrontMove, std::string)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushFrontCopy, std::vector<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushFrontMove, std::vector<int>)->Range(1 << 6, 1 << 20);
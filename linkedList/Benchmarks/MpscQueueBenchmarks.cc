@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../src/linked_list.h"
+#include "../src/mpsc_queue.h"
+
+// передача элементов от N производителей одному потребителю: MpscQueue с pop по одному и с drain пачкой
+// против LinkedList под мьютексом, где потребитель либо забирает по одному, либо подменяет весь список разом
+// элемент - момент вставки, потребитель считает задержку от push до извлечения, счетчик latency_ns - среднее на элемент
+// в замер входит и запуск потоков производителей, на фоне kPerProducer элементов на поток он незаметен
+
+static constexpr int kPerProducer = 1 << 16;
+
+static std::int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// consume забирает сколько может, передает каждый элемент в record и возвращает их число
+template <class Push, class Consume>
+static void RunProducers(benchmark::State& state, Push push, Consume consume) {
+    const int producers = static_cast<int>(state.range(0));
+    const long long total = static_cast<long long>(producers) * kPerProducer;
+    long long latency = 0;
+    auto record = [&latency](std::int64_t stamp) { latency += Now() - stamp; };
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&push] {
+                for (int i = 0; i < kPerProducer; ++i) {
+                    push(Now());
+                }
+            });
+        }
+        for (long long received = 0; received < total;) {
+            const std::size_t taken = consume(record);
+            if (taken == 0) {
+                std::this_thread::yield();
+            }
+            received += static_cast<long long>(taken);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * total);
+    state.counters["latency_ns"] = benchmark::Counter(static_cast<double>(latency) / static_cast<double>(total),
+                                                      benchmark::Counter::kAvgIterations);
+}
+
+static void BM_MpscPop(benchmark::State& state) {
+    MpscQueue<std::int64_t> queue;
+    RunProducers(state, [&queue](std::int64_t stamp) { queue.push(stamp); }, [&queue](auto& record) -> std::size_t {
+        auto stamp = queue.try_pop();
+        if (!stamp) {
+            return 0;
+        }
+        record(*stamp);
+        return 1;
+    });
+}
+
+static void BM_MpscDrain(benchmark::State& state) {
+    MpscQueue<std::int64_t> queue;
+    RunProducers(state, [&queue](std::int64_t stamp) { queue.push(stamp); },
+                 [&queue](auto& record) { return queue.drain(record); });
+}
+
+static void BM_MutexQueuePop(benchmark::State& state) {
+    std::mutex mutex;
+    LinkedList<std::int64_t, std::allocator<std::int64_t>> list;
+    RunProducers(state, [&](std::int64_t stamp) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(stamp);
+    }, [&](auto& record) -> std::size_t {
+        std::int64_t stamp;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (list.empty()) {
+                return 0;
+            }
+            stamp = list.take_front();
+        }
+        record(stamp);
+        return 1;
+    });
+}
+
+// потребитель под мьютексом только забирает узлы списка себе, обход идет уже без блокировки
+static void BM_MutexQueueSwap(benchmark::State& state) {
+    std::mutex mutex;
+    LinkedList<std::int64_t, std::allocator<std::int64_t>> list;
+    RunProducers(state, [&](std::int64_t stamp) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(stamp);
+    }, [&](auto& record) {
+        LinkedList<std::int64_t, std::allocator<std::int64_t>> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch = std::move(list);
+        }
+        const std::size_t taken = batch.size();
+        while (!batch.empty()) {
+            record(batch.take_front());
+        }
+        return taken;
+    });
+}
+
+BENCHMARK(BM_MpscPop)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MpscDrain)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MutexQueuePop)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MutexQueueSwap)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "../src/parallel_list.h"
+
+// масштабирование параллельных алгоритмов над LinkedList: аргумент - concurrency() пула, от 1 до 8
+// список из 4M int строится один раз; Reused-варианты используют разбиение, построенное заранее,
+// остальные строят его при каждом вызове, как перегрузки, принимающие список
+// ForEach вызывает дорогую функцию на элемент, CountIf - дешевый предикат, который упирается в обход памяти
+// FindFirst ищет значение на 3/4 длины, Copy строит копию списка
+// с concurrency 1 все выполняет вызывающий поток одним куском, это последовательная точка отсчета
+
+static constexpr int kListSize = 1 << 22;
+
+static const LinkedList<int>& Source() {
+    static const LinkedList<int> list = [] {
+        LinkedList<int> list;
+        for (int i = 0; i < kListSize; ++i) {
+            list.push_back(i);
+        }
+        return list;
+    }();
+    return list;
+}
+
+static void Heavy(const int& value) {
+    double x = value;
+    for (int i = 0; i < 16; ++i) {
+        x = std::sqrt(x + i);
+    }
+    benchmark::DoNotOptimize(x);
+}
+
+static void BM_ParallelForEach(benchmark::State& state) {
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    const LinkedList<int>& list = Source();
+    for (auto _ : state) {
+        parallel_for_each(pool, list, Heavy);
+    }
+    state.SetItemsProcessed(state.iterations() * kListSize);
+}
+
+static void BM_ParallelCountIf(benchmark::State& state) {
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    const LinkedList<int>& list = Source();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel_count_if(pool, list, [](int value) { return value % 3 == 0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * kListSize);
+}
+
+static void BM_ParallelCountIfReused(benchmark::State& state) {
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    const ListPartition<const LinkedList<int>> partition(Source(), pool);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel_count_if(pool, partition, [](int value) { return value % 3 == 0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * kListSize);
+}
+
+static void BM_ParallelFindFirstReused(benchmark::State& state) {
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    const ListPartition<const LinkedList<int>> partition(Source(), pool);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel_find_first(pool, partition, kListSize / 4 * 3));
+    }
+    state.SetItemsProcessed(state.iterations() * (kListSize / 4 * 3));
+}
+
+static void BM_ParallelCopyReused(benchmark::State& state) {
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    const ListPartition<const LinkedList<int>> partition(Source(), pool);
+    for (auto _ : state) {
+        LinkedList<int> copy = parallel_copy(pool, partition);
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetItemsProcessed(state.iterations() * kListSize);
+}
+
+BENCHMARK(BM_ParallelForEach)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelCountIf)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelCountIfReused)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelFindFirstReused)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelCopyReused)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <memory_resource>
+#include <vector>
+#include "../src/linked_list.h"
+
+// список на время одного запроса: заполнение и уничтожение
+// с monotonic_buffer_resource узлы берутся из заранее выделенного буфера, а уничтожение не обходит список
+
+template <class List>
+static void BM_RequestScoped(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        List list;
+        for (int i = 0; i < size; ++i) {
+            list.push_front(i);
+        }
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_RequestScopedMonotonic(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    std::vector<char> buffer(static_cast<std::size_t>(size) * 32);
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        pmr::LinkedList<int> list(&arena);
+        for (int i = 0; i < size; ++i) {
+            list.push_front(i);
+        }
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_RequestScoped, LinkedList<int, std::allocator<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK_TEMPLATE(BM_RequestScoped, LinkedList<int>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_RequestScopedMonotonic)->Range(1 << 6, 1 << 16);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "../src/linked_list.h"
+
+// сравнение PoolAllocator с выделением каждого узла через std::allocator,
+// что соответствует прежнему пути через std::make_unique
+
+template <class List>
+static void BM_PushFrontDestroy(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        List list;
+        for (int i = 0; i < size; ++i) {
+            list.push_front(i);
+        }
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class List>
+static void BM_PushPopChurn(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    for (auto _ : state) {
+        for (int i = 0; i < 64; ++i) {
+            list.pop_front();
+        }
+        for (int i = 0; i < 64; ++i) {
+            list.push_front(i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 128);
+}
+
+template <class List>
+static void BM_CopyConstruct(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    for (auto _ : state) {
+        List copy(list);
+        benchmark::DoNotOptimize(copy.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// узлы перемешиваются через вставки и удаления, как в долгоживущем списке,
+// затем замеряется поиск отсутствующего значения, то есть полный обход
+template <class List>
+static void BM_FindMiss(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+        if (i % 3 == 0) {
+            list.pop_front();
+        }
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.find(-1) == list.end());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+using PoolList = LinkedList<int>;
+using HeapList = LinkedList<int, std::allocator<int>>;
+
+BENCHMARK_TEMPLATE(BM_PushFrontDestroy, PoolList)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushFrontDestroy, HeapList)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPopChurn, PoolList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PushPopChurn, HeapList)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, PoolList)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, HeapList)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMiss, PoolList)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMiss, HeapList)->Range(1 << 10, 1 << 20);
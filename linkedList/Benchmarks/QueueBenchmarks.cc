@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <vector>
+#include "../src/linked_list.h"
+
+// LinkedList как очередь FIFO: push_back в хвост и pop_front с головы при постоянной глубине очереди
+// и построение списка из диапазона: прежний способ push_front с конца, поштучный push_back и append пачкой
+
+template <class Queue>
+static void BM_Fifo(benchmark::State& state) {
+    Queue queue;
+    for (int i = 0; i < state.range(0); ++i) {
+        queue.push_back(i);
+    }
+    int next = 0;
+    for (auto _ : state) {
+        queue.push_back(next++);
+        benchmark::DoNotOptimize(queue.front());
+        queue.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static std::vector<int> MakeSource(benchmark::State& state) {
+    std::vector<int> source(static_cast<std::size_t>(state.range(0)));
+    std::iota(source.begin(), source.end(), 0);
+    return source;
+}
+
+// сумма проходом по списку: после построения пачкой узлы лежат подряд
+static long long Sum(const LinkedList<int>& list) {
+    long long sum = 0;
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        sum += *it;
+    }
+    return sum;
+}
+
+static void BM_BuildPushFrontReversed(benchmark::State& state) {
+    const std::vector<int> source = MakeSource(state);
+    for (auto _ : state) {
+        LinkedList<int> list;
+        for (auto it = source.rbegin(); it != source.rend(); ++it) {
+            list.push_front(*it);
+        }
+        benchmark::DoNotOptimize(Sum(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BuildPushBack(benchmark::State& state) {
+    const std::vector<int> source = MakeSource(state);
+    for (auto _ : state) {
+        LinkedList<int> list;
+        for (int value : source) {
+            list.push_back(value);
+        }
+        benchmark::DoNotOptimize(Sum(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BuildAppend(benchmark::State& state) {
+    const std::vector<int> source = MakeSource(state);
+    for (auto _ : state) {
+        LinkedList<int> list;
+        list.append(source.begin(), source.end());
+        benchmark::DoNotOptimize(Sum(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// копия строится одной пачкой: узлы берутся у пула копии одним отрезком и лежат подряд
+static void BM_CopyList(benchmark::State& state) {
+    const std::vector<int> source = MakeSource(state);
+    LinkedList<int> list;
+    list.append(source.begin(), source.end());
+    for (auto _ : state) {
+        LinkedList<int> copy(list);
+        benchmark::DoNotOptimize(Sum(copy));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(list.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_Fifo, LinkedList<int>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Fifo, std::deque<int>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Fifo, std::list<int>)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_BuildPushFrontReversed)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BuildPushBack)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BuildAppend)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_CopyList)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../src/linked_list.h"
+#include "../src/list_reclaimer.h"
+
+// задержка запроса, который избавляется от большого списка: время от начала уничтожения до возврата управления
+// PerNode - LinkedList на std::allocator, узлы освобождаются по одному; Batched - PoolAllocator, все узлы уходят
+// в пул одной цепочкой за один проход; Deferred - список отдается ListReclaimer (с ReclaimerPriority::Low) и
+// уничтожается в фоне
+// каждая итерация - один запрос, построение списка и ожидание уборщика в замер не входят
+// счетчики p50_us, p99_us и max_us - перцентили задержки по всем запросам
+
+static constexpr int kRequests = 64;
+
+static std::string Value(const std::string*, int i) {
+    return std::string(8, static_cast<char>('a' + i % 26));
+}
+
+static int Value(const int*, int i) {
+    return i;
+}
+
+template <class List>
+static List Build(std::size_t size) {
+    using T = typename List::value_type;
+    List list;
+    for (std::size_t i = 0; i < size; ++i) {
+        list.push_back(Value(static_cast<const T*>(nullptr), static_cast<int>(i)));
+    }
+    return list;
+}
+
+static void ReportPercentiles(benchmark::State& state, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double fraction) {
+        return samples[std::min(samples.size() - 1, static_cast<std::size_t>(fraction * samples.size()))] * 1e6;
+    };
+    state.counters["p50_us"] = at(0.5);
+    state.counters["p99_us"] = at(0.99);
+    state.counters["max_us"] = samples.back() * 1e6;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// =============================================================================
+
+template <class List>
+static void BM_DropInline(benchmark::State& state) {
+    std::vector<double> samples;
+    for (auto _ : state) {
+        List list = Build<List>(static_cast<std::size_t>(state.range(0)));
+        const auto start = std::chrono::steady_clock::now();
+        list.clear();
+        const auto finish = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(finish - start).count();
+        samples.push_back(seconds);
+        state.SetIterationTime(seconds);
+    }
+    ReportPercentiles(state, samples);
+}
+
+template <class List>
+static void BM_DropDeferred(benchmark::State& state) {
+    ListReclaimer reclaimer(ReclaimerPriority::Low);
+    std::vector<double> samples;
+    for (auto _ : state) {
+        List list = Build<List>(static_cast<std::size_t>(state.range(0)));
+        const auto start = std::chrono::steady_clock::now();
+        reclaimer.retire(std::move(list));
+        const auto finish = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(finish - start).count();
+        samples.push_back(seconds);
+        state.SetIterationTime(seconds);
+        reclaimer.flush();
+    }
+    ReportPercentiles(state, samples);
+}
+
+// =============================================================================
+
+template <class T>
+using PerNode = LinkedList<T, std::allocator<T>>;
+template <class T>
+using Batched = LinkedList<T>;
+
+#define DROP_BENCHMARK(function, List)                                                                      \
+    BENCHMARK_TEMPLATE(function, List)->Arg(1 << 16)->Arg(1 << 20)->Iterations(kRequests)->UseManualTime() \
+        ->Unit(benchmark::kMicrosecond)
+
+DROP_BENCHMARK(BM_DropInline, PerNode<int>);
+DROP_BENCHMARK(BM_DropInline, Batched<int>);
+DROP_BENCHMARK(BM_DropDeferred, Batched<int>);
+DROP_BENCHMARK(BM_DropInline, PerNode<std::string>);
+DROP_BENCHMARK(BM_DropInline, Batched<std::string>);
+DROP_BENCHMARK(BM_DropDeferred, Batched<std::string>);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include "../src/linked_list.h"
+#include "../src/skip_list.h"
+#include <random>
+#include <vector>
+
+// поиск существующих значений в случайном порядке: SkipList против линейного find в LinkedList
+
+static void BM_LinearFind(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    LinkedList<int> list;
+    for (int i = size - 1; i >= 0; --i) {
+        list.push_front(i);
+    }
+    std::mt19937 random(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*list.find(static_cast<int>(random() % size)));
+    }
+}
+
+static void BM_SkipListFind(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    SkipList<int> list;
+    std::mt19937 random(1);
+    for (int i = 0; i < size; ++i) {
+        list.insert(static_cast<int>(random()));
+    }
+    std::vector<int> values;
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        values.push_back(*it);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*list.find(values[random() % size]));
+    }
+}
+
+static void BM_SkipListInsertErase(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    SkipList<int> list;
+    std::mt19937 random(1);
+    for (int i = 0; i < size; ++i) {
+        list.insert(static_cast<int>(random()));
+    }
+    for (auto _ : state) {
+        const int value = static_cast<int>(random());
+        list.insert(value);
+        list.erase(value);
+    }
+}
+
+BENCHMARK(BM_LinearFind)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BM_SkipListFind)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BM_SkipListInsertErase)->RangeMultiplier(10)->Range(1000, 1000000);
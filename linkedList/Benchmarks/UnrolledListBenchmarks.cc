@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include "../src/linked_list.h"
+#include "../src/unrolled_list.h"
+
+// обход и поиск в UnrolledList<int> против LinkedList<int> на больших списках
+// для арифметических T find в UnrolledList сравнивает блоки векторно (simd_search.h)
+
+template <class List>
+static void BM_Traverse(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class List>
+static void BM_FindLast(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    List list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*list.find(0));
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_Traverse, LinkedList<int>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_Traverse, UnrolledList<int>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_FindLast, LinkedList<int>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_FindLast, UnrolledList<int>)->Range(1 << 10, 1 << 22);
+
+// count сравнивает блок векторно, count_if проверяет предикат по блоку без ветвлений
+static void BM_UnrolledCount(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    UnrolledList<int> list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i % 100);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.count(7));
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_UnrolledCountIf(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    UnrolledList<int> list;
+    for (int i = 0; i < size; ++i) {
+        list.push_front(i % 100);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.count_if([](int value) { return value == 7; }));
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_UnrolledCount)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_UnrolledCountIf)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+#include "../src/arena_list.h"
+#include "../src/pool_allocator.h"
+#include <forward_list>
+#include <memory>
+#include <string>
+
+template <class List, class ForwardList>
+static void ExpectSameElements(const List& list, const ForwardList& flist) {
+    auto fit = flist.begin();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++fit) {
+            ASSERT_NE(fit, flist.end());
+            ASSERT_EQ(*it, *fit);
+        }
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+TEST(ArenaListTest, ConstructorDefault) {
+    ArenaList<int> list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0u);
+    ASSERT_EQ(list.memory_bytes(), 0u);
+    ASSERT_THROW(list.front(), std::runtime_error);
+}
+
+TEST(ArenaListTest, PushPopReusesSlots) {
+    ArenaList<int> list;
+    std::forward_list<int> flist;
+    for (int i = 0; i < 100; ++i) {
+        list.push_front(i);
+        flist.push_front(i);
+    }
+    ExpectSameElements(list, flist);
+    const std::size_t capacity = list.capacity();
+    for (int i = 0; i < 60; ++i) {
+        list.pop_front();
+        flist.pop_front();
+    }
+    for (int i = 0; i < 60; ++i) {
+        list.push_front(-i);
+        flist.push_front(-i);
+    }
+    ExpectSameElements(list, flist);
+    ASSERT_EQ(list.size(), 100u);
+    ASSERT_EQ(list.capacity(), capacity);
+}
+
+// вставка собственного элемента ровно в момент роста арены: аргумент ссылается на ячейку старой арены
+TEST(ArenaListTest, SelfInsertionWhenFull) {
+    ArenaList<std::string> list;
+    std::forward_list<std::string> flist;
+    for (int i = 0; i < 16; ++i) {
+        list.push_front(std::string(32, static_cast<char>('a' + i)));
+        flist.push_front(std::string(32, static_cast<char>('a' + i)));
+    }
+    ASSERT_EQ(list.size(), list.capacity());
+    list.push_front(list.front());
+    flist.push_front(flist.front());
+    ExpectSameElements(list, flist);
+    while (list.size() < list.capacity()) {
+        list.push_front(std::string(32, 'x'));
+        flist.push_front(std::string(32, 'x'));
+    }
+    list.emplace_front(list.front(), 1);
+    flist.emplace_front(flist.front(), 1);
+    ExpectSameElements(list, flist);
+}
+
+TEST(ArenaListTest, SlotIsSmallerThanPointerNode) {
+    ArenaList<int> list;
+    list.reserve(1000);
+    ASSERT_EQ(list.memory_bytes(), 1000 * (sizeof(int) + sizeof(std::uint32_t)));
+}
+
+TEST(ArenaListTest, CompactLaysOutInTraversalOrder) {
+    ArenaList<int> list;
+    std::forward_list<int> flist;
+    for (int i = 0; i < 50; ++i) {
+        list.push_front(i);
+        flist.push_front(i);
+        if (i % 3 == 0) {
+            list.pop_front();
+            flist.pop_front();
+        }
+    }
+    const std::size_t capacity = list.capacity();
+    list.compact();
+    ExpectSameElements(list, flist);
+    ASSERT_EQ(list.capacity(), capacity);
+    const int* previous = nullptr;
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        if (previous) {
+            ASSERT_LT(previous, &*it);
+        }
+        previous = &*it;
+    }
+}
+
+TEST(ArenaListTest, CopyAndMove) {
+    ArenaList<std::string> list {"a", "b", "c"};
+    std::forward_list<std::string> flist {"a", "b", "c"};
+    ArenaList<std::string> copy(list);
+    ExpectSameElements(copy, flist);
+    ArenaList<std::string> moved(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ExpectSameElements(moved, flist);
+    list = copy;
+    copy.pop_front();
+    ExpectSameElements(list, flist);
+    list = std::move(moved);
+    ExpectSameElements(list, flist);
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    list.push_front("d");
+    ASSERT_EQ(list.front(), "d");
+}
+
+// аллокатор с общим пулом у копий, но без распространения при перемещении,
+// чтобы перемещающее присваивание пошло по пути поэлементного переноса
+template <class T>
+struct NonPropagatingPool : PoolAllocator<T> {
+    using propagate_on_container_move_assignment = std::false_type;
+
+    template <class U>
+    struct rebind {
+        using other = NonPropagatingPool<U>;
+    };
+
+    NonPropagatingPool() = default;
+    template <class U>
+    NonPropagatingPool(const NonPropagatingPool<U>& other) : PoolAllocator<T>(other) {}
+};
+
+TEST(ArenaListTest, MoveAssignmentWithUnequalAllocators) {
+    ArenaList<std::string, NonPropagatingPool<std::string>> source {"x", "y"};
+    ArenaList<std::string, NonPropagatingPool<std::string>> target;
+    ASSERT_NE(source.get_allocator(), target.get_allocator());
+    target = std::move(source);
+    ExpectSameElements(target, std::forward_list<std::string> {"x", "y"});
+    ASSERT_TRUE(source.empty());
+    ASSERT_NE(source.get_allocator(), target.get_allocator());
+}
+
+TEST(ArenaListTest, Find) {
+    ArenaList<int> list {1, 2, 3, 2};
+    auto it = list.find(2);
+    ASSERT_NE(it, list.end());
+    ++it;
+    ASSERT_EQ(*it, 3);
+    ASSERT_EQ(list.find(7), list.end());
+    const ArenaList<int>& clist = list;
+    ASSERT_EQ(*clist.find(3), 3);
+    ASSERT_EQ(clist.find(7), clist.cend());
+}
+
+TEST(ArenaListTest, MoveOnlyElements) {
+    ArenaList<std::unique_ptr<int>> list;
+    for (int i = 0; i < 40; ++i) {
+        list.emplace_front(new int(i));
+    }
+    list.compact();
+    ASSERT_EQ(*list.front(), 39);
+    list.pop_front();
+    ASSERT_EQ(*list.front(), 38);
+}
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "../src/concurrent_list.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentListTest, SingleThreadStackOrder) {
+    ConcurrentList<int> list;
+    ASSERT_TRUE(list.empty());
+    list.push_front(1);
+    list.push_front(2);
+    list.push_front(3);
+    ASSERT_TRUE(list.contains(2));
+    ASSERT_FALSE(list.contains(4));
+    ASSERT_EQ(list.pop_front(), 3);
+    ASSERT_EQ(list.pop_front(), 2);
+    ASSERT_EQ(list.pop_front(), 1);
+    ASSERT_EQ(list.pop_front(), std::nullopt);
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(ConcurrentListTest, FindIfReturnsFirstMatch) {
+    ConcurrentList<int> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_front(i);
+    }
+    ASSERT_EQ(list.find_if([](int value) { return value % 4 == 0; }), 8);
+    ASSERT_EQ(list.find_if([](int value) { return value > 100; }), std::nullopt);
+}
+
+TEST(ConcurrentListTest, DestructorFreesRemainingNodes) {
+    auto counter = std::make_shared<int>(0);
+    {
+        ConcurrentList<std::shared_ptr<int>> list;
+        for (int i = 0; i < 100; ++i) {
+            list.push_front(counter);
+        }
+        list.pop_front();
+    }
+    EpochDomain::instance().collect();
+    EpochDomain::instance().collect();
+    EpochDomain::instance().collect();
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+// каждый производитель кладет свой диапазон значений, потребители забирают все до конца
+// сумма извлеченных значений должна совпасть с суммой вставленных, ни одно значение не теряется и не дублируется
+TEST(ConcurrentListTest, StressPushPop) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 20000;
+    ConcurrentList<int> list;
+    std::atomic<long long> popped_sum{0};
+    std::atomic<int> popped_count{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&list, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                list.push_front(t * kPerThread + i);
+            }
+        });
+        threads.emplace_back([&] {
+            while (popped_count.load() < kThreads * kPerThread) {
+                if (auto value = list.pop_front()) {
+                    popped_sum += *value;
+                    ++popped_count;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const long long total = static_cast<long long>(kThreads) * kPerThread;
+    ASSERT_EQ(popped_count.load(), total);
+    ASSERT_EQ(popped_sum.load(), total * (total - 1) / 2);
+    ASSERT_TRUE(list.empty());
+}
+
+// читатели обходят список, пока другие потоки извлекают и освобождают узлы
+// под AddressSanitizer любое обращение к освобожденному узлу завершит тест с ошибкой
+TEST(ConcurrentListTest, StressFindDuringPop) {
+    constexpr int kWriters = 2;
+    constexpr int kReaders = 2;
+    constexpr int kRounds = 20000;
+    ConcurrentList<std::unique_ptr<int>*> list;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    static std::unique_ptr<int> sentinel = std::make_unique<int>(0);
+    for (int t = 0; t < kWriters; ++t) {
+        threads.emplace_back([&list] {
+            for (int i = 0; i < kRounds; ++i) {
+                list.push_front(&sentinel);
+                list.push_front(nullptr);
+                list.pop_front();
+                list.pop_front();
+            }
+        });
+    }
+    for (int t = 0; t < kReaders; ++t) {
+        threads.emplace_back([&list, &done] {
+            while (!done.load()) {
+                list.contains(nullptr);
+                list.find_if([](std::unique_ptr<int>* value) { return value && **value != 0; });
+            }
+        });
+    }
+    for (int t = 0; t < kWriters; ++t) {
+        threads[t].join();
+    }
+    done = true;
+    for (int t = kWriters; t < kWriters + kReaders; ++t) {
+        threads[t].join();
+    }
+    ASSERT_TRUE(list.empty());
+}
@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+#include "../src/indexed_list.h"
+#include "../src/linked_list.h"
+#include <forward_list>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+template <class List>
+static void ExpectSameElements(const List& list, const std::forward_list<int>& flist) {
+    auto fit = flist.begin();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++fit) {
+            ASSERT_NE(fit, flist.end());
+            ASSERT_EQ(*it, *fit);
+        }
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+// find должен указывать на тот же элемент, что и линейный поиск, включая случаи с повторами
+static void ExpectSameFind(const IndexedList<int>& list, int value) {
+    auto found = list.find(value);
+    auto scan = list.cend();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            if (*it == value) {
+                scan = it;
+                break;
+            }
+        }
+    }
+    ASSERT_EQ(found, scan);
+}
+
+TEST(IndexedListTest, ConstructorDefault) {
+    IndexedList<int> list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.find(1), list.cend());
+    ASSERT_EQ(list.index_memory(), 0u);
+}
+
+TEST(IndexedListTest, InitializerListAndFind) {
+    IndexedList<int> list {1, 2, 3, 4, 5};
+    ExpectSameElements(list, {1, 2, 3, 4, 5});
+    ASSERT_EQ(*list.find(3), 3);
+    ASSERT_EQ(list.find(6), list.cend());
+    ASSERT_EQ(list.size(), 5u);
+}
+
+TEST(IndexedListTest, DuplicatesFirstMatch) {
+    IndexedList<int> list {7, 1, 7, 2, 7};
+    ASSERT_EQ(list.find(7), list.cbegin());
+    ASSERT_EQ(list.count(7), 3u);
+    list.pop_front();
+    ExpectSameFind(list, 7);
+    list.pop_front();
+    ASSERT_EQ(list.find(7), list.cbegin());
+    ASSERT_EQ(list.count(7), 2u);
+    list.push_front(7);
+    ASSERT_EQ(list.find(7), list.cbegin());
+    ASSERT_EQ(list.count(7), 3u);
+}
+
+TEST(IndexedListTest, RandomChurnMatchesScan) {
+    IndexedList<int> list;
+    std::forward_list<int> flist;
+    std::mt19937 random(7);
+    for (int i = 0; i < 4000; ++i) {
+        if (random() % 3 == 0 && !flist.empty()) {
+            list.pop_front();
+            flist.pop_front();
+        } else {
+            const int value = static_cast<int>(random() % 64);
+            list.push_front(value);
+            flist.push_front(value);
+        }
+    }
+    ExpectSameElements(list, flist);
+    for (int value = 0; value < 70; ++value) {
+        ExpectSameFind(list, value);
+    }
+}
+
+TEST(IndexedListTest, CopyRebuildsIndex) {
+    IndexedList<std::string> list {"a", "b", "a", "c"};
+    IndexedList<std::string> copy(list);
+    list.clear();
+    ASSERT_EQ(copy.find("a"), copy.cbegin());
+    ASSERT_EQ(copy.count("a"), 2u);
+    copy.pop_front();
+    ASSERT_EQ(*copy.find("a"), "a");
+    ASSERT_EQ(copy.count("a"), 1u);
+    ASSERT_EQ(list.find("a"), list.cend());
+    IndexedList<std::string> assigned {"z"};
+    assigned = copy;
+    ASSERT_EQ(assigned.count("a"), 1u);
+    ASSERT_EQ(assigned.find("z"), assigned.cend());
+}
+
+TEST(IndexedListTest, MoveKeepsIndex) {
+    IndexedList<int> list {1, 2, 3};
+    IndexedList<int> move(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.find(1), list.cend());
+    ASSERT_EQ(*move.find(2), 2);
+    list = std::move(move);
+    ASSERT_EQ(*list.find(3), 3);
+    ASSERT_EQ(move.find(3), move.cend());
+    move.push_front(3);
+    ASSERT_EQ(move.find(3), move.cbegin());
+}
+
+TEST(IndexedListTest, LoadFactorIsTunable) {
+    IndexedList<int> list;
+    list.max_load_factor(0.25f);
+    for (int i = 0; i < 100; ++i) {
+        list.push_front(i);
+    }
+    ASSERT_LE(list.load_factor(), 0.25f);
+    const std::size_t sparse = list.index_memory();
+    list.max_load_factor(0.9f);
+    IndexedList<int> dense;
+    dense.max_load_factor(0.9f);
+    for (int i = 0; i < 100; ++i) {
+        dense.push_front(i);
+    }
+    ASSERT_LT(dense.index_memory(), sparse);
+    dense.reserve(1000);
+    ASSERT_GE(dense.bucket_count() * 0.9f, 1000.0f);
+    ASSERT_THROW(dense.max_load_factor(1.0f), std::invalid_argument);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(*dense.find(i), i);
+    }
+}
+
+TEST(IndexedListTest, IndexMemoryCountsNodeLinks) {
+    IndexedList<int> list {1, 2, 3};
+    ASSERT_EQ(list.index_memory(), list.bucket_count() * 2 * sizeof(void*) + 3 * sizeof(void*));
+}
+
+// повторы встают в цепочку равных, поэтому таблица от них не растет
+TEST(IndexedListTest, DuplicatesDoNotGrowTable) {
+    IndexedList<int> list;
+    for (int i = 0; i < 4; ++i) {
+        list.push_front(i);
+    }
+    const std::size_t buckets = list.bucket_count();
+    ASSERT_GE(list.load_factor(), list.max_load_factor());
+    for (int i = 0; i < 100; ++i) {
+        list.push_front(i % 4);
+    }
+    ASSERT_EQ(list.bucket_count(), buckets);
+    ASSERT_EQ(list.count(3), 26u);
+}
+
+// перемещение элемента бросает исключение, когда счетчик доходит до нуля
+struct FragileValue {
+    static int moves_left;
+
+    int value;
+
+    FragileValue(int value) : value(value) {}
+    FragileValue(const FragileValue& other) = default;
+    FragileValue(FragileValue&& other) : value(other.value) {
+        if (moves_left-- == 0) {
+            throw std::runtime_error("move failed");
+        }
+    }
+
+    bool operator==(const FragileValue& other) const { return value == other.value; }
+};
+
+int FragileValue::moves_left = -1;
+
+struct FragileHash {
+    std::size_t operator()(const FragileValue& item) const { return std::hash<int>()(item.value); }
+};
+
+// аллокатор, который не переходит при перемещающем присваивании, а пулы разных экземпляров не равны
+template <class T>
+struct StickyPool : PoolAllocator<T> {
+    using propagate_on_container_move_assignment = std::false_type;
+
+    template <class U>
+    struct rebind {
+        using other = StickyPool<U>;
+    };
+
+    StickyPool() = default;
+    template <class U>
+    StickyPool(const StickyPool<U>& other) : PoolAllocator<T>(other) {}
+};
+
+TEST(IndexedListTest, MoveAssignmentThrowKeepsIndex) {
+    using List = IndexedList<FragileValue, FragileHash, std::equal_to<FragileValue>, StickyPool<FragileValue>>;
+    List source {1, 2, 3, 4};
+    List target {5, 6};
+    ASSERT_NE(source.get_allocator(), target.get_allocator());
+    FragileValue::moves_left = 2;
+    ASSERT_THROW(target = std::move(source), std::runtime_error);
+    FragileValue::moves_left = -1;
+    std::size_t size = 0;
+    if (!target.empty()) {
+        for (auto it = target.cbegin(); it != target.cend(); ++it, ++size) {
+            ASSERT_NE(target.find(*it), target.cend());
+        }
+    }
+    ASSERT_EQ(target.size(), size);
+    target.push_front(7);
+    ASSERT_EQ(target.find(7), target.cbegin());
+    target = std::move(source);
+    ASSERT_EQ(target.size(), 4u);
+    for (int i = 1; i <= 4; ++i) {
+        ASSERT_EQ((*target.find(i)).value, i);
+    }
+}
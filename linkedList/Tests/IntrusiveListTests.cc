@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "../src/intrusive_list.h"
+#include <forward_list>
+#include <iterator>
+#include <vector>
+
+// объект, который может одновременно состоять в двух списках
+struct Task {
+    int id;
+    IntrusiveHook<Task> by_owner;
+    IntrusiveHook<Task> by_queue;
+
+    explicit Task(int id) : id(id) {}
+    bool operator==(const Task& other) const { return id == other.id; }
+};
+
+using OwnerList = IntrusiveList<Task, &Task::by_owner>;
+using QueueList = IntrusiveList<Task, &Task::by_queue>;
+
+template <class List>
+static std::vector<int> Ids(const List& list) {
+    std::vector<int> ids;
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            ids.push_back((*it).id);
+        }
+    }
+    return ids;
+}
+
+static std::vector<int> Ids(const std::forward_list<int>& flist) {
+    return std::vector<int>(flist.begin(), flist.end());
+}
+
+TEST(IntrusiveListTest, PushPopFront) {
+    std::vector<Task> tasks {Task(1), Task(2), Task(3)};
+    OwnerList list;
+    std::forward_list<int> flist;
+    ASSERT_TRUE(list.empty());
+    ASSERT_THROW(list.front(), std::runtime_error);
+    for (Task& task : tasks) {
+        list.push_front(task);
+        flist.push_front(task.id);
+    }
+    ASSERT_EQ(&list.front(), &tasks[2]);
+    ASSERT_EQ(Ids(list), Ids(flist));
+    list.pop_front();
+    flist.pop_front();
+    ASSERT_EQ(Ids(list), Ids(flist));
+    ASSERT_EQ(tasks[2].by_owner.next, nullptr);
+    list.clear();
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(IntrusiveListTest, InsertAndEraseAfter) {
+    std::vector<Task> tasks {Task(1), Task(2), Task(3), Task(4)};
+    OwnerList list;
+    std::forward_list<int> flist;
+    list.push_front(tasks[2]);
+    list.push_front(tasks[0]);
+    flist.push_front(3);
+    flist.push_front(1);
+    auto it = list.insert_after(list.begin(), tasks[1]);
+    flist.insert_after(flist.begin(), 2);
+    ASSERT_EQ((*it).id, 2);
+    list.insert_after(list.find(tasks[2]), tasks[3]);
+    flist.insert_after(std::next(flist.begin(), 2), 4);
+    ASSERT_EQ(Ids(list), Ids(flist));
+    auto next = list.erase_after(list.begin());
+    flist.erase_after(flist.begin());
+    ASSERT_EQ((*next).id, 3);
+    ASSERT_EQ(Ids(list), Ids(flist));
+    ASSERT_EQ(list.find(tasks[1]), list.end());
+}
+
+TEST(IntrusiveListTest, ObjectInSeveralLists) {
+    std::vector<Task> tasks {Task(1), Task(2), Task(3), Task(4)};
+    OwnerList owned;
+    QueueList queued;
+    for (Task& task : tasks) {
+        owned.push_front(task);
+        if (task.id % 2 == 0) {
+            queued.push_front(task);
+        }
+    }
+    ASSERT_EQ(Ids(owned), std::vector<int>({4, 3, 2, 1}));
+    ASSERT_EQ(Ids(queued), std::vector<int>({4, 2}));
+    queued.pop_front();
+    ASSERT_EQ(Ids(owned), std::vector<int>({4, 3, 2, 1}));
+    (*owned.find(tasks[1])).id = 20;
+    ASSERT_EQ(queued.front().id, 20);
+}
+
+TEST(IntrusiveListTest, MoveTransfersElements) {
+    std::vector<Task> tasks {Task(1), Task(2)};
+    OwnerList list;
+    list.push_front(tasks[0]);
+    list.push_front(tasks[1]);
+    OwnerList moved(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(Ids(moved), std::vector<int>({2, 1}));
+    list = std::move(moved);
+    ASSERT_TRUE(moved.empty());
+    const OwnerList& clist = list;
+    ASSERT_EQ((*clist.find(tasks[0])).id, 1);
+    ASSERT_EQ(clist.find(Task(7)), clist.cend());
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "../src/linked_list.h"
+#include "../src/list_reclaimer.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// запоминает поток, в котором элемент был разрушен
+struct ThreadMark {
+    std::thread::id* destroyed_in;
+
+    explicit ThreadMark(std::thread::id* destroyed_in) : destroyed_in(destroyed_in) {}
+    ThreadMark(ThreadMark&& other) noexcept : destroyed_in(other.destroyed_in) { other.destroyed_in = nullptr; }
+    ~ThreadMark() {
+        if (destroyed_in) {
+            *destroyed_in = std::this_thread::get_id();
+        }
+    }
+};
+
+TEST(ListReclaimerTest, RetireDestroysOnWorkerThread) {
+    ListReclaimer reclaimer;
+    std::thread::id destroyed_in;
+    auto counter = std::make_shared<int>(0);
+    LinkedList<std::shared_ptr<int>> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(counter);
+    }
+    LinkedList<ThreadMark> marks;
+    marks.emplace_front(&destroyed_in);
+    const auto old_allocator = list.get_allocator();
+    reclaimer.retire(std::move(list));
+    reclaimer.retire(std::move(marks));
+    reclaimer.flush();
+    ASSERT_EQ(reclaimer.pending(), 0u);
+    ASSERT_EQ(counter.use_count(), 1);
+    ASSERT_NE(destroyed_in, std::thread::id());
+    ASSERT_NE(destroyed_in, std::this_thread::get_id());
+    // отданный список пуст, работает дальше и уже не делит пул с уничтоженным
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0u);
+    ASSERT_NE(list.get_allocator(), old_allocator);
+    list.push_back(counter);
+    ASSERT_EQ(list.front(), counter);
+}
+
+TEST(ListReclaimerTest, StdAllocatorList) {
+    ListReclaimer reclaimer;
+    LinkedList<int, std::allocator<int>> list {1, 2, 3};
+    reclaimer.retire(std::move(list));
+    reclaimer.flush();
+    ASSERT_TRUE(list.empty());
+    list.push_back(4);
+    ASSERT_EQ(list.back(), 4);
+}
+
+// деструктор уборщика уничтожает все, что осталось в очереди
+TEST(ListReclaimerTest, DestructorReclaimsEverything) {
+    auto counter = std::make_shared<int>(0);
+    {
+        ListReclaimer reclaimer;
+        for (int i = 0; i < 100; ++i) {
+            LinkedList<std::shared_ptr<int>> list;
+            for (int j = 0; j < 100; ++j) {
+                list.push_front(counter);
+            }
+            reclaimer.retire(std::move(list));
+        }
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+TEST(ListReclaimerTest, RetireFromSeveralThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kLists = 200;
+    ListReclaimer reclaimer;
+    auto counter = std::make_shared<int>(0);
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            LinkedList<std::shared_ptr<int>> list;
+            for (int i = 0; i < kLists; ++i) {
+                for (int j = 0; j < 50; ++j) {
+                    list.push_back(counter);
+                }
+                reclaimer.retire(std::move(list));
+            }
+        });
+    }
+    start.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    reclaimer.flush();
+    ASSERT_EQ(reclaimer.pending(), 0u);
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+// без flush: уборщик засыпает между retire и должен просыпаться от каждого, ожидания по таймауту больше нет
+TEST(ListReclaimerTest, RetireWakesSleepingWorker) {
+    ListReclaimer reclaimer(ReclaimerPriority::Low);
+    auto counter = std::make_shared<int>(0);
+    for (int i = 0; i < 200; ++i) {
+        LinkedList<std::shared_ptr<int>> list;
+        list.push_back(counter);
+        reclaimer.retire(std::move(list));
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (reclaimer.pending() != 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(reclaimer.pending(), 0u) << "retire " << i;
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
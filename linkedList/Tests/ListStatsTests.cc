@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "../src/linked_list.h"
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
+using CountedList = LinkedList<int, PoolAllocator<int>, ListStats>;
+
+// без статистики список и итераторы не растут ни на байт
+TEST(ListStatsTest, DisabledStatsTakeNoSpace) {
+    static_assert(!NoListStats::enabled, "");
+    ASSERT_EQ(sizeof(LinkedList<int, PoolAllocator<int>, NoListStats>),
+              sizeof(PoolAllocator<int>) + 3 * sizeof(void*));
+    ASSERT_EQ(sizeof(LinkedList<int, PoolAllocator<int>, NoListStats>::iterator), sizeof(void*));
+    ASSERT_EQ(sizeof(LinkedList<int, PoolAllocator<int>, NoListStats>::const_iterator), sizeof(void*));
+    LinkedList<int, PoolAllocator<int>, NoListStats> list {1, 2, 3};
+    list.find(3);
+    ASSERT_EQ(list.stats().allocations, 0u);
+    ASSERT_EQ(list.stats().find_hits, 0u);
+}
+
+TEST(ListStatsTest, AllocationsFreesAndPeak) {
+    CountedList list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    list.pop_front();
+    list.pop_front();
+    list.emplace_front(100);
+    ListStats stats = list.stats();
+    ASSERT_EQ(stats.allocations, 11u);
+    ASSERT_EQ(stats.frees, 2u);
+    ASSERT_EQ(stats.live_nodes, 9u);
+    ASSERT_EQ(stats.peak_nodes, 10u);
+    list.clear();
+    stats = list.stats();
+    ASSERT_EQ(stats.frees, 11u);
+    ASSERT_EQ(stats.live_nodes, 0u);
+    ASSERT_EQ(stats.peak_nodes, 10u);
+}
+
+TEST(ListStatsTest, CopiedNodes) {
+    CountedList list {1, 2, 3, 4};
+    CountedList copy(list);
+    ASSERT_EQ(copy.stats().copied_nodes, 4u);
+    ASSERT_EQ(copy.stats().allocations, 4u);
+    ASSERT_EQ(list.stats().copied_nodes, 0u);
+    copy = CountedList {1, 2};
+    copy = list;
+    ASSERT_EQ(copy.stats().copied_nodes, 8u);
+}
+
+TEST(ListStatsTest, IteratorHops) {
+    CountedList list {1, 2, 3, 4, 5};
+    int sum = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(sum, 15);
+    ASSERT_EQ(list.stats().iterator_hops, 5u);
+    const CountedList& view = list;
+    for (auto it = view.cbegin(); it != view.cend(); ++it) {
+    }
+    ASSERT_EQ(list.stats().iterator_hops, 10u);
+    // итератор, не полученный от списка, ничего не считает
+    CountedList::iterator detached;
+    detached = list.begin();
+    ++detached;
+    ASSERT_EQ(list.stats().iterator_hops, 11u);
+}
+
+// длина поиска - число просмотренных элементов, у промаха - весь список
+TEST(ListStatsTest, FindProbeHistogram) {
+    CountedList list;
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    list.find(0);
+    list.find(2);
+    list.find(3);
+    list.find(99);
+    list.find(-1);
+    const CountedList& view = list;
+    view.find(-2);
+    const ListStats stats = list.stats();
+    ASSERT_EQ(stats.find_hits, 4u);
+    ASSERT_EQ(stats.find_misses, 2u);
+    ASSERT_EQ(stats.hit_probes[ListStats::probe_bucket(1)], 1u);
+    ASSERT_EQ(stats.hit_probes[ListStats::probe_bucket(3)], 1u);
+    ASSERT_EQ(stats.hit_probes[ListStats::probe_bucket(4)], 1u);
+    ASSERT_EQ(stats.hit_probes[ListStats::probe_bucket(100)], 1u);
+    ASSERT_EQ(stats.miss_probes[ListStats::probe_bucket(100)], 2u);
+    ASSERT_EQ(ListStats::probe_bucket(0), 0u);
+    ASSERT_EQ(ListStats::probe_bucket(1), 1u);
+    ASSERT_EQ(ListStats::probe_bucket(2), 2u);
+    ASSERT_EQ(ListStats::probe_bucket(3), 2u);
+    ASSERT_EQ(ListStats::probe_bucket(4), 3u);
+    ASSERT_EQ(ListStats::probe_bucket(~std::size_t(0)), ListStats::kProbeBuckets - 1);
+}
+
+TEST(ListStatsTest, ResetAndMove) {
+    CountedList list {1, 2, 3};
+    list.find(2);
+    list.reset_stats();
+    ListStats stats = list.stats();
+    ASSERT_EQ(stats.allocations, 0u);
+    ASSERT_EQ(stats.find_hits, 0u);
+    ASSERT_EQ(stats.peak_nodes, 3u);
+    CountedList moved(std::move(list));
+    ASSERT_EQ(moved.stats().allocations, 0u);
+    ASSERT_EQ(moved.stats().live_nodes, 3u);
+    ASSERT_EQ(moved.stats().peak_nodes, 3u);
+}
+
+TEST(ListStatsTest, MonotonicResourceCountsForgottenNodes) {
+    std::pmr::monotonic_buffer_resource resource;
+    LinkedList<int, std::pmr::polymorphic_allocator<int>, ListStats> list(&resource);
+    list.push_front(1);
+    list.push_front(2);
+    list.clear();
+    ASSERT_EQ(list.stats().allocations, 2u);
+    ASSERT_EQ(list.stats().frees, 2u);
+}
+
+TEST(ListStatsTest, TextAndJsonSinks) {
+    CountedList list {1, 2, 3};
+    list.find(2);
+    list.find(7);
+    std::ostringstream text;
+    write_text(text, list.stats());
+    ASSERT_NE(text.str().find("allocations 3\n"), std::string::npos);
+    ASSERT_NE(text.str().find("hit_probes 2:1\n"), std::string::npos);
+    ASSERT_NE(text.str().find("miss_probes 2:1\n"), std::string::npos);
+    std::ostringstream json;
+    write_json(json, list.stats());
+    const std::string dump = json.str();
+    ASSERT_EQ(dump.front(), '{');
+    ASSERT_EQ(dump.back(), '}');
+    ASSERT_NE(dump.find("\"allocations\":3,"), std::string::npos);
+    ASSERT_NE(dump.find("\"find_misses\":1,"), std::string::npos);
+    ASSERT_NE(dump.find("\"hit_probes\":[0,0,1,0,"), std::string::npos);
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "../src/mapped_list.h"
+#include <cstdio>
+#include <forward_list>
+#include <fstream>
+#include <string>
+
+static std::string TempPath(const std::string& name) {
+    return ::testing::TempDir() + "mapped_list_" + name;
+}
+
+template <class List, class ForwardList>
+static void ExpectSameElements(const List& list, const ForwardList& flist) {
+    auto fit = flist.begin();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++fit) {
+            ASSERT_NE(fit, flist.end());
+            ASSERT_EQ(*it, *fit);
+        }
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+TEST(MappedListTest, SaveAndOpen) {
+    const std::string path = TempPath("save_and_open");
+    LinkedList<int> list;
+    std::forward_list<int> flist;
+    for (int i = 0; i < 10000; ++i) {
+        list.push_front(i);
+        flist.push_front(i);
+    }
+    save_list(list, path);
+    MappedList<int> mapped(path);
+    ASSERT_EQ(mapped.size(), 10000u);
+    ASSERT_EQ(mapped.front(), 9999);
+    ExpectSameElements(mapped, flist);
+    ASSERT_NE(mapped.find(42), mapped.cend());
+    ASSERT_EQ(*mapped.find(42), 42);
+    ASSERT_EQ(mapped.find(-1), mapped.cend());
+    std::remove(path.c_str());
+}
+
+TEST(MappedListTest, EmptyList) {
+    const std::string path = TempPath("empty");
+    save_list(LinkedList<double>(), path);
+    MappedList<double> mapped(path);
+    ASSERT_TRUE(mapped.empty());
+    ASSERT_EQ(mapped.size(), 0u);
+    ASSERT_THROW(mapped.front(), std::runtime_error);
+    ASSERT_EQ(mapped.find(1.0), mapped.cend());
+    std::remove(path.c_str());
+}
+
+struct MappedPoint {
+    int x;
+    short y;
+    bool operator==(const MappedPoint& other) const { return x == other.x && y == other.y; }
+};
+
+TEST(MappedListTest, StructElementsAndPopFront) {
+    const std::string path = TempPath("struct");
+    save_list(LinkedList<MappedPoint> {{1, 2}, {3, 4}, {5, 6}}, path);
+    MappedList<MappedPoint> mapped(path);
+    mapped.pop_front();
+    ASSERT_EQ(mapped.size(), 2u);
+    ExpectSameElements(mapped, std::forward_list<MappedPoint> {{3, 4}, {5, 6}});
+    MappedList<MappedPoint> moved(std::move(mapped));
+    ASSERT_TRUE(mapped.empty());
+    ASSERT_EQ(moved.front().x, 3);
+    std::remove(path.c_str());
+}
+
+TEST(MappedListTest, CopyOnWriteDoesNotChangeFile) {
+    const std::string path = TempPath("copy_on_write");
+    save_list(LinkedList<int> {1, 2, 3}, path);
+    {
+        MappedList<int, MapMode::CopyOnWrite> mapped(path);
+        for (auto it = mapped.begin(); it != mapped.end(); ++it) {
+            *it *= 10;
+        }
+        mapped.front() = 7;
+        ExpectSameElements(mapped, std::forward_list<int> {7, 20, 30});
+    }
+    MappedList<int> reopened(path);
+    ExpectSameElements(reopened, std::forward_list<int> {1, 2, 3});
+    std::remove(path.c_str());
+}
+
+// файл заменяется целиком через переименование, поэтому открытый список видит старое содержимое,
+// а временный файл после сохранения не остается
+TEST(MappedListTest, SaveReplacesFileAtomically) {
+    const std::string path = TempPath("replace");
+    save_list(LinkedList<int> {1, 2, 3}, path);
+    MappedList<int> mapped(path);
+    save_list(LinkedList<int> {4, 5}, path);
+    ASSERT_EQ(mapped.size(), 3u);
+    ASSERT_EQ(mapped.front(), 1);
+    MappedList<int> reopened(path);
+    ASSERT_EQ(reopened.size(), 2u);
+    ASSERT_EQ(reopened.front(), 4);
+    ASSERT_FALSE(std::ifstream(path + ".tmp").good());
+    ASSERT_THROW(save_list(LinkedList<int> {1}, TempPath("missing_dir") + "/list"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(MappedListTest, RejectsInvalidFiles) {
+    ASSERT_THROW(MappedList<int>(TempPath("missing")), std::runtime_error);
+    const std::string path = TempPath("invalid");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(200, 'x');
+    }
+    ASSERT_THROW(MappedList<int> mapped(path), std::runtime_error);
+    save_list(LinkedList<int> {1, 2, 3}, path);
+    ASSERT_THROW(MappedList<long double> mapped(path), std::runtime_error);
+    std::remove(path.c_str());
+}
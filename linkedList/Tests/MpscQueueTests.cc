@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "../src/mpsc_queue.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MpscQueueTest, SingleThreadFifo) {
+    MpscQueue<int> queue;
+    std::deque<int> deque;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.try_pop(), std::nullopt);
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            queue.emplace(i);
+        } else {
+            queue.push(i);
+        }
+        deque.push_back(i);
+        if (i % 4 == 0) {
+            ASSERT_EQ(queue.pop(), deque.front());
+            deque.pop_front();
+        }
+    }
+    while (!deque.empty()) {
+        ASSERT_FALSE(queue.empty());
+        ASSERT_EQ(queue.try_pop(), deque.front());
+        deque.pop_front();
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+// значение разрушается сразу при извлечении, оставшиеся в очереди - вместе с ней
+TEST(MpscQueueTest, MoveOnlyValuesAndDestruction) {
+    auto counter = std::make_shared<int>(0);
+    {
+        MpscQueue<std::unique_ptr<std::shared_ptr<int>>> queue;
+        for (int i = 0; i < 10; ++i) {
+            queue.push(std::make_unique<std::shared_ptr<int>>(counter));
+        }
+        ASSERT_EQ(counter.use_count(), 11);
+        { auto taken = queue.pop(); }
+        ASSERT_EQ(counter.use_count(), 10);
+        queue.try_pop();
+        ASSERT_EQ(counter.use_count(), 9);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+TEST(MpscQueueTest, DrainTakesSnapshotInOrder) {
+    MpscQueue<int> queue;
+    ASSERT_EQ(queue.drain([](int) {}), 0u);
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    std::vector<int> drained;
+    // элементы, добавленные во время drain, в этот вызов не попадают
+    ASSERT_EQ(queue.drain([&](int value) {
+        drained.push_back(value);
+        queue.push(100 + value);
+    }), 10u);
+    ASSERT_EQ(drained, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ASSERT_EQ(queue.pop(), 100);
+    ASSERT_EQ(queue.drain([](int) {}), 9u);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, DrainConsumerThrows) {
+    MpscQueue<int> queue;
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+    }
+    ASSERT_THROW(queue.drain([](int value) {
+        if (value == 2) {
+            throw std::runtime_error("stop");
+        }
+    }), std::runtime_error);
+    ASSERT_EQ(queue.pop(), 3);
+    ASSERT_EQ(queue.pop(), 4);
+    ASSERT_TRUE(queue.empty());
+}
+
+// производители пишут пары (номер потока, порядковый номер), потребитель чередует pop, try_pop и drain
+// у каждого производителя номера должны приходить строго по возрастанию, ни один элемент не теряется
+TEST(MpscQueueTest, StressKeepsPerProducerOrder) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50000;
+    MpscQueue<std::pair<int, int>> queue;
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, &start, p] {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < kPerProducer; ++i) {
+                queue.emplace(p, i);
+            }
+        });
+    }
+    std::vector<int> expected(kProducers, 0);
+    int received = 0;
+    bool ordered = true;
+    auto accept = [&](const std::pair<int, int>& item) {
+        ordered = ordered && item.second == expected[item.first];
+        ++expected[item.first];
+        ++received;
+    };
+    start.store(true);
+    for (int round = 0; received < kProducers * kPerProducer; ++round) {
+        switch (round % 3) {
+        case 0:
+            queue.drain(accept);
+            break;
+        case 1:
+            if (auto item = queue.try_pop()) {
+                accept(*item);
+            }
+            break;
+        default:
+            if (!queue.empty()) {
+                accept(queue.pop());
+            }
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(received, kProducers * kPerProducer);
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include "../src/parallel_list.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static LinkedList<int> Sequence(int size) {
+    LinkedList<int> list;
+    for (int i = 0; i < size; ++i) {
+        list.push_back(i);
+    }
+    return list;
+}
+
+TEST(ParallelListTest, PartitionCoversList) {
+    LinkedList<int> list = Sequence(10);
+    ListPartition<LinkedList<int>> partition(list, 4);
+    ASSERT_EQ(partition.size(), 10u);
+    ASSERT_EQ(partition.chunks(), 4u);
+    ListPartition<LinkedList<int>> fine(list, 100);
+    ASSERT_EQ(fine.chunks(), 10u);
+    LinkedList<int> empty;
+    ListPartition<LinkedList<int>> none(empty, 4);
+    ASSERT_EQ(none.chunks(), 0u);
+    WorkStealingPool single(1);
+    ASSERT_EQ(ListPartition<LinkedList<int>>(list, single).chunks(), 1u);
+}
+
+TEST(ParallelListTest, ForEachAndCountIf) {
+    WorkStealingPool pool(4);
+    LinkedList<int> list = Sequence(100000);
+    parallel_for_each(pool, list, [](int& value) { value *= 2; });
+    int expected = 0;
+    for (int value : list) {
+        ASSERT_EQ(value, expected);
+        expected += 2;
+    }
+    const LinkedList<int>& view = list;
+    ASSERT_EQ(parallel_count_if(pool, view, [](int value) { return value % 3 == 0; }), 33334u);
+    std::atomic<long long> sum{0};
+    parallel_for_each(pool, view, [&sum](const int& value) { sum += value; });
+    ASSERT_EQ(sum.load(), 100000LL * 99999);
+    LinkedList<int> empty;
+    ASSERT_EQ(parallel_count_if(pool, empty, [](int) { return true; }), 0u);
+}
+
+// совпадений несколько в разных кусках, найтись должно самое левое, как у find
+TEST(ParallelListTest, FindFirstMatchesSequentialFind) {
+    WorkStealingPool pool(4);
+    LinkedList<int> list;
+    for (int i = 0; i < 50000; ++i) {
+        list.push_back(i % 7000);
+    }
+    ListPartition<LinkedList<int>> partition(list, 64);
+    for (int value : {0, 1, 6999, 4321}) {
+        ASSERT_EQ(parallel_find_first(pool, partition, value), list.find(value));
+        ASSERT_EQ(parallel_find_first(pool, list, value), list.find(value));
+    }
+    ASSERT_EQ(parallel_find_first(pool, list, -1), list.end());
+    const LinkedList<int>& view = list;
+    auto it = parallel_find_first_if(pool, view, [](int value) { return value > 6990; });
+    ASSERT_EQ(it, view.find(6991));
+    LinkedList<int> empty;
+    ASSERT_EQ(parallel_find_first(pool, empty, 1), empty.end());
+}
+
+TEST(ParallelListTest, CopyKeepsOrderAndNodesAreContiguous) {
+    WorkStealingPool pool(4);
+    LinkedList<std::string> list;
+    for (int i = 0; i < 10000; ++i) {
+        list.push_back(std::to_string(i));
+    }
+    const LinkedList<std::string>& view = list;
+    LinkedList<std::string> copy = parallel_copy(pool, view);
+    ASSERT_EQ(copy.size(), list.size());
+    ASSERT_EQ(copy.back(), "9999");
+    auto it = copy.begin();
+    for (const std::string& value : list) {
+        ASSERT_EQ(*it, value);
+        ++it;
+    }
+    ASSERT_EQ(it, copy.end());
+    ASSERT_NE(copy.get_allocator(), list.get_allocator());
+    copy.push_back("tail");
+    ASSERT_EQ(copy.back(), "tail");
+    LinkedList<int> single {7};
+    ASSERT_EQ(parallel_copy(pool, single).front(), 7);
+    LinkedList<int, std::allocator<int>> standard {1, 2, 3};
+    ASSERT_EQ(parallel_copy(pool, standard).size(), 3u);
+}
+
+struct ThrowingCopy {
+    static std::atomic<int> alive;
+    int value;
+
+    explicit ThrowingCopy(int value) : value(value) { ++alive; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (value == 5000) {
+            throw std::runtime_error("copy failed");
+        }
+        ++alive;
+    }
+    ~ThrowingCopy() { --alive; }
+};
+
+std::atomic<int> ThrowingCopy::alive{0};
+
+// исключение из конструктора элемента: уже построенные элементы копии разрушены, исходный список не тронут
+TEST(ParallelListTest, CopyThrowingElementFreesRun) {
+    WorkStealingPool pool(4);
+    {
+        LinkedList<ThrowingCopy> list;
+        for (int i = 0; i < 10000; ++i) {
+            list.emplace_back(i);
+        }
+        ASSERT_THROW(parallel_copy(pool, list), std::runtime_error);
+        ASSERT_EQ(ThrowingCopy::alive.load(), 10000);
+        ASSERT_EQ(list.size(), 10000u);
+    }
+    ASSERT_EQ(ThrowingCopy::alive.load(), 0);
+}
@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "../src/linked_list.h"
+#include <forward_list>
+#include <memory_resource>
+#include <string>
+
+// ресурс поверх new_delete_resource, считающий выделения и освобождения
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+template <class List>
+static std::forward_list<typename List::value_type> ToForwardList(const List& list) {
+    std::forward_list<typename List::value_type> result;
+    if (!list.empty()) {
+        auto tail = result.before_begin();
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            tail = result.insert_after(tail, *it);
+        }
+    }
+    return result;
+}
+
+TEST(PmrLinkedListTest, NodesComeFromResource) {
+    CountingResource resource;
+    {
+        pmr::LinkedList<int> list(&resource);
+        for (int i = 0; i < 10; ++i) {
+            list.push_front(i);
+        }
+        ASSERT_EQ(resource.allocations, 10);
+        ASSERT_EQ(list.get_allocator().resource(), &resource);
+        list.pop_front();
+        ASSERT_EQ(resource.deallocations, 1);
+    }
+    ASSERT_EQ(resource.deallocations, 10);
+}
+
+TEST(PmrLinkedListTest, MonotonicResourceReleasesInBulk) {
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena(&upstream);
+    pmr::LinkedList<int> list({1, 2, 3}, &arena);
+    for (int i = 0; i < 10000; ++i) {
+        list.push_front(i);
+    }
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    list.push_front(5);
+    ASSERT_EQ(list.front(), 5);
+    ASSERT_EQ(upstream.deallocations, 0);
+    arena.release();
+    ASSERT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(PmrLinkedListTest, MonotonicResourceStillRunsDestructors) {
+    struct Counted {
+        int* destroyed;
+        ~Counted() { ++*destroyed; }
+    };
+    int destroyed = 0;
+    std::pmr::monotonic_buffer_resource arena;
+    {
+        pmr::LinkedList<Counted> list(&arena);
+        list.emplace_front(Counted{&destroyed});
+        list.emplace_front(Counted{&destroyed});
+        destroyed = 0;
+    }
+    ASSERT_EQ(destroyed, 2);
+}
+
+TEST(PmrLinkedListTest, CopyConstructionUsesDefaultOrGivenResource) {
+    CountingResource first;
+    CountingResource second;
+    pmr::LinkedList<std::string> list({"a", "b", "c"}, &first);
+    pmr::LinkedList<std::string> copy(list);
+    ASSERT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    pmr::LinkedList<std::string> extended(list, &second);
+    ASSERT_EQ(extended.get_allocator().resource(), &second);
+    ASSERT_EQ(second.allocations, 3);
+    ASSERT_EQ(ToForwardList(copy), ToForwardList(list));
+    ASSERT_EQ(ToForwardList(extended), ToForwardList(list));
+}
+
+TEST(PmrLinkedListTest, CopyAssignmentKeepsOwnResource) {
+    CountingResource first;
+    CountingResource second;
+    pmr::LinkedList<int> list({1, 2, 3}, &first);
+    pmr::LinkedList<int> target({4}, &second);
+    target = list;
+    ASSERT_EQ(target.get_allocator().resource(), &second);
+    ASSERT_EQ(second.allocations, 4);
+    ASSERT_EQ(second.deallocations, 1);
+    ASSERT_EQ(ToForwardList(target), ToForwardList(list));
+}
+
+TEST(PmrLinkedListTest, MoveConstruction) {
+    CountingResource first;
+    CountingResource second;
+    pmr::LinkedList<int> list({1, 2, 3}, &first);
+    const int* node = &list.front();
+    pmr::LinkedList<int> moved(std::move(list));
+    ASSERT_EQ(moved.get_allocator().resource(), &first);
+    ASSERT_EQ(&moved.front(), node);
+    pmr::LinkedList<int> same(std::move(moved), &first);
+    ASSERT_EQ(&same.front(), node);
+    pmr::LinkedList<int> other(std::move(same), &second);
+    ASSERT_TRUE(same.empty());
+    ASSERT_EQ(second.allocations, 3);
+    ASSERT_EQ(first.deallocations, 3);
+    ASSERT_EQ(ToForwardList(other), std::forward_list<int>({1, 2, 3}));
+}
+
+TEST(PmrLinkedListTest, MoveAssignmentKeepsOwnResource) {
+    CountingResource first;
+    CountingResource second;
+    pmr::LinkedList<int> list({1, 2, 3}, &first);
+    pmr::LinkedList<int> same_resource(&first);
+    const int* node = &list.front();
+    same_resource = std::move(list);
+    ASSERT_EQ(&same_resource.front(), node);
+    ASSERT_EQ(first.allocations, 3);
+    pmr::LinkedList<int> other_resource(&second);
+    other_resource = std::move(same_resource);
+    ASSERT_EQ(other_resource.get_allocator().resource(), &second);
+    ASSERT_TRUE(same_resource.empty());
+    ASSERT_EQ(second.allocations, 3);
+    ASSERT_EQ(ToForwardList(other_resource), std::forward_list<int>({1, 2, 3}));
+}
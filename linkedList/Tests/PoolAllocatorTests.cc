@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+#include "../src/linked_list.h"
+#include <forward_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(PoolAllocatorTest, ReusesFreedBlocks) {
+    PoolAllocator<int> alloc;
+    int* first = alloc.allocate(1);
+    alloc.deallocate(first, 1);
+    int* second = alloc.allocate(1);
+    ASSERT_EQ(first, second);
+    alloc.deallocate(second, 1);
+}
+
+TEST(PoolAllocatorTest, BlocksAreContiguous) {
+    PoolAllocator<long> alloc;
+    long* first = alloc.allocate(1);
+    long* second = alloc.allocate(1);
+    ASSERT_EQ(reinterpret_cast<char*>(second) - reinterpret_cast<char*>(first),
+              static_cast<std::ptrdiff_t>(alloc.pool().block_size(sizeof(long), alignof(long))));
+    alloc.deallocate(first, 1);
+    alloc.deallocate(second, 1);
+}
+
+TEST(PoolAllocatorTest, ArrayAllocationBypassesPool) {
+    PoolAllocator<int> alloc;
+    int* array = alloc.allocate(16);
+    ASSERT_EQ(alloc.pool().capacity(), 0u);
+    alloc.deallocate(array, 16);
+}
+
+TEST(PoolAllocatorTest, RunIsContiguousAndFreedPerBlock) {
+    PoolAllocator<long> alloc;
+    long* single = alloc.allocate(1);
+    long* run = alloc.allocate_run(100000);
+    const auto step = static_cast<std::ptrdiff_t>(alloc.pool().block_size(sizeof(long), alignof(long)));
+    ASSERT_NE(run, nullptr);
+    ASSERT_GE(alloc.pool().capacity(), 100001u);
+    ASSERT_EQ(reinterpret_cast<char*>(run + 1) - reinterpret_cast<char*>(run), step);
+    for (std::size_t i = 0; i < 100000; ++i) {
+        alloc.deallocate(run + i, 1);
+    }
+    alloc.deallocate(single, 1);
+    // остаток прежнего slab тоже не потерян: он в списке свободных
+    const std::size_t capacity = alloc.pool().capacity();
+    std::vector<long*> blocks;
+    for (std::size_t i = 0; i < capacity; ++i) {
+        blocks.push_back(alloc.allocate(1));
+    }
+    ASSERT_EQ(alloc.pool().capacity(), capacity);
+    for (long* block : blocks) {
+        alloc.deallocate(block, 1);
+    }
+}
+
+struct ChainBlock {
+    ChainBlock* next;
+    long value;
+};
+
+// блоки связываются через link_free и возвращаются целиком, а выдаются обратно в том же порядке
+static void LinkChain(const std::vector<ChainBlock*>& blocks) {
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        PoolAllocator<ChainBlock>::link_free(blocks[i], i + 1 < blocks.size() ? blocks[i + 1] : nullptr);
+    }
+}
+
+TEST(PoolAllocatorTest, ChainReturnsBlocksInOrder) {
+    PoolAllocator<ChainBlock> alloc;
+    std::vector<ChainBlock*> blocks;
+    for (int i = 0; i < 1000; ++i) {
+        blocks.push_back(alloc.allocate(1));
+    }
+    const std::size_t capacity = alloc.pool().capacity();
+    LinkChain(blocks);
+    alloc.deallocate_chain(blocks.front(), blocks.back());
+    for (ChainBlock* block : blocks) {
+        ASSERT_EQ(alloc.allocate(1), block);
+    }
+    ASSERT_EQ(alloc.pool().capacity(), capacity);
+    LinkChain(blocks);
+    alloc.deallocate_chain(blocks.front(), blocks.back());
+    ASSERT_TRUE((supports_deallocate_chain<PoolAllocator<ChainBlock>>::value));
+    ASSERT_FALSE((supports_deallocate_chain<std::allocator<ChainBlock>>::value));
+}
+
+// размер сверх kMaxClasses классов пул не обслуживает, такие блоки освобождаются по одному через operator delete
+TEST(PoolAllocatorTest, ChainOutsidePoolFreedPerBlock) {
+    SlabPool pool;
+    std::vector<void*> classes;
+    for (std::size_t size = 8; size <= 64; size += 8) {
+        classes.push_back(pool.allocate(size, 8));
+    }
+    void* blocks[3];
+    for (void*& block : blocks) {
+        block = pool.allocate(128, 8);
+    }
+    ASSERT_EQ(pool.block_size(128, 8), 0u);
+    SlabPool::link_free(blocks[0], blocks[1]);
+    SlabPool::link_free(blocks[1], blocks[2]);
+    SlabPool::link_free(blocks[2], nullptr);
+    pool.deallocate_chain(blocks[0], blocks[2], 128, 8);
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        pool.deallocate(classes[i], 8 * (i + 1), 8);
+    }
+}
+
+// clear отдает узлы пулу одной цепочкой: память не растет, элементы разрушены, новые узлы занимают старые по порядку
+TEST(PoolAllocatorTest, ClearReturnsNodesInListOrder) {
+    auto counter = std::make_shared<int>(0);
+    LinkedList<std::shared_ptr<int>> list;
+    std::vector<const std::shared_ptr<int>*> addresses;
+    for (int i = 0; i < 500; ++i) {
+        list.push_back(counter);
+        addresses.push_back(&list.back());
+    }
+    const std::size_t capacity = list.get_allocator().pool().capacity();
+    list.clear();
+    ASSERT_EQ(counter.use_count(), 1);
+    for (int i = 0; i < 500; ++i) {
+        list.push_back(counter);
+        ASSERT_EQ(&list.back(), addresses[i]);
+    }
+    ASSERT_EQ(list.get_allocator().pool().capacity(), capacity);
+    list = LinkedList<std::shared_ptr<int>> {counter};
+    ASSERT_EQ(counter.use_count(), 2);
+}
+
+TEST(PoolAllocatorTest, CopiesShareRebindsShare) {
+    PoolAllocator<int> alloc;
+    PoolAllocator<int> copy(alloc);
+    PoolAllocator<double> rebound(alloc);
+    ASSERT_EQ(alloc, copy);
+    ASSERT_EQ(alloc, rebound);
+    ASSERT_NE(alloc, PoolAllocator<int>());
+    ASSERT_NE(alloc, alloc.select_on_container_copy_construction());
+}
+
+TEST(PoolAllocatorTest, ListNodesComeFromPool) {
+    LinkedList<int> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.push_front(i);
+    }
+    ASSERT_GE(list.get_allocator().pool().capacity(), 1000u);
+    list.pop_front();
+    list.push_front(1000);
+    ASSERT_EQ(list.front(), 1000);
+}
+
+TEST(PoolAllocatorTest, CopyGetsOwnPool) {
+    LinkedList<int> list {1, 2, 3};
+    LinkedList<int> copy(list);
+    ASSERT_NE(list.get_allocator(), copy.get_allocator());
+    list.clear();
+    int expected[] = {1, 2, 3};
+    int index = 0;
+    for (auto it = copy.begin(); it != copy.end(); ++it) {
+        ASSERT_EQ(*it, expected[index++]);
+    }
+}
+
+TEST(PoolAllocatorTest, AssignmentKeepsOwnPool) {
+    LinkedList<std::string> list {"a", "b", "c"};
+    LinkedList<std::string> copy {"d"};
+    auto alloc = copy.get_allocator();
+    copy = list;
+    ASSERT_EQ(copy.get_allocator(), alloc);
+    copy = LinkedList<std::string>{"e", "f"};
+    ASSERT_NE(copy.get_allocator(), alloc);
+    ASSERT_EQ(copy.front(), "e");
+}
+
+TEST(PoolAllocatorTest, StdAllocatorMatchesForwardList) {
+    LinkedList<int, std::allocator<int>> list {1, 2, 3};
+    std::forward_list<int> flist {1, 2, 3};
+    LinkedList<int, std::allocator<int>> copy(list);
+    copy.pop_front();
+    flist.pop_front();
+    auto fit = flist.begin();
+    for (auto it = copy.begin(); it != copy.end(); ++it, ++fit) {
+        ASSERT_EQ(*it, *fit);
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+TEST(PoolAllocatorTest, ServesSeveralSizes) {
+    PoolAllocator<char> small;
+    PoolAllocator<long double> large(small);
+    char* c = small.allocate(1);
+    long double* d = large.allocate(1);
+    ASSERT_NE(small.pool().block_size(sizeof(char), alignof(char)), 0u);
+    ASSERT_NE(small.pool().block_size(sizeof(long double), alignof(long double)), 0u);
+    small.deallocate(c, 1);
+    large.deallocate(d, 1);
+    ASSERT_EQ(large.allocate(1), d);
+    large.deallocate(d, 1);
+}
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "../src/skip_list.h"
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+
+template <class List, class Set>
+static void ExpectSameOrder(const List& list, const Set& set) {
+    ASSERT_EQ(list.size(), set.size());
+    auto sit = set.begin();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++sit) {
+            ASSERT_EQ(*it, *sit);
+        }
+    }
+    ASSERT_EQ(sit, set.end());
+}
+
+TEST(SkipListTest, ConstructorDefault) {
+    SkipList<int> list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0u);
+    ASSERT_EQ(list.find(1), list.cend());
+}
+
+TEST(SkipListTest, InitializerListIsSorted) {
+    SkipList<int> list {5, 3, 9, 1, 3};
+    ExpectSameOrder(list, std::multiset<int>{1, 3, 3, 5, 9});
+    ASSERT_EQ(list.front(), 1);
+}
+
+TEST(SkipListTest, CustomCompare) {
+    SkipList<int, std::greater<int>> list;
+    for (int value : {2, 7, 4}) {
+        list.insert(value);
+    }
+    ExpectSameOrder(list, std::multiset<int, std::greater<int>>{2, 7, 4});
+}
+
+TEST(SkipListTest, RandomInsertEraseMatchesMultiset) {
+    SkipList<int> list;
+    std::multiset<int> set;
+    std::mt19937 random(42);
+    for (int i = 0; i < 5000; ++i) {
+        const int value = static_cast<int>(random() % 1000);
+        if (random() % 3 == 0) {
+            auto sit = set.find(value);
+            ASSERT_EQ(list.erase(value), sit != set.end());
+            if (sit != set.end()) {
+                set.erase(sit);
+            }
+        } else {
+            ASSERT_EQ(*list.insert(value), value);
+            set.insert(value);
+        }
+    }
+    ExpectSameOrder(list, set);
+    for (int value = 0; value < 1000; ++value) {
+        auto it = list.find(value);
+        ASSERT_EQ(it != list.cend(), set.count(value) > 0);
+        if (it != list.cend()) {
+            ASSERT_EQ(*it, value);
+        }
+    }
+}
+
+// find возвращает первый из равных, insert ставит новый элемент после равных
+TEST(SkipListTest, DuplicatesKeepInsertionOrder) {
+    using Pair = std::pair<int, int>;
+    auto by_key = [](const Pair& lhs, const Pair& rhs) { return lhs.first < rhs.first; };
+    SkipList<Pair, decltype(by_key)> list(by_key);
+    list.insert({1, 0});
+    list.insert({2, 0});
+    list.insert({1, 1});
+    list.insert({1, 2});
+    ASSERT_EQ((*list.find({1, -1})).second, 0);
+    ASSERT_TRUE(list.erase({1, -1}));
+    ASSERT_EQ((*list.find({1, -1})).second, 1);
+    std::vector<Pair> expected {{1, 1}, {1, 2}, {2, 0}};
+    auto eit = expected.begin();
+    for (auto it = list.cbegin(); it != list.cend(); ++it, ++eit) {
+        ASSERT_EQ(*it, *eit);
+    }
+}
+
+TEST(SkipListTest, PopFrontRemovesSmallest) {
+    SkipList<int> list {4, 2, 8};
+    list.pop_front();
+    ASSERT_EQ(list.front(), 4);
+    list.pop_front();
+    list.pop_front();
+    ASSERT_TRUE(list.empty());
+    list.pop_front();
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(SkipListTest, CopyAndMove) {
+    SkipList<std::string> list {"pear", "apple", "plum"};
+    SkipList<std::string> copy(list);
+    list.erase("apple");
+    ExpectSameOrder(copy, std::multiset<std::string>{"apple", "pear", "plum"});
+    ASSERT_EQ(*copy.find("plum"), "plum");
+    copy.insert("fig");
+    SkipList<std::string> move(std::move(copy));
+    ASSERT_TRUE(copy.empty());
+    ExpectSameOrder(move, std::multiset<std::string>{"apple", "fig", "pear", "plum"});
+    copy = move;
+    move = std::move(list);
+    ExpectSameOrder(copy, std::multiset<std::string>{"apple", "fig", "pear", "plum"});
+    ExpectSameOrder(move, std::multiset<std::string>{"pear", "plum"});
+    ASSERT_EQ(*copy.find("fig"), "fig");
+    ASSERT_EQ(move.find("fig"), move.cend());
+}
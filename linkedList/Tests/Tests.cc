@@ -2,6 +2,14 @@
 #include "../src/linked_list.h"
 #include <forward_list>
 #include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 TEST(LinkedListTest, ConstructorDefault) {
     LinkedList<int> list;
@@ -235,6 +243,548 @@ TEST(LinkedListTest, FindConst) {
     ASSERT_EQ(std::find(flist.begin(), flist.end(), 6), flist.end());
 }
 
+template <class List>
+static std::vector<int> ToVector(const List& list) {
+    std::vector<int> result;
+    if (list.empty()) {
+        return result;
+    }
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+static std::vector<int> ToVector(const std::forward_list<int>& flist) {
+    return std::vector<int>(flist.begin(), flist.end());
+}
+
+TEST(LinkedListTest, InsertAfter) {
+    LinkedList<int> list {1, 3};
+    std::forward_list<int> flist{1, 3};
+    auto it = list.insert_after(list.cbefore_begin(), 0);
+    auto fit = flist.insert_after(flist.cbefore_begin(), 0);
+    ASSERT_EQ(*it, 0);
+    ASSERT_EQ(*fit, 0);
+    list.insert_after(list.find(1), 2);
+    flist.insert_after(std::find(flist.begin(), flist.end(), 1), 2);
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+}
+
+TEST(LinkedListTest, EraseAfter) {
+    LinkedList<int> list {1, 2, 3, 4};
+    std::forward_list<int> flist{1, 2, 3, 4};
+    auto it = list.erase_after(list.find(2));
+    auto fit = flist.erase_after(std::find(flist.begin(), flist.end(), 2));
+    ASSERT_EQ(*it, 4);
+    ASSERT_EQ(*fit, 4);
+    list.erase_after(list.cbefore_begin());
+    flist.erase_after(flist.cbefore_begin());
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+}
+
+TEST(LinkedListTest, SpliceAfterSharedAllocator) {
+    LinkedList<int> list {1, 5};
+    LinkedList<int> other(list.get_allocator());
+    other.push_front(4);
+    other.push_front(3);
+    other.push_front(2);
+    std::forward_list<int> flist{1, 5};
+    std::forward_list<int> fother{2, 3, 4};
+    const int* node = &other.front();
+    const std::size_t capacity = list.get_allocator().pool().capacity();
+    list.splice_after(list.find(1), other);
+    flist.splice_after(flist.begin(), fother);
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    ASSERT_TRUE(other.empty());
+    ASSERT_TRUE(fother.empty());
+    ASSERT_EQ(&*list.find(2), node);
+    ASSERT_EQ(list.get_allocator().pool().capacity(), capacity);
+}
+
+TEST(LinkedListTest, SpliceAfterDifferentAllocators) {
+    LinkedList<int> list {1, 5};
+    LinkedList<int> other {2, 3, 4};
+    std::forward_list<int> flist{1, 5};
+    std::forward_list<int> fother{2, 3, 4};
+    list.splice_after(list.find(1), other);
+    flist.splice_after(flist.begin(), fother);
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    ASSERT_TRUE(other.empty());
+}
+
+TEST(LinkedListTest, SpliceAfterSingle) {
+    LinkedList<int> list {1, 2, 3, 4};
+    std::forward_list<int> flist{1, 2, 3, 4};
+    list.splice_after(list.cbefore_begin(), list, list.find(2));
+    flist.splice_after(flist.cbefore_begin(), flist, std::find(flist.begin(), flist.end(), 2));
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    LinkedList<int> other(list.get_allocator());
+    other.splice_after(other.cbefore_begin(), list, list.cbefore_begin());
+    ASSERT_EQ(other.front(), 3);
+    ASSERT_EQ(ToVector(list), std::vector<int>({1, 2, 4}));
+}
+
+TEST(LinkedListTest, Merge) {
+    LinkedList<std::pair<int, int>> list {{1, 0}, {3, 0}, {5, 0}};
+    LinkedList<std::pair<int, int>> other(list.get_allocator());
+    other.push_front({5, 1});
+    other.push_front({4, 1});
+    other.push_front({1, 1});
+    std::forward_list<std::pair<int, int>> flist{{1, 0}, {3, 0}, {5, 0}};
+    std::forward_list<std::pair<int, int>> fother{{1, 1}, {4, 1}, {5, 1}};
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+    list.merge(other, by_key);
+    flist.merge(fother, by_key);
+    ASSERT_TRUE(other.empty());
+    auto fit = flist.begin();
+    for (auto it = list.begin(); it != list.end(); ++it, ++fit) {
+        ASSERT_EQ(*it, *fit);
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+TEST(LinkedListTest, MergeDifferentAllocators) {
+    LinkedList<int> list {1, 3, 5};
+    LinkedList<int> other {0, 2, 3, 6};
+    std::forward_list<int> flist{1, 3, 5};
+    std::forward_list<int> fother{0, 2, 3, 6};
+    list.merge(other);
+    flist.merge(fother);
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    ASSERT_TRUE(other.empty());
+}
+
+TEST(LinkedListTest, Sort) {
+    std::mt19937 gen(42);
+    for (int size : {0, 1, 2, 3, 17, 1000}) {
+        LinkedList<int> list;
+        std::forward_list<int> flist;
+        for (int i = 0; i < size; ++i) {
+            const int value = static_cast<int>(gen() % 100);
+            list.push_front(value);
+            flist.push_front(value);
+        }
+        list.sort();
+        flist.sort();
+        ASSERT_EQ(ToVector(list), ToVector(flist));
+        list.sort(std::greater<int>());
+        flist.sort(std::greater<int>());
+        ASSERT_EQ(ToVector(list), ToVector(flist));
+    }
+}
+
+TEST(LinkedListTest, SortStableWithoutAllocation) {
+    LinkedList<std::pair<int, int>> list;
+    std::forward_list<std::pair<int, int>> flist;
+    for (int i = 0; i < 500; ++i) {
+        list.push_front({i % 7, i});
+        flist.push_front({i % 7, i});
+    }
+    const std::size_t capacity = list.get_allocator().pool().capacity();
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+    list.sort(by_key);
+    flist.sort(by_key);
+    ASSERT_EQ(list.get_allocator().pool().capacity(), capacity);
+    auto fit = flist.begin();
+    for (auto it = list.begin(); it != list.end(); ++it, ++fit) {
+        ASSERT_EQ(*it, *fit);
+    }
+}
+
+// компаратор бросает исключение на calls-м вызове: узлы не теряются, size() и хвост остаются верными
+TEST(LinkedListTest, SortThrowingCompareKeepsElements) {
+    std::mt19937 gen(7);
+    for (int size : {2, 3, 17, 100}) {
+        for (int limit : {1, 2, 5, 20, 60, 300}) {
+            LinkedList<int> list;
+            std::vector<int> expected;
+            for (int i = 0; i < size; ++i) {
+                const int value = static_cast<int>(gen() % 50);
+                list.push_front(value);
+                expected.push_back(value);
+            }
+            int calls = 0;
+            bool thrown = false;
+            try {
+                list.sort([&calls, limit](int a, int b) {
+                    if (++calls == limit) {
+                        throw std::runtime_error("compare");
+                    }
+                    return a < b;
+                });
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            ASSERT_EQ(list.size(), static_cast<std::size_t>(size));
+            std::vector<int> actual = ToVector(list);
+            ASSERT_EQ(actual.size(), expected.size());
+            std::sort(actual.begin(), actual.end());
+            std::sort(expected.begin(), expected.end());
+            ASSERT_EQ(actual, expected) << "size " << size << ", limit " << limit;
+            list.push_back(1000);
+            ASSERT_EQ(list.back(), 1000);
+            list.sort();
+            expected.push_back(1000);
+            ASSERT_EQ(ToVector(list), expected);
+            if (!thrown) {
+                ASSERT_LT(calls, limit);
+            }
+        }
+    }
+}
+
+TEST(LinkedListTest, MergeThrowingCompareKeepsElements) {
+    LinkedList<int> list {1, 3, 5, 7};
+    LinkedList<int> other(list.get_allocator());
+    for (int value : {2, 4, 6, 8}) {
+        other.push_back(value);
+    }
+    int calls = 0;
+    ASSERT_THROW(list.merge(other, [&calls](int a, int b) {
+        if (++calls == 3) {
+            throw std::runtime_error("compare");
+        }
+        return a < b;
+    }), std::runtime_error);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(list.size(), 8u);
+    list.push_back(9);
+    std::vector<int> actual = ToVector(list);
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(actual, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(LinkedListTest, Reverse) {
+    LinkedList<int> list {1, 2, 3, 4};
+    std::forward_list<int> flist{1, 2, 3, 4};
+    list.reverse();
+    flist.reverse();
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    LinkedList<int> empty;
+    empty.reverse();
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST(LinkedListTest, Unique) {
+    LinkedList<int> list {1, 1, 2, 2, 2, 3, 1, 1};
+    std::forward_list<int> flist{1, 1, 2, 2, 2, 3, 1, 1};
+    ASSERT_EQ(list.unique(), 4u);
+    flist.unique();
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    auto close = [](int a, int b) { return b - a == 1; };
+    LinkedList<int> steps {1, 2, 4, 5, 6};
+    std::forward_list<int> fsteps{1, 2, 4, 5, 6};
+    steps.unique(close);
+    fsteps.unique(close);
+    ASSERT_EQ(ToVector(steps), ToVector(fsteps));
+}
+
+TEST(LinkedListTest, RemoveIf) {
+    LinkedList<int> list {1, 2, 3, 4, 5, 6};
+    std::forward_list<int> flist{1, 2, 3, 4, 5, 6};
+    auto even = [](int value) { return value % 2 == 0; };
+    ASSERT_EQ(list.remove_if(even), 3u);
+    flist.remove_if(even);
+    ASSERT_EQ(ToVector(list), ToVector(flist));
+    list.remove_if([](int) { return true; });
+    ASSERT_TRUE(list.empty());
+}
+
+// считает копирования и перемещения, чтобы проверить, что вставка rvalue не копирует
+struct CopyCounter {
+    static int copies;
+    static int moves;
+    int value;
+
+    CopyCounter(int value) : value(value) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) { ++moves; }
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; ++moves; return *this; }
+    bool operator==(const CopyCounter& other) const { return value == other.value; }
+};
+
+int CopyCounter::copies = 0;
+int CopyCounter::moves = 0;
+
+TEST(LinkedListTest, MoveOnlyElements) {
+    LinkedList<std::unique_ptr<int>> list;
+    std::forward_list<std::unique_ptr<int>> flist;
+    list.push_front(std::make_unique<int>(3));
+    list.emplace_front(new int(1));
+    list.emplace_after(list.begin(), std::make_unique<int>(2));
+    flist.push_front(std::make_unique<int>(3));
+    flist.emplace_front(new int(1));
+    flist.emplace_after(flist.begin(), std::make_unique<int>(2));
+    auto fit = flist.begin();
+    for (auto it = list.begin(); it != list.end(); ++it, ++fit) {
+        ASSERT_EQ(**it, **fit);
+    }
+    LinkedList<std::unique_ptr<int>> moved(std::move(list));
+    moved.sort([](const auto& a, const auto& b) { return *a > *b; });
+    std::unique_ptr<int> first = moved.take_front();
+    ASSERT_EQ(*first, 3);
+    ASSERT_EQ(*moved.front(), 2);
+    LinkedList<std::unique_ptr<int>> other;
+    other = std::move(moved);
+    other.splice_after(other.cbefore_begin(), LinkedList<std::unique_ptr<int>>(other.get_allocator()));
+    ASSERT_EQ(*other.take_front(), 2);
+    ASSERT_EQ(*other.take_front(), 1);
+    ASSERT_TRUE(other.empty());
+    ASSERT_THROW(other.take_front(), std::runtime_error);
+}
+
+TEST(LinkedListTest, RvalueInsertionDoesNotCopy) {
+    CopyCounter::copies = 0;
+    CopyCounter::moves = 0;
+    LinkedList<CopyCounter> list;
+    list.emplace_front(1);
+    ASSERT_EQ(CopyCounter::moves, 0);
+    list.push_front(CopyCounter(2));
+    list.insert_after(list.cbefore_begin(), CopyCounter(3));
+    list.emplace_after(list.cbefore_begin(), 4);
+    CopyCounter taken = list.take_front();
+    ASSERT_EQ(taken.value, 4);
+    ASSERT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(CopyCounter::moves, 3);
+    LinkedList<CopyCounter> copy(list);
+    ASSERT_EQ(CopyCounter::copies, 3);
+}
+
+TEST(LinkedListTest, EmplaceThrowingConstructorLeavesListUnchanged) {
+    struct Throwing {
+        Throwing(int value) {
+            if (value < 0) {
+                throw std::runtime_error("negative");
+            }
+        }
+    };
+    LinkedList<Throwing> list;
+    list.emplace_front(1);
+    ASSERT_THROW(list.emplace_front(-1), std::runtime_error);
+    ASSERT_THROW(list.emplace_after(list.cbefore_begin(), -1), std::runtime_error);
+    list.pop_front();
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(LinkedListTest, QueueOperations) {
+    LinkedList<int> list;
+    std::deque<int> deque;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 2000; ++i) {
+        switch (gen() % 4) {
+        case 0:
+            list.push_back(i);
+            deque.push_back(i);
+            break;
+        case 1:
+            ASSERT_EQ(list.emplace_back(i), i);
+            deque.emplace_back(i);
+            break;
+        case 2:
+            list.push_front(i);
+            deque.push_front(i);
+            break;
+        default:
+            if (!deque.empty()) {
+                ASSERT_EQ(list.take_front(), deque.front());
+                deque.pop_front();
+            }
+        }
+        ASSERT_EQ(list.size(), deque.size());
+        if (!deque.empty()) {
+            ASSERT_EQ(list.front(), deque.front());
+            ASSERT_EQ(list.back(), deque.back());
+        }
+    }
+    ASSERT_EQ(ToVector(list), std::vector<int>(deque.begin(), deque.end()));
+    list.clear();
+    ASSERT_EQ(list.size(), 0u);
+    ASSERT_THROW(list.back(), std::runtime_error);
+}
+
+// после каждой перевязки узлов хвост и размер должны остаться верными: push_back кладет элемент в самый конец
+TEST(LinkedListTest, TailSurvivesRelinking) {
+    LinkedList<int> list {1, 2, 3};
+    std::list<int> expected {1, 2, 3};
+    auto check = [&](int marker) {
+        list.push_back(marker);
+        expected.push_back(marker);
+        ASSERT_EQ(list.size(), expected.size());
+        ASSERT_EQ(list.back(), marker);
+        ASSERT_EQ(ToVector(list), std::vector<int>(expected.begin(), expected.end()));
+    };
+
+    auto it = list.before_begin();
+    ++it;
+    ++it;
+    list.erase_after(it);
+    expected.pop_back();
+    check(10);
+
+    LinkedList<int> other(list.get_allocator());
+    other.push_back(20);
+    other.push_back(21);
+    list.splice_after(list.cbefore_begin(), other);
+    expected.push_front(21);
+    expected.push_front(20);
+    ASSERT_EQ(other.size(), 0u);
+    other.push_back(5);
+    ASSERT_EQ(other.back(), 5);
+    check(11);
+
+    auto last = list.before_begin();
+    for (std::size_t i = 0; i + 1 < list.size(); ++i) {
+        ++last;
+    }
+    other.push_back(6);
+    other.splice_after(other.cbefore_begin(), list, last);
+    expected.pop_back();
+    ASSERT_EQ(other.size(), 3u);
+    ASSERT_EQ(other.front(), 11);
+    ASSERT_EQ(other.back(), 6);
+    check(12);
+
+    auto tail = list.before_begin();
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        ++tail;
+    }
+    list.splice_after(tail, list, list.before_begin());
+    expected.push_back(expected.front());
+    expected.pop_front();
+    check(13);
+
+    list.sort();
+    expected.sort();
+    check(14);
+
+    LinkedList<int> high({30, 40}, list.get_allocator());
+    list.merge(high);
+    expected.merge(std::list<int>{30, 40});
+    check(50);
+    LinkedList<int> low({0, 1}, list.get_allocator());
+    list.merge(low);
+    expected.merge(std::list<int>{0, 1});
+    check(60);
+
+    list.reverse();
+    expected.reverse();
+    check(60);
+    list.unique();
+    expected.unique();
+    check(7);
+    list.remove_if([](int value) { return value == 7; });
+    expected.remove_if([](int value) { return value == 7; });
+    check(8);
+
+    LinkedList<int> moved(std::move(list));
+    ASSERT_EQ(list.size(), 0u);
+    list.push_back(1);
+    ASSERT_EQ(ToVector(list), std::vector<int>{1});
+    list = std::move(moved);
+    check(9);
+}
+
+TEST(LinkedListTest, AppendAndAssign) {
+    LinkedList<int> list {1, 2};
+    std::vector<int> source {3, 4, 5};
+    list.append(source.begin(), source.end());
+    ASSERT_EQ(ToVector(list), (std::vector<int>{1, 2, 3, 4, 5}));
+    ASSERT_EQ(list.size(), 5u);
+    ASSERT_EQ(list.back(), 5);
+
+    std::istringstream input("6 7 8");
+    list.append(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    ASSERT_EQ(list.size(), 8u);
+    ASSERT_EQ(list.back(), 8);
+
+    list.append(source.end(), source.end());
+    ASSERT_EQ(list.size(), 8u);
+
+    auto third = list.begin();
+    ++third;
+    ++third;
+    list.assign(third, list.end());
+    ASSERT_EQ(ToVector(list), (std::vector<int>{3, 4, 5, 6, 7, 8}));
+    list.assign({9});
+    ASSERT_EQ(ToVector(list), std::vector<int>{9});
+    ASSERT_EQ(list.back(), 9);
+    list.assign(source.end(), source.end());
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0u);
+
+    LinkedList<std::unique_ptr<int>> owners;
+    std::vector<std::unique_ptr<int>> pointers;
+    pointers.push_back(std::make_unique<int>(1));
+    pointers.push_back(std::make_unique<int>(2));
+    owners.append(std::make_move_iterator(pointers.begin()), std::make_move_iterator(pointers.end()));
+    ASSERT_EQ(*owners.back(), 2);
+    ASSERT_EQ(pointers.front(), nullptr);
+}
+
+TEST(LinkedListTest, AppendThrowingCopyLeavesListUnchanged) {
+    struct Throwing {
+        int value;
+        Throwing(int value) : value(value) {
+            if (value < 0) {
+                throw std::runtime_error("negative");
+            }
+        }
+        Throwing(const Throwing& other) : value(other.value) {
+            if (value < 0) {
+                throw std::runtime_error("negative");
+            }
+        }
+    };
+    LinkedList<Throwing> list;
+    list.emplace_back(1);
+    std::vector<Throwing> source;
+    source.reserve(4);
+    for (int value : {2, 3, 0, 4}) {
+        source.emplace_back(value);
+    }
+    source[2].value = -1;
+    ASSERT_THROW(list.append(source.begin(), source.end()), std::runtime_error);
+    ASSERT_THROW(list.assign(source.begin(), source.end()), std::runtime_error);
+    ASSERT_EQ(list.size(), 1u);
+    ASSERT_EQ(list.back().value, 1);
+    std::istringstream input("5 -1");
+    ASSERT_THROW(list.append(std::istream_iterator<int>(input), std::istream_iterator<int>()), std::runtime_error);
+    ASSERT_EQ(list.size(), 1u);
+}
+
+// узлы пачки лежат в памяти подряд в порядке списка, с одинаковым шагом
+TEST(LinkedListTest, BulkNodesAreContiguous) {
+    auto contiguous = [](const LinkedList<long>& list) {
+        std::vector<const long*> addresses;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            addresses.push_back(&*it);
+        }
+        const auto stride = reinterpret_cast<const char*>(addresses[1]) - reinterpret_cast<const char*>(addresses[0]);
+        for (std::size_t i = 1; i < addresses.size(); ++i) {
+            if (reinterpret_cast<const char*>(addresses[i]) - reinterpret_cast<const char*>(addresses[i - 1]) != stride) {
+                return false;
+            }
+        }
+        return stride > 0;
+    };
+    std::vector<long> source(1000);
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<long>(i);
+    }
+    LinkedList<long> list;
+    list.push_back(-1);
+    list.pop_front();
+    list.append(source.begin(), source.end());
+    ASSERT_TRUE(contiguous(list));
+    LinkedList<long> copy(list);
+    ASSERT_TRUE(contiguous(copy));
+    LinkedList<long> initialized {1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_TRUE(contiguous(initialized));
+    ASSERT_EQ(initialized.back(), 8);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
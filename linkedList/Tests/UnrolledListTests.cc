@@ -0,0 +1,262 @@
+#include "gtest/gtest.h"
+#include "../src/unrolled_list.h"
+#include <algorithm>
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// маленькая емкость блока, чтобы тесты пересекали границы блоков
+using SmallUnrolledList = UnrolledList<int, 3>;
+
+template <class List, class ForwardList>
+static void ExpectSameElements(const List& list, const ForwardList& flist) {
+    auto fit = flist.begin();
+    if (!list.empty()) {
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++fit) {
+            ASSERT_NE(fit, flist.end());
+            ASSERT_EQ(*it, *fit);
+        }
+    }
+    ASSERT_EQ(fit, flist.end());
+}
+
+TEST(UnrolledListTest, ConstructorDefault) {
+    SmallUnrolledList list;
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(UnrolledListTest, ConstructorInitializerList) {
+    SmallUnrolledList list {1, 2, 3, 4, 5, 6, 7};
+    std::forward_list<int> flist {1, 2, 3, 4, 5, 6, 7};
+    ExpectSameElements(list, flist);
+}
+
+TEST(UnrolledListTest, PushPopAcrossBlocks) {
+    SmallUnrolledList list;
+    std::forward_list<int> flist;
+    for (int i = 0; i < 10; ++i) {
+        list.push_front(i);
+        flist.push_front(i);
+        ASSERT_EQ(list.front(), flist.front());
+    }
+    ExpectSameElements(list, flist);
+    for (int i = 0; i < 7; ++i) {
+        list.pop_front();
+        flist.pop_front();
+        ExpectSameElements(list, flist);
+    }
+    for (int i = 0; i < 3; ++i) {
+        list.pop_front();
+    }
+    ASSERT_TRUE(list.empty());
+    list.pop_front();
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(UnrolledListTest, ConstructorCopy) {
+    SmallUnrolledList list {1, 2, 3, 4, 5};
+    list.push_front(0);
+    std::forward_list<int> flist {0, 1, 2, 3, 4, 5};
+    SmallUnrolledList copy(list);
+    list.pop_front();
+    ExpectSameElements(copy, flist);
+}
+
+TEST(UnrolledListTest, ConstructorMove) {
+    SmallUnrolledList list {1, 2, 3, 4};
+    SmallUnrolledList move(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ExpectSameElements(move, std::forward_list<int>{1, 2, 3, 4});
+}
+
+TEST(UnrolledListTest, AssignmentOperators) {
+    SmallUnrolledList list {1, 2, 3, 4};
+    SmallUnrolledList copy {9};
+    copy = list;
+    ExpectSameElements(copy, std::forward_list<int>{1, 2, 3, 4});
+    SmallUnrolledList move;
+    move = std::move(copy);
+    ASSERT_TRUE(copy.empty());
+    ExpectSameElements(move, std::forward_list<int>{1, 2, 3, 4});
+}
+
+TEST(UnrolledListTest, Find) {
+    SmallUnrolledList list {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 1; i <= 8; ++i) {
+        auto it = list.find(i);
+        ASSERT_NE(it, list.end());
+        ASSERT_EQ(*it, i);
+    }
+    ASSERT_EQ(list.find(9), list.end());
+    const SmallUnrolledList& list_const = list;
+    ASSERT_EQ(*list_const.find(5), 5);
+    ASSERT_EQ(list_const.find(0), list_const.cend());
+}
+
+TEST(UnrolledListTest, FindReturnsFirstMatch) {
+    SmallUnrolledList list {1, 7, 2, 7, 3};
+    auto it = list.find(7);
+    *it = 8;
+    ExpectSameElements(list, std::forward_list<int>{1, 8, 2, 7, 3});
+}
+
+TEST(UnrolledListTest, NonTrivialElements) {
+    UnrolledList<std::string, 2> list {"a", "b", "c"};
+    list.push_front(std::string(100, 'x'));
+    UnrolledList<std::string, 2> copy(list);
+    list.clear();
+    ExpectSameElements(copy, std::forward_list<std::string>{std::string(100, 'x'), "a", "b", "c"});
+}
+
+TEST(UnrolledListTest, DefaultCapacityFitsCacheLines) {
+    ASSERT_GT(UnrolledList<int>::block_capacity, 16u);
+    ASSERT_EQ(UnrolledList<std::string>::block_capacity, 3u);
+    ASSERT_LE(UnrolledList<int>::block_capacity * sizeof(int) + sizeof(void*) + sizeof(std::size_t), 128u);
+    ASSERT_LE(UnrolledList<double>::block_capacity * sizeof(double) + sizeof(void*) + sizeof(std::size_t), 128u);
+}
+
+// поиск по блокам должен совпадать с поэлементным поиском std::find по тем же данным
+template <class T>
+static void ExpectSearchMatchesScalar(const std::vector<T>& values, const std::vector<T>& needles) {
+    UnrolledList<T> list;
+    std::forward_list<T> flist;
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+        list.push_front(*it);
+        flist.push_front(*it);
+    }
+    for (const T& needle : needles) {
+        auto fit = std::find(flist.begin(), flist.end(), needle);
+        auto it = list.find(needle);
+        if (fit == flist.end()) {
+            ASSERT_EQ(it, list.end());
+        } else {
+            ASSERT_NE(it, list.end());
+            ASSERT_EQ(std::distance(flist.begin(), fit), std::distance(values.begin(), std::find(values.begin(), values.end(), needle)));
+            std::size_t position = 0;
+            for (auto walk = list.begin(); walk != it; ++walk) {
+                ++position;
+            }
+            ASSERT_EQ(position, static_cast<std::size_t>(std::distance(flist.begin(), fit)));
+        }
+        ASSERT_EQ(list.count(needle), static_cast<std::size_t>(std::count(flist.begin(), flist.end(), needle)));
+    }
+}
+
+template <class T>
+static std::vector<T> RandomValues(std::size_t size, int range, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> values;
+    for (std::size_t i = 0; i < size; ++i) {
+        values.push_back(static_cast<T>(static_cast<int>(gen() % static_cast<unsigned>(range)) - range / 2));
+    }
+    return values;
+}
+
+TEST(UnrolledListTest, VectorFindMatchesScalarForAllWidths) {
+    std::vector<int> needles;
+    for (int i = -60; i <= 60; ++i) {
+        needles.push_back(i);
+    }
+    for (std::size_t size : {0u, 1u, 7u, 33u, 1000u}) {
+        ExpectSearchMatchesScalar(RandomValues<signed char>(size, 100, 1), std::vector<signed char>(needles.begin(), needles.end()));
+        ExpectSearchMatchesScalar(RandomValues<short>(size, 100, 2), std::vector<short>(needles.begin(), needles.end()));
+        ExpectSearchMatchesScalar(RandomValues<int>(size, 100, 3), needles);
+        ExpectSearchMatchesScalar(RandomValues<unsigned>(size, 100, 4), std::vector<unsigned>(needles.begin(), needles.end()));
+        ExpectSearchMatchesScalar(RandomValues<long long>(size, 100, 5), std::vector<long long>(needles.begin(), needles.end()));
+        ExpectSearchMatchesScalar(RandomValues<float>(size, 100, 6), std::vector<float>(needles.begin(), needles.end()));
+        ExpectSearchMatchesScalar(RandomValues<double>(size, 100, 7), std::vector<double>(needles.begin(), needles.end()));
+    }
+}
+
+TEST(UnrolledListTest, VectorFindFloatingPointSemantics) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    UnrolledList<double> list {1.0, nan, -0.0, 2.0};
+    ASSERT_EQ(list.find(nan), list.end());
+    ASSERT_EQ(list.count(nan), 0u);
+    ASSERT_EQ(*list.find(0.0), 0.0);
+    ASSERT_EQ(list.count(0.0), 1u);
+    // 64-битные значения, совпадающие только одной половиной, не должны находиться
+    UnrolledList<long long> wide {0x100000001LL, 0x200000001LL};
+    ASSERT_EQ(wide.find(0x300000001LL), wide.end());
+    ASSERT_EQ(wide.count(0x200000001LL), 1u);
+}
+
+TEST(UnrolledListTest, FindIfAndCountIf) {
+    std::vector<int> values = RandomValues<int>(500, 1000, 8);
+    UnrolledList<int> list;
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+        list.push_front(*it);
+    }
+    auto big = [](int value) { return value > 480; };
+    auto vit = std::find_if(values.begin(), values.end(), big);
+    ASSERT_NE(vit, values.end());
+    ASSERT_EQ(*list.find_if(big), *vit);
+    const UnrolledList<int>& clist = list;
+    ASSERT_EQ(*clist.find_if(big), *vit);
+    ASSERT_EQ(list.find_if([](int value) { return value > 1000; }), list.end());
+    ASSERT_EQ(clist.count_if(big), static_cast<std::size_t>(std::count_if(values.begin(), values.end(), big)));
+    UnrolledList<std::string, 3> strings {"a", "bb", "ccc", "bb"};
+    ASSERT_EQ(*strings.find_if([](const std::string& s) { return s.size() == 3; }), "ccc");
+    ASSERT_EQ(strings.count("bb"), 2u);
+    ASSERT_EQ(strings.count_if([](const std::string& s) { return s.size() > 1; }), 3u);
+}
+
+// предикат вызывается не больше одного раза на элемент, даже в блоке с совпадением
+TEST(UnrolledListTest, FindIfCallsPredicateOncePerElement) {
+    UnrolledList<int> list;
+    for (int i = 0; i < 100; ++i) {
+        list.push_front(i);
+    }
+    std::size_t calls = 0;
+    ASSERT_EQ(list.find_if([&calls](int value) { ++calls; return value < 0; }), list.end());
+    ASSERT_EQ(calls, 100u);
+    calls = 0;
+    ASSERT_EQ(*list.find_if([&calls](int value) { ++calls; return value == 99; }), 99);
+    ASSERT_LE(calls, UnrolledList<int>::block_capacity);
+    calls = 0;
+    ASSERT_EQ(*list.find_if([&calls](int value) { ++calls; return value % 10 == 5; }), 95);
+    ASSERT_LE(calls, UnrolledList<int>::block_capacity);
+}
+
+TEST(UnrolledListTest, ArithmeticBlocksAreCacheLineAligned) {
+    UnrolledList<int> list {1, 2, 3};
+    const int* first_slot = &*list.find(3) - (UnrolledList<int>::block_capacity - 1);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(first_slot) % 64, 0u);
+}
+
+// процессор выбирает одно ядро, поэтому каждое ядро проверяется и напрямую
+template <class T>
+static void ExpectKernelsMatchStd(const std::vector<T>& values) {
+    const T* first = values.data();
+    const T* last = values.data() + values.size();
+    for (int needle = -60; needle <= 60; ++needle) {
+        const T value = static_cast<T>(needle);
+        const T* expected = std::find(first, last, value);
+        const std::size_t expected_count = static_cast<std::size_t>(std::count(first, last, value));
+        ASSERT_EQ(simd::find_scalar(first, last, value), expected);
+        ASSERT_EQ(simd::count_scalar(first, last, value), expected_count);
+#if SIMD_SEARCH_X86
+        ASSERT_EQ(simd::find_sse2(first, last, value), expected);
+        ASSERT_EQ(simd::count_sse2(first, last, value), expected_count);
+        if (__builtin_cpu_supports("avx2")) {
+            ASSERT_EQ(simd::find_avx2(first, last, value), expected);
+            ASSERT_EQ(simd::count_avx2(first, last, value), expected_count);
+        }
+#endif
+    }
+}
+
+TEST(UnrolledListTest, SimdKernelsMatchStdFind) {
+    for (std::size_t size : {0u, 3u, 31u, 64u, 257u}) {
+        ExpectKernelsMatchStd(RandomValues<signed char>(size, 100, 11));
+        ExpectKernelsMatchStd(RandomValues<short>(size, 100, 12));
+        ExpectKernelsMatchStd(RandomValues<int>(size, 100, 13));
+        ExpectKernelsMatchStd(RandomValues<long long>(size, 100, 14));
+        ExpectKernelsMatchStd(RandomValues<float>(size, 100, 15));
+        ExpectKernelsMatchStd(RandomValues<double>(size, 100, 16));
+    }
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "../src/work_stealing_pool.h"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+    for (std::size_t concurrency : {1u, 2u, 4u}) {
+        WorkStealingPool pool(concurrency);
+        ASSERT_EQ(pool.concurrency(), concurrency);
+        std::vector<std::atomic<int>> calls(1000);
+        pool.run(calls.size(), [&calls](std::size_t index) { ++calls[index]; });
+        for (const auto& count : calls) {
+            ASSERT_EQ(count.load(), 1);
+        }
+        pool.run(0, [](std::size_t) { FAIL(); });
+    }
+}
+
+// первая начатая задача не завершится, пока не выполнены все остальные: их обязаны разобрать другие потоки,
+// в том числе из очереди того потока, который застрял на ней
+TEST(WorkStealingPoolTest, IdleThreadsStealWork) {
+    WorkStealingPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> done{0};
+    std::atomic<bool> started{false};
+    pool.run(64, [&](std::size_t) {
+        if (!started.exchange(true)) {
+            while (done.load() < 63) {
+                std::this_thread::yield();
+            }
+        } else {
+            ++done;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    });
+    ASSERT_GE(threads.size(), 2u);
+}
+
+TEST(WorkStealingPoolTest, NestedRun) {
+    WorkStealingPool pool(3);
+    std::atomic<int> total{0};
+    pool.run(8, [&](std::size_t) {
+        pool.run(8, [&](std::size_t) { ++total; });
+    });
+    ASSERT_EQ(total.load(), 64);
+}
+
+TEST(WorkStealingPoolTest, FirstExceptionIsRethrown) {
+    for (std::size_t concurrency : {1u, 4u}) {
+        WorkStealingPool pool(concurrency);
+        std::atomic<int> calls{0};
+        ASSERT_THROW(pool.run(100, [&calls](std::size_t index) {
+            ++calls;
+            if (index == 3) {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+        ASSERT_LE(calls.load(), 100);
+        // пул остается рабочим
+        calls = 0;
+        pool.run(10, [&calls](std::size_t) { ++calls; });
+        ASSERT_EQ(calls.load(), 10);
+    }
+}
+
+TEST(WorkStealingPoolTest, RunFromSeveralThreads) {
+    WorkStealingPool pool(4);
+    std::atomic<int> total{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < 50; ++round) {
+                pool.run(16, [&total](std::size_t) { ++total; });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(total.load(), 4 * 50 * 16);
+}
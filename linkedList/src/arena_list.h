@@ -0,0 +1,537 @@
+#ifndef ARENA_LIST_H
+#define ARENA_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// односвязный список с тем же интерфейсом, что и LinkedList, узлы которого лежат в одном непрерывном массиве (арене)
+// вместо 8-байтного указателя узел хранит 32-битный индекс следующего узла, и нет заголовка кучи на каждый узел,
+// поэтому для int узел занимает 8 байт против 16 у LinkedList
+// освобожденные pop_front ячейки образуют список свободных и переиспользуются при следующей вставке
+
+// когда арена заполнена, она перевыделяется вдвое большей, и при переезде узлы раскладываются в порядке обхода
+// compact() делает то же без роста: после него обход - последовательное чтение памяти по возрастанию адресов
+// как и у vector, перевыделение и compact() делают недействительными все итераторы и ссылки на элементы
+// индексы 32-битные, поэтому элементов не больше 2^32 - 1
+
+template <class T, class Allocator = std::allocator<T>>
+class ArenaList {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using reference = T&;
+    using const_reference = const T&;
+
+    ArenaList();
+    explicit ArenaList(const Allocator& alloc);
+    ArenaList(const T& data);
+    ArenaList(const ArenaList& other);
+    ArenaList(ArenaList&& other) noexcept;
+    ArenaList(std::initializer_list<T> il);
+    ~ArenaList();
+
+    ArenaList& operator=(const ArenaList& other);
+    ArenaList& operator=(ArenaList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const;
+
+    reference front();
+    const_reference front() const;
+
+    class iterator;
+    class const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+    std::size_t capacity() const noexcept;
+    std::size_t memory_bytes() const noexcept;
+
+    void push_front(const T& value);
+    void push_front(T&& value);
+    template <class... Args>
+    reference emplace_front(Args&&... args);
+    void pop_front();
+    void clear() noexcept;
+
+    void reserve(std::size_t capacity);
+    void compact();
+
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::uint32_t next;
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* value() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+
+    static constexpr std::uint32_t kNull = UINT32_MAX;
+    static constexpr std::size_t kMaxCapacity = UINT32_MAX;
+    static constexpr std::size_t kFirstCapacity = 16;
+
+    template <bool Move, class Source>
+    Slot* lay_out(Source* slots, std::uint32_t head, std::size_t size, std::size_t capacity);
+    void rebuild(std::size_t capacity);
+    void release() noexcept;
+
+    slot_allocator alloc_;
+    Slot* slots_;
+    std::size_t capacity_;
+    std::size_t size_;
+    std::uint32_t used_;
+    std::uint32_t head_;
+    std::uint32_t free_;
+
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(Slot* slots, std::uint32_t index);
+
+        reference operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+    private:
+        Slot* slots_;
+        std::uint32_t index_;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        const_iterator(const Slot* slots, std::uint32_t index);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const Slot* slots_;
+        std::uint32_t index_;
+    };
+};
+
+// =============================================================================
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList() : ArenaList(Allocator()) {}
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList(const Allocator& alloc)
+    : alloc_(alloc), slots_(nullptr), capacity_(0), size_(0), used_(0), head_(kNull), free_(kNull) {}
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList(const T& data) : ArenaList() {
+    push_front(data);
+}
+
+// копия сразу получает раскладку в порядке обхода и арену ровно под элементы оригинала
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList(const ArenaList& other)
+    : ArenaList(slot_traits::select_on_container_copy_construction(other.alloc_)) {
+    if (other.size_) {
+        slots_ = lay_out<false>(other.slots_, other.head_, other.size_, other.size_);
+        capacity_ = other.size_;
+        size_ = other.size_;
+        used_ = static_cast<std::uint32_t>(size_);
+        head_ = 0;
+    }
+}
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList(ArenaList&& other) noexcept
+    : alloc_(other.alloc_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+      used_(other.used_), head_(other.head_), free_(other.free_) {
+    other.slots_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+    other.used_ = 0;
+    other.head_ = kNull;
+    other.free_ = kNull;
+}
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::ArenaList(std::initializer_list<T> il) : ArenaList() {
+    try {
+        reserve(il.size());
+        for (auto it = il.end(); it != il.begin();) {
+            --it;
+            push_front(*it);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::~ArenaList() {
+    release();
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>& ArenaList<T, Allocator>::operator=(const ArenaList& other) {
+    if (this != &other) {
+        if constexpr (slot_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) {
+                release();
+                alloc_ = other.alloc_;
+            }
+        }
+        Slot* copy = other.size_ ? lay_out<false>(other.slots_, other.head_, other.size_, other.size_) : nullptr;
+        release();
+        slots_ = copy;
+        capacity_ = other.size_;
+        size_ = other.size_;
+        used_ = static_cast<std::uint32_t>(size_);
+        head_ = size_ ? 0 : kNull;
+    }
+    return *this;
+}
+
+// при неравных и нераспространяемых аллокаторах элементы перемещаются в новую арену своего аллокатора
+template <class T, class Allocator>
+ArenaList<T, Allocator>& ArenaList<T, Allocator>::operator=(ArenaList&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this != &other) {
+        release();
+        if constexpr (slot_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = other.alloc_;
+        } else if (alloc_ != other.alloc_) {
+            if (other.size_) {
+                slots_ = lay_out<true>(other.slots_, other.head_, other.size_, other.size_);
+                capacity_ = other.size_;
+                size_ = other.size_;
+                used_ = static_cast<std::uint32_t>(size_);
+                head_ = 0;
+            }
+            other.release();
+            return *this;
+        }
+        slots_ = other.slots_;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        used_ = other.used_;
+        head_ = other.head_;
+        free_ = other.free_;
+        other.slots_ = nullptr;
+        other.capacity_ = 0;
+        other.size_ = 0;
+        other.used_ = 0;
+        other.head_ = kNull;
+        other.free_ = kNull;
+    }
+    return *this;
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::allocator_type ArenaList<T, Allocator>::get_allocator() const {
+    return allocator_type(alloc_);
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::reference ArenaList<T, Allocator>::front() {
+    if (head_ == kNull) {
+        throw std::runtime_error("ArenaList is empty");
+    }
+    return *slots_[head_].value();
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_reference ArenaList<T, Allocator>::front() const {
+    if (head_ == kNull) {
+        throw std::runtime_error("ArenaList is empty");
+    }
+    return *slots_[head_].value();
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::iterator ArenaList<T, Allocator>::begin() {
+    if (head_ == kNull) {
+        throw std::runtime_error("ArenaList is empty");
+    }
+    return iterator(slots_, head_);
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::iterator ArenaList<T, Allocator>::end() {
+    return iterator(slots_, kNull);
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_iterator ArenaList<T, Allocator>::cbegin() const {
+    if (head_ == kNull) {
+        throw std::runtime_error("ArenaList is empty");
+    }
+    return const_iterator(slots_, head_);
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_iterator ArenaList<T, Allocator>::cend() const {
+    return const_iterator(slots_, kNull);
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+bool ArenaList<T, Allocator>::empty() const noexcept {
+    return head_ == kNull;
+}
+
+template <class T, class Allocator>
+std::size_t ArenaList<T, Allocator>::size() const noexcept {
+    return size_;
+}
+
+template <class T, class Allocator>
+std::size_t ArenaList<T, Allocator>::capacity() const noexcept {
+    return capacity_;
+}
+
+// байты, занятые ареной, включая свободные ячейки
+template <class T, class Allocator>
+std::size_t ArenaList<T, Allocator>::memory_bytes() const noexcept {
+    return capacity_ * sizeof(Slot);
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::push_front(const T& value) {
+    emplace_front(value);
+}
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::push_front(T&& value) {
+    emplace_front(std::move(value));
+}
+
+// ячейка берется из списка свободных, иначе следующая нетронутая ячейка арены
+// она считается занятой только после успешного конструирования элемента
+// аргументы могут ссылаться на элемент этого же списка, который при перевыделении переедет, а старая арена
+// освободится, поэтому перед ростом новый элемент сначала создается отдельно и потом переносится в новую арену
+template <class T, class Allocator>
+template <class... Args>
+typename ArenaList<T, Allocator>::reference ArenaList<T, Allocator>::emplace_front(Args&&... args) {
+    if (free_ == kNull && used_ == capacity_) {
+        if (capacity_ == kMaxCapacity) {
+            throw std::runtime_error("ArenaList is full");
+        }
+        const std::size_t grown = capacity_ ? capacity_ * 2 : kFirstCapacity;
+        T value(std::forward<Args>(args)...);
+        rebuild(grown < kMaxCapacity ? grown : kMaxCapacity);
+        return emplace_front(std::move(value));
+    }
+    const std::uint32_t index = free_ != kNull ? free_ : used_;
+    Slot& slot = slots_[index];
+    ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+    if (index == free_) {
+        free_ = slot.next;
+    } else {
+        ++used_;
+    }
+    slot.next = head_;
+    head_ = index;
+    ++size_;
+    return *slot.value();
+}
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::pop_front() {
+    if (head_ != kNull) {
+        Slot& slot = slots_[head_];
+        const std::uint32_t next = slot.next;
+        slot.value()->~T();
+        slot.next = free_;
+        free_ = head_;
+        head_ = next;
+        --size_;
+    }
+}
+
+// элементы уничтожаются, а арена остается для следующих вставок
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::clear() noexcept {
+    for (std::uint32_t i = head_; i != kNull; i = slots_[i].next) {
+        slots_[i].value()->~T();
+    }
+    size_ = 0;
+    used_ = 0;
+    head_ = kNull;
+    free_ = kNull;
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::reserve(std::size_t capacity) {
+    if (capacity > kMaxCapacity) {
+        throw std::runtime_error("ArenaList is full");
+    }
+    if (capacity > capacity_) {
+        rebuild(capacity);
+    }
+}
+
+// перекладывает узлы в порядке обхода в начало новой арены того же размера
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::compact() {
+    if (size_) {
+        rebuild(capacity_);
+    }
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::iterator ArenaList<T, Allocator>::find(const T& value) {
+    for (std::uint32_t i = head_; i != kNull; i = slots_[i].next) {
+        if (*slots_[i].value() == value) {
+            return iterator(slots_, i);
+        }
+    }
+    return end();
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_iterator ArenaList<T, Allocator>::find(const T& value) const {
+    for (std::uint32_t i = head_; i != kNull; i = slots_[i].next) {
+        if (*slots_[i].value() == value) {
+            return const_iterator(slots_, i);
+        }
+    }
+    return cend();
+}
+
+// =============================================================================
+
+// выделяет арену на capacity ячеек и кладет в ячейки [0, size) элементы цепочки, начинающейся с head, по порядку
+// Move выбирает перемещение (move_if_noexcept) или копирование
+// при исключении уже созданные элементы уничтожаются, новая арена освобождается, источник не меняется
+template <class T, class Allocator>
+template <bool Move, class Source>
+typename ArenaList<T, Allocator>::Slot* ArenaList<T, Allocator>::lay_out(Source* slots, std::uint32_t head, std::size_t size, std::size_t capacity) {
+    Slot* fresh = slot_traits::allocate(alloc_, capacity);
+    std::size_t built = 0;
+    try {
+        for (std::uint32_t i = head; i != kNull; i = slots[i].next) {
+            if constexpr (Move) {
+                ::new (static_cast<void*>(fresh[built].storage)) T(std::move_if_noexcept(*slots[i].value()));
+            } else {
+                ::new (static_cast<void*>(fresh[built].storage)) T(*slots[i].value());
+            }
+            fresh[built].next = built + 1 < size ? static_cast<std::uint32_t>(built + 1) : kNull;
+            ++built;
+        }
+    } catch (...) {
+        for (std::size_t i = 0; i < built; ++i) {
+            fresh[i].value()->~T();
+        }
+        slot_traits::deallocate(alloc_, fresh, capacity);
+        throw;
+    }
+    return fresh;
+}
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::rebuild(std::size_t capacity) {
+    Slot* fresh = lay_out<true>(slots_, head_, size_, capacity);
+    const std::size_t size = size_;
+    release();
+    slots_ = fresh;
+    capacity_ = capacity;
+    size_ = size;
+    used_ = static_cast<std::uint32_t>(size);
+    head_ = size ? 0 : kNull;
+}
+
+template <class T, class Allocator>
+void ArenaList<T, Allocator>::release() noexcept {
+    clear();
+    if (slots_) {
+        slot_traits::deallocate(alloc_, slots_, capacity_);
+    }
+    slots_ = nullptr;
+    capacity_ = 0;
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::iterator::iterator(Slot* slots, std::uint32_t index) : slots_(slots), index_(index) {}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::reference ArenaList<T, Allocator>::iterator::operator*() const {
+    return *slots_[index_].value();
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::iterator& ArenaList<T, Allocator>::iterator::operator++() {
+    index_ = slots_[index_].next;
+    return *this;
+}
+
+template <class T, class Allocator>
+bool ArenaList<T, Allocator>::iterator::operator==(const iterator& other) const {
+    return slots_ == other.slots_ && index_ == other.index_;
+}
+
+template <class T, class Allocator>
+bool ArenaList<T, Allocator>::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+template <class T, class Allocator>
+ArenaList<T, Allocator>::const_iterator::const_iterator(const Slot* slots, std::uint32_t index) : slots_(slots), index_(index) {}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_reference ArenaList<T, Allocator>::const_iterator::operator*() const {
+    return *slots_[index_].value();
+}
+
+template <class T, class Allocator>
+typename ArenaList<T, Allocator>::const_iterator& ArenaList<T, Allocator>::const_iterator::operator++() {
+    index_ = slots_[index_].next;
+    return *this;
+}
+
+template <class T, class Allocator>
+bool ArenaList<T, Allocator>::const_iterator::operator==(const const_iterator& other) const {
+    return slots_ == other.slots_ && index_ == other.index_;
+}
+
+template <class T, class Allocator>
+bool ArenaList<T, Allocator>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+#endif  // ARENA_LIST_H
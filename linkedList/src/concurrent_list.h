@@ -0,0 +1,141 @@
+#ifndef CONCURRENT_LIST_H
+#define CONCURRENT_LIST_H
+
+#include <atomic>
+#include <optional>
+#include "epoch_domain.h"
+
+// потокобезопасный односвязный список без блокировок (стек Трайбера)
+// узлы устроены так же, как в LinkedList: значение и указатель на следующий узел
+// next записывается до публикации узла и дальше не меняется, поэтому атомарной является только голова,
+// push_front и pop_front меняют ее через compare_exchange
+
+// извлеченный узел нельзя сразу освободить: другой поток мог успеть прочитать его в pop_front или find
+// поэтому все обращения к узлам выполняются внутри EpochDomain::Guard, а извлеченные узлы уходят в retire
+// пока узел не освобожден, его нельзя переиспользовать, так что проблема ABA в compare_exchange не возникает
+
+// front и итераторы не предоставляются, так как ссылка на элемент может пережить сам узел
+// pop_front возвращает копию значения, поскольку параллельный find может в этот момент читать тот же узел
+// узлы выделяются через new, а не через PoolAllocator, потому что пул не потокобезопасен
+
+template <class T>
+class ConcurrentList {
+public:
+    using value_type = T;
+
+    ConcurrentList() = default;
+    ConcurrentList(const ConcurrentList&) = delete;
+    ConcurrentList& operator=(const ConcurrentList&) = delete;
+    ~ConcurrentList();
+
+    bool empty() const noexcept;
+
+    void push_front(const T& value);
+    void push_front(T&& value);
+    std::optional<T> pop_front();
+
+    bool contains(const T& value) const;
+    template <class Predicate>
+    std::optional<T> find_if(Predicate predicate) const;
+
+private:
+    struct Node {
+        value_type data;
+        Node* next;
+
+        Node(const value_type& data) : data(data), next(nullptr) {}
+        Node(value_type&& data) : data(std::move(data)), next(nullptr) {}
+    };
+
+    static void reclaim_node(void* node);
+    void link_front(Node* node) noexcept;
+
+    std::atomic<Node*> head_{nullptr};
+};
+
+// =============================================================================
+
+// деструктор не может выполняться одновременно с другими операциями, поэтому узлы удаляются сразу
+template <class T>
+ConcurrentList<T>::~ConcurrentList() {
+    Node* node = head_.load(std::memory_order_relaxed);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+// =============================================================================
+
+template <class T>
+bool ConcurrentList<T>::empty() const noexcept {
+    return head_.load(std::memory_order_acquire) == nullptr;
+}
+
+// =============================================================================
+
+template <class T>
+void ConcurrentList<T>::push_front(const T& value) {
+    link_front(new Node(value));
+}
+
+template <class T>
+void ConcurrentList<T>::push_front(T&& value) {
+    link_front(new Node(std::move(value)));
+}
+
+template <class T>
+std::optional<T> ConcurrentList<T>::pop_front() {
+    EpochDomain::Guard guard;
+    Node* head = head_.load(std::memory_order_acquire);
+    while (head && !head_.compare_exchange_weak(head, head->next, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+    }
+    if (!head) {
+        return std::nullopt;
+    }
+    // узел освобождается не раньше выхода из guard, поэтому копировать значение можно и после retire
+    EpochDomain::instance().retire(head, &ConcurrentList::reclaim_node);
+    return std::optional<T>(head->data);
+}
+
+// =============================================================================
+
+// обход идет по снимку списка на момент чтения головы
+// извлеченные во время обхода узлы остаются живыми до выхода из Guard, их next по-прежнему ведет дальше
+template <class T>
+bool ConcurrentList<T>::contains(const T& value) const {
+    return find_if([&value](const T& data) { return data == value; }).has_value();
+}
+
+template <class T>
+template <class Predicate>
+std::optional<T> ConcurrentList<T>::find_if(Predicate predicate) const {
+    EpochDomain::Guard guard;
+    for (const Node* node = head_.load(std::memory_order_acquire); node; node = node->next) {
+        if (predicate(node->data)) {
+            return node->data;
+        }
+    }
+    return std::nullopt;
+}
+
+// =============================================================================
+
+template <class T>
+void ConcurrentList<T>::reclaim_node(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+// до успешного compare_exchange узел никому не виден, поэтому next пишется обычной записью
+template <class T>
+void ConcurrentList<T>::link_front(Node* node) noexcept {
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+// =============================================================================
+
+#endif  // CONCURRENT_LIST_H
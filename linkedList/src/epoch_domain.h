@@ -0,0 +1,228 @@
+#ifndef EPOCH_DOMAIN_H
+#define EPOCH_DOMAIN_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// эпохальное освобождение памяти (epoch-based reclamation) для lock-free структур
+// поток, читающий разделяемые узлы, держит Guard, который объявляет текущую глобальную эпоху
+// удаленный из структуры узел передается в retire и освобождается только тогда,
+// когда глобальная эпоха продвинулась на два шага с момента retire,
+// а эпоха может продвинуться только если все закрепленные потоки уже видели предыдущую
+// поэтому читатель, получивший указатель внутри Guard, не увидит освобожденной памяти до выхода из Guard
+
+// ThreadSanitizer не поддерживает atomic_thread_fence (GCC предупреждает -Wtsan, а с -Werror это ошибка сборки),
+// поэтому под ним пара "seq_cst запись + барьер" в pin заменяется на seq_cst exchange, а "чтение + барьер"
+// в try_advance - на fetch_add(0): атомарные операции чтения-записи с seq_cst упорядочивают так же, и TSan их понимает
+#if defined(__SANITIZE_THREAD__)
+#define EPOCH_DOMAIN_NO_FENCE 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define EPOCH_DOMAIN_NO_FENCE 1
+#endif
+#endif
+
+// домен один на процесс, у каждого потока своя запись, которая переиспользуется после завершения потока
+// записи и отложенные объекты, которые не успели освободить, удаляются вместе с доменом при выходе из программы
+
+class EpochDomain {
+public:
+    class Guard {
+    public:
+        Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard();
+    };
+
+    static EpochDomain& instance();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+    ~EpochDomain();
+
+    void retire(void* object, void (*reclaim)(void*));
+    void collect();
+
+    std::uint64_t epoch() const noexcept;
+
+private:
+    struct Retired {
+        void* object;
+        void (*reclaim)(void*);
+        std::uint64_t epoch;
+    };
+
+    // младший бит announced означает, что поток находится внутри Guard
+    struct alignas(64) Record {
+        std::atomic<std::uint64_t> announced{0};
+        std::atomic<bool> in_use{true};
+        Record* next = nullptr;
+        unsigned nesting = 0;
+        std::size_t collect_at = kCollectThreshold;
+        std::vector<Retired> retired;
+    };
+
+    struct ThreadHandle {
+        Record* record = nullptr;
+        ~ThreadHandle();
+    };
+
+    static constexpr std::size_t kCollectThreshold = 128;
+
+    EpochDomain() = default;
+
+    Record* local_record();
+    void pin();
+    void unpin() noexcept;
+    bool try_advance() noexcept;
+    void reclaim(Record* record) noexcept;
+
+    std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<Record*> records_{nullptr};
+};
+
+// =============================================================================
+
+inline EpochDomain::Guard::Guard() {
+    EpochDomain::instance().pin();
+}
+
+inline EpochDomain::Guard::~Guard() {
+    EpochDomain::instance().unpin();
+}
+
+// =============================================================================
+
+inline EpochDomain& EpochDomain::instance() {
+    static EpochDomain domain;
+    return domain;
+}
+
+inline EpochDomain::~EpochDomain() {
+    Record* record = records_.load();
+    while (record) {
+        for (const Retired& retired : record->retired) {
+            retired.reclaim(retired.object);
+        }
+        Record* next = record->next;
+        delete record;
+        record = next;
+    }
+}
+
+// объект освобождается функцией reclaim, когда ни один поток уже не может держать на него указатель
+// вызывающий поток должен убрать объект из структуры до вызова retire
+inline void EpochDomain::retire(void* object, void (*reclaim)(void*)) {
+    Record* record = local_record();
+    record->retired.push_back(Retired{object, reclaim, epoch_.load()});
+    if (record->retired.size() >= record->collect_at) {
+        collect();
+    }
+}
+
+// пытается продвинуть эпоху и освобождает объекты текущего потока, которые стали недоступны
+inline void EpochDomain::collect() {
+    try_advance();
+    reclaim(local_record());
+}
+
+inline std::uint64_t EpochDomain::epoch() const noexcept {
+    return epoch_.load();
+}
+
+// =============================================================================
+
+// запись берется из списка освобожденных записей, а если таких нет, добавляется новая
+inline EpochDomain::Record* EpochDomain::local_record() {
+    thread_local ThreadHandle handle;
+    if (handle.record) {
+        return handle.record;
+    }
+    for (Record* record = records_.load(); record; record = record->next) {
+        bool free = false;
+        if (!record->in_use.load() && record->in_use.compare_exchange_strong(free, true)) {
+            handle.record = record;
+            return record;
+        }
+    }
+    Record* record = new Record();
+    Record* head = records_.load();
+    do {
+        record->next = head;
+    } while (!records_.compare_exchange_weak(head, record));
+    handle.record = record;
+    return record;
+}
+
+// seq_cst запись объявленной эпохи упорядочивает ее с последующими чтениями структуры
+inline void EpochDomain::pin() {
+    Record* record = local_record();
+    if (record->nesting++ == 0) {
+#ifdef EPOCH_DOMAIN_NO_FENCE
+        record->announced.exchange((epoch_.load() << 1) | 1);
+#else
+        record->announced.store((epoch_.load() << 1) | 1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+    }
+}
+
+inline void EpochDomain::unpin() noexcept {
+    Record* record = local_record();
+    if (--record->nesting == 0) {
+        record->announced.store(0, std::memory_order_release);
+    }
+}
+
+// эпоха продвигается, только если все потоки внутри Guard объявили текущую эпоху
+inline bool EpochDomain::try_advance() noexcept {
+#ifdef EPOCH_DOMAIN_NO_FENCE
+    std::uint64_t current = epoch_.fetch_add(0);
+#else
+    std::uint64_t current = epoch_.load();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+    for (Record* record = records_.load(); record; record = record->next) {
+        const std::uint64_t announced = record->announced.load();
+        if ((announced & 1) && (announced >> 1) != current) {
+            return false;
+        }
+    }
+    return epoch_.compare_exchange_strong(current, current + 1);
+}
+
+inline void EpochDomain::reclaim(Record* record) noexcept {
+    const std::uint64_t current = epoch_.load();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < record->retired.size(); ++i) {
+        const Retired retired = record->retired[i];
+        if (retired.epoch + 2 <= current) {
+            retired.reclaim(retired.object);
+        } else {
+            record->retired[kept++] = retired;
+        }
+    }
+    record->retired.resize(kept);
+    // если эпоху держит вытесненный поток, объекты копятся, и порог растет вместе с ними,
+    // чтобы каждый следующий retire не сканировал весь список заново
+    record->collect_at = kept * 2 > kCollectThreshold ? kept * 2 : kCollectThreshold;
+}
+
+// =============================================================================
+
+// при завершении потока его отложенные объекты остаются в записи
+// и будут освобождены потоком, который займет запись, или доменом при выходе из программы
+inline EpochDomain::ThreadHandle::~ThreadHandle() {
+    if (record) {
+        EpochDomain::instance().try_advance();
+        EpochDomain::instance().reclaim(record);
+        record->in_use.store(false);
+    }
+}
+
+// =============================================================================
+
+#endif  // EPOCH_DOMAIN_H
@@ -0,0 +1,657 @@
+#ifndef INDEXED_LIST_H
+#define INDEXED_LIST_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include "pool_allocator.h"
+
+// односвязный список с хеш-индексом от значения к узлу, find работает за O(1) в среднем
+// полезен для долгоживущих списков, которые в основном читают через find
+
+// индекс хранит для каждого различного значения первый в порядке обхода узел с этим значением,
+// а равные узлы связаны между собой цепочкой next_equal в порядке обхода
+// push_front ставит новый узел в начало цепочки, pop_front снимает первый узел цепочки,
+// поэтому find возвращает тот же первый совпадающий элемент, что и линейный поиск в LinkedList
+
+// индекс - таблица с открытой адресацией и линейным пробированием, в ячейке хранится узел и хеш значения
+// память индекса - bucket_count() ячеек таблицы плюс поле next_equal в каждом узле, ее показывает index_memory()
+// max_load_factor задает заполненность, после которой таблица удваивается, reserve выделяет место заранее
+// элементы нельзя менять через итератор, иначе индекс разойдется со списком, поэтому итератор только константный
+
+template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>, class Allocator = PoolAllocator<T>>
+class IndexedList {
+public:
+    using value_type = T;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = T&;
+    using const_reference = const T&;
+
+    IndexedList();
+    explicit IndexedList(const Allocator& alloc);
+    IndexedList(const T& data);
+    IndexedList(const IndexedList& other);
+    IndexedList(IndexedList&& other) noexcept;
+    IndexedList(std::initializer_list<T> il);
+    ~IndexedList();
+
+    IndexedList& operator=(const IndexedList& other);
+    IndexedList& operator=(IndexedList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const;
+
+    const_reference front() const;
+
+    class const_iterator;
+    using iterator = const_iterator;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+
+    void push_front(const T& value);
+    void push_front(T&& value);
+    void pop_front();
+    void clear() noexcept;
+
+    const_iterator find(const T& value) const;
+    std::size_t count(const T& value) const;
+
+    std::size_t bucket_count() const noexcept;
+    std::size_t index_memory() const noexcept;
+    float load_factor() const noexcept;
+    float max_load_factor() const noexcept;
+    void max_load_factor(float factor);
+    void reserve(std::size_t distinct_values);
+
+private:
+    struct Node {
+        value_type data;
+        Node* next;
+        Node* next_equal;
+
+        Node(const value_type& data) : data(data), next(nullptr), next_equal(nullptr) {}
+        Node(value_type&& data) : data(std::move(data)), next(nullptr), next_equal(nullptr) {}
+    };
+
+    struct Slot {
+        Node* node;
+        std::size_t hash;
+    };
+
+    static constexpr std::size_t kMinBuckets = 8;
+
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+
+    template <class U>
+    void emplace_front_value(U&& value);
+    Slot* lookup(const T& value, std::size_t hash) const;
+    Slot* prepare_slot(const T& value, std::size_t hash);
+    void erase_slot(Slot* slot) noexcept;
+    void rehash(std::size_t buckets);
+    void rebuild_index();
+    void release_table() noexcept;
+    bool needs_growth(std::size_t distinct_values) const noexcept;
+
+    template <class... Args>
+    Node* create_node(Args&&... args);
+    void destroy_node(Node* node) noexcept;
+    Node* copy_nodes(const Node* first);
+
+    Hash hash_;
+    KeyEqual equal_;
+    node_allocator node_alloc_;
+    slot_allocator slot_alloc_;
+    Node* head_;
+    std::size_t size_;
+    Slot* slots_;
+    std::size_t buckets_;
+    std::size_t distinct_;
+    float max_load_factor_;
+
+public:
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        explicit const_iterator(const Node* node);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const Node* node_;
+    };
+};
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList() : IndexedList(Allocator()) {}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList(const Allocator& alloc)
+    : hash_(), equal_(), node_alloc_(alloc), slot_alloc_(alloc), head_(nullptr), size_(0),
+      slots_(nullptr), buckets_(0), distinct_(0), max_load_factor_(0.5f) {}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList(const T& data) : IndexedList() {
+    push_front(data);
+}
+
+// индекс копии строится заново, поскольку ссылается на узлы копии
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList(const IndexedList& other)
+    : IndexedList(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    max_load_factor_ = other.max_load_factor_;
+    head_ = copy_nodes(other.head_);
+    size_ = other.size_;
+    try {
+        rebuild_index();
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList(IndexedList&& other) noexcept
+    : hash_(other.hash_), equal_(other.equal_), node_alloc_(other.node_alloc_), slot_alloc_(other.slot_alloc_),
+      head_(other.head_), size_(other.size_), slots_(other.slots_), buckets_(other.buckets_),
+      distinct_(other.distinct_), max_load_factor_(other.max_load_factor_) {
+    other.head_ = nullptr;
+    other.size_ = 0;
+    other.slots_ = nullptr;
+    other.buckets_ = 0;
+    other.distinct_ = 0;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::IndexedList(std::initializer_list<T> il) : IndexedList() {
+    try {
+        for (auto it = il.end(); it != il.begin();) {
+            --it;
+            push_front(*it);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::~IndexedList() {
+    clear();
+    release_table();
+}
+
+// =============================================================================
+
+// таблица сохраняется и переиспользуется, индекс перестраивается по новым узлам
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>& IndexedList<T, Hash, KeyEqual, Allocator>::operator=(const IndexedList& other) {
+    if (this != &other) {
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+            if (node_alloc_ != other.node_alloc_) {
+                clear();
+                release_table();
+                node_alloc_ = other.node_alloc_;
+                slot_alloc_ = other.slot_alloc_;
+            }
+        }
+        Node* copy = copy_nodes(other.head_);
+        clear();
+        hash_ = other.hash_;
+        equal_ = other.equal_;
+        max_load_factor_ = other.max_load_factor_;
+        head_ = copy;
+        size_ = other.size_;
+        try {
+            rebuild_index();
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    return *this;
+}
+
+// узлы и таблица забираются целиком, если аллокатор распространяется или аллокаторы равны,
+// иначе элементы перемещаются в новые узлы и индекс строится заново
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>& IndexedList<T, Hash, KeyEqual, Allocator>::operator=(IndexedList&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    max_load_factor_ = other.max_load_factor_;
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+        release_table();
+        node_alloc_ = other.node_alloc_;
+        slot_alloc_ = other.slot_alloc_;
+    } else if (node_alloc_ != other.node_alloc_) {
+        // новые узлы собираются в отдельную цепочку и попадают в список только целиком,
+        // иначе исключение из перемещения оставило бы в списке узлы, которых нет в индексе
+        Node* head = nullptr;
+        Node** tail = &head;
+        try {
+            for (Node* node = other.head_; node; node = node->next) {
+                *tail = create_node(std::move(node->data));
+                tail = &(*tail)->next;
+            }
+        } catch (...) {
+            while (head) {
+                Node* next = head->next;
+                destroy_node(head);
+                head = next;
+            }
+            throw;
+        }
+        head_ = head;
+        size_ = other.size_;
+        try {
+            rebuild_index();
+        } catch (...) {
+            clear();
+            throw;
+        }
+        other.clear();
+        return *this;
+    } else {
+        release_table();
+    }
+    head_ = other.head_;
+    size_ = other.size_;
+    slots_ = other.slots_;
+    buckets_ = other.buckets_;
+    distinct_ = other.distinct_;
+    other.head_ = nullptr;
+    other.size_ = 0;
+    other.slots_ = nullptr;
+    other.buckets_ = 0;
+    other.distinct_ = 0;
+    return *this;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::allocator_type IndexedList<T, Hash, KeyEqual, Allocator>::get_allocator() const {
+    return allocator_type(node_alloc_);
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_reference IndexedList<T, Hash, KeyEqual, Allocator>::front() const {
+    if (!head_) {
+        throw std::runtime_error("IndexedList is empty");
+    }
+    return head_->data;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator IndexedList<T, Hash, KeyEqual, Allocator>::begin() const {
+    return cbegin();
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator IndexedList<T, Hash, KeyEqual, Allocator>::end() const {
+    return cend();
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator IndexedList<T, Hash, KeyEqual, Allocator>::cbegin() const {
+    if (!head_) {
+        throw std::runtime_error("IndexedList is empty");
+    }
+    return const_iterator(head_);
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator IndexedList<T, Hash, KeyEqual, Allocator>::cend() const {
+    return const_iterator(nullptr);
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool IndexedList<T, Hash, KeyEqual, Allocator>::empty() const noexcept {
+    return head_ == nullptr;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+std::size_t IndexedList<T, Hash, KeyEqual, Allocator>::size() const noexcept {
+    return size_;
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::push_front(const T& value) {
+    emplace_front_value(value);
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::push_front(T&& value) {
+    emplace_front_value(std::move(value));
+}
+
+// головной узел всегда первый в своей цепочке равных, поэтому ячейка переходит к следующему равному
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::pop_front() {
+    if (!head_) {
+        return;
+    }
+    Slot* slot = lookup(head_->data, hash_(head_->data));
+    if (head_->next_equal) {
+        slot->node = head_->next_equal;
+    } else {
+        erase_slot(slot);
+    }
+    Node* next = head_->next;
+    destroy_node(head_);
+    head_ = next;
+    --size_;
+}
+
+// таблица сохраняет размер, чтобы повторное заполнение не проходило через рост заново
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::clear() noexcept {
+    while (head_) {
+        Node* next = head_->next;
+        destroy_node(head_);
+        head_ = next;
+    }
+    for (std::size_t i = 0; i < buckets_; ++i) {
+        slots_[i].node = nullptr;
+    }
+    size_ = 0;
+    distinct_ = 0;
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator IndexedList<T, Hash, KeyEqual, Allocator>::find(const T& value) const {
+    if (distinct_ == 0) {
+        return cend();
+    }
+    const Slot* slot = lookup(value, hash_(value));
+    return const_iterator(slot->node);
+}
+
+// проходит только по цепочке равных, а не по всему списку
+template <class T, class Hash, class KeyEqual, class Allocator>
+std::size_t IndexedList<T, Hash, KeyEqual, Allocator>::count(const T& value) const {
+    std::size_t result = 0;
+    if (distinct_ == 0) {
+        return result;
+    }
+    for (const Node* node = lookup(value, hash_(value))->node; node; node = node->next_equal) {
+        ++result;
+    }
+    return result;
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+std::size_t IndexedList<T, Hash, KeyEqual, Allocator>::bucket_count() const noexcept {
+    return buckets_;
+}
+
+// таблица индекса и поле next_equal, которое индекс добавляет к каждому узлу
+template <class T, class Hash, class KeyEqual, class Allocator>
+std::size_t IndexedList<T, Hash, KeyEqual, Allocator>::index_memory() const noexcept {
+    return buckets_ * sizeof(Slot) + size_ * sizeof(Node*);
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+float IndexedList<T, Hash, KeyEqual, Allocator>::load_factor() const noexcept {
+    return buckets_ == 0 ? 0.0f : static_cast<float>(distinct_) / static_cast<float>(buckets_);
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+float IndexedList<T, Hash, KeyEqual, Allocator>::max_load_factor() const noexcept {
+    return max_load_factor_;
+}
+
+// при открытой адресации таблица должна оставаться частично пустой, поэтому factor ограничен (0, 0.95]
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::max_load_factor(float factor) {
+    if (!(factor > 0.0f && factor <= 0.95f)) {
+        throw std::invalid_argument("IndexedList max_load_factor must be in (0, 0.95]");
+    }
+    max_load_factor_ = factor;
+    if (needs_growth(distinct_)) {
+        reserve(distinct_);
+    }
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::reserve(std::size_t distinct_values) {
+    std::size_t buckets = buckets_ == 0 ? kMinBuckets : buckets_;
+    while (static_cast<float>(distinct_values) > static_cast<float>(buckets) * max_load_factor_) {
+        buckets *= 2;
+    }
+    if (buckets != buckets_) {
+        rehash(buckets);
+    }
+}
+
+// =============================================================================
+
+// место в таблице резервируется до создания узла, поэтому исключение не оставляет список и индекс рассогласованными
+template <class T, class Hash, class KeyEqual, class Allocator>
+template <class U>
+void IndexedList<T, Hash, KeyEqual, Allocator>::emplace_front_value(U&& value) {
+    const std::size_t hash = hash_(value);
+    Slot* slot = prepare_slot(value, hash);
+    Node* node = create_node(std::forward<U>(value));
+    if (slot->node) {
+        node->next_equal = slot->node;
+    } else {
+        slot->hash = hash;
+        ++distinct_;
+    }
+    slot->node = node;
+    node->next = head_;
+    head_ = node;
+    ++size_;
+}
+
+// возвращает ячейку с равным значением или первую пустую ячейку на пути пробирования
+// число корзин - степень двойки, поэтому индекс берется маской
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::Slot* IndexedList<T, Hash, KeyEqual, Allocator>::lookup(const T& value, std::size_t hash) const {
+    const std::size_t mask = buckets_ - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        Slot* slot = slots_ + i;
+        if (!slot->node || (slot->hash == hash && equal_(slot->node->data, value))) {
+            return slot;
+        }
+    }
+}
+
+// ячейка для значения, которое сейчас будет добавлено: таблица растет, только если такого значения в ней еще нет,
+// так как повтор встает в цепочку равных и новой ячейки не занимает
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::Slot* IndexedList<T, Hash, KeyEqual, Allocator>::prepare_slot(const T& value, std::size_t hash) {
+    Slot* slot = buckets_ ? lookup(value, hash) : nullptr;
+    if ((!slot || !slot->node) && needs_growth(distinct_ + 1)) {
+        reserve(distinct_ + 1);
+        slot = lookup(value, hash);
+    }
+    return slot;
+}
+
+// удаление со сдвигом назад: следующие ячейки той же серии подтягиваются на освободившееся место,
+// поэтому метки удаленных ячеек не нужны и поиск не замедляется со временем
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::erase_slot(Slot* slot) noexcept {
+    const std::size_t mask = buckets_ - 1;
+    std::size_t hole = static_cast<std::size_t>(slot - slots_);
+    for (std::size_t i = (hole + 1) & mask; slots_[i].node; i = (i + 1) & mask) {
+        const std::size_t home = slots_[i].hash & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            slots_[hole] = slots_[i];
+            hole = i;
+        }
+    }
+    slots_[hole].node = nullptr;
+    --distinct_;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::rehash(std::size_t buckets) {
+    Slot* slots = slot_traits::allocate(slot_alloc_, buckets);
+    for (std::size_t i = 0; i < buckets; ++i) {
+        slots[i] = Slot{nullptr, 0};
+    }
+    Slot* old_slots = slots_;
+    const std::size_t old_buckets = buckets_;
+    slots_ = slots;
+    buckets_ = buckets;
+    for (std::size_t i = 0; i < old_buckets; ++i) {
+        if (old_slots[i].node) {
+            for (std::size_t j = old_slots[i].hash & (buckets - 1);; j = (j + 1) & (buckets - 1)) {
+                if (!slots[j].node) {
+                    slots[j] = old_slots[i];
+                    break;
+                }
+            }
+        }
+    }
+    if (old_slots) {
+        slot_traits::deallocate(slot_alloc_, old_slots, old_buckets);
+    }
+}
+
+// строит индекс по готовой цепочке узлов за один проход от начала к концу
+// пока идет проход, ячейка указывает на последний встреченный равный узел, а цепочка равных замкнута в кольцо:
+// у последнего узла next_equal указывает на первый, после прохода кольца размыкаются, а ячейки переводятся на первые узлы
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::rebuild_index() {
+    for (Node* node = head_; node; node = node->next) {
+        const std::size_t hash = hash_(node->data);
+        Slot* slot = prepare_slot(node->data, hash);
+        if (slot->node) {
+            node->next_equal = slot->node->next_equal;
+            slot->node->next_equal = node;
+        } else {
+            node->next_equal = node;
+            slot->hash = hash;
+            ++distinct_;
+        }
+        slot->node = node;
+    }
+    for (std::size_t i = 0; i < buckets_; ++i) {
+        if (Node* last = slots_[i].node) {
+            slots_[i].node = last->next_equal;
+            last->next_equal = nullptr;
+        }
+    }
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::release_table() noexcept {
+    if (slots_) {
+        slot_traits::deallocate(slot_alloc_, slots_, buckets_);
+    }
+    slots_ = nullptr;
+    buckets_ = 0;
+    distinct_ = 0;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool IndexedList<T, Hash, KeyEqual, Allocator>::needs_growth(std::size_t distinct_values) const noexcept {
+    return static_cast<float>(distinct_values) > static_cast<float>(buckets_) * max_load_factor_;
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+template <class... Args>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::Node* IndexedList<T, Hash, KeyEqual, Allocator>::create_node(Args&&... args) {
+    Node* node = node_traits::allocate(node_alloc_, 1);
+    try {
+        node_traits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+        node_traits::deallocate(node_alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void IndexedList<T, Hash, KeyEqual, Allocator>::destroy_node(Node* node) noexcept {
+    node_traits::destroy(node_alloc_, node);
+    node_traits::deallocate(node_alloc_, node, 1);
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::Node* IndexedList<T, Hash, KeyEqual, Allocator>::copy_nodes(const Node* first) {
+    Node* head = nullptr;
+    Node** tail = &head;
+    try {
+        for (; first; first = first->next) {
+            *tail = create_node(first->data);
+            tail = &(*tail)->next;
+        }
+    } catch (...) {
+        while (head) {
+            Node* next = head->next;
+            destroy_node(head);
+            head = next;
+        }
+        throw;
+    }
+    return head;
+}
+
+// =============================================================================
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator::const_iterator(const Node* node) : node_(node) {}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_reference IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator::operator*() const {
+    return node_->data;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+typename IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator& IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator::operator++() {
+    node_ = node_->next;
+    return *this;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator::operator==(const const_iterator& other) const {
+    return node_ == other.node_;
+}
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool IndexedList<T, Hash, KeyEqual, Allocator>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+#endif  // INDEXED_LIST_H
@@ -0,0 +1,287 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stdexcept>
+
+// интрузивный односвязный список: ссылка на следующий элемент хранится в самом объекте, в поле-крючке IntrusiveHook
+// список не выделяет память и не копирует объекты, он только связывает объекты, которыми владеет кто-то другой
+// крючок задается указателем на член, поэтому объект с несколькими крючками может одновременно состоять в нескольких списках:
+//     struct Task { IntrusiveHook<Task> by_owner; IntrusiveHook<Task> by_queue; };
+//     IntrusiveList<Task, &Task::by_owner> owned;
+//     IntrusiveList<Task, &Task::by_queue> queued;
+// через один крючок объект может состоять только в одном списке
+// объект должен жить дольше, чем состоит в списке; уничтожение списка объекты не трогает
+
+template <class T>
+struct IntrusiveHook {
+    T* next = nullptr;
+};
+
+template <class T, IntrusiveHook<T> T::*Hook>
+class IntrusiveList {
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+
+    IntrusiveList() noexcept;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList(IntrusiveList&& other) noexcept;
+    ~IntrusiveList() = default;
+
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept;
+
+    reference front();
+    const_reference front() const;
+
+    class iterator;
+    class const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+
+    void push_front(T& value) noexcept;
+    void pop_front() noexcept;
+    void clear() noexcept;
+
+    iterator insert_after(iterator pos, T& value) noexcept;
+    iterator erase_after(iterator pos) noexcept;
+
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+
+private:
+    static T*& next(T* value) noexcept;
+
+    T* head_;
+
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        explicit iterator(T* value);
+
+        reference operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+    private:
+        friend class IntrusiveList;
+        T* value_;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        explicit const_iterator(const T* value);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const T* value_;
+    };
+};
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList() noexcept : head_(nullptr) {}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList(IntrusiveList&& other) noexcept : head_(other.head_) {
+    other.head_ = nullptr;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>& IntrusiveList<T, Hook>::operator=(IntrusiveList&& other) noexcept {
+    if (this != &other) {
+        head_ = other.head_;
+        other.head_ = nullptr;
+    }
+    return *this;
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::reference IntrusiveList<T, Hook>::front() {
+    if (!head_) {
+        throw std::runtime_error("IntrusiveList is empty");
+    }
+    return *head_;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_reference IntrusiveList<T, Hook>::front() const {
+    if (!head_) {
+        throw std::runtime_error("IntrusiveList is empty");
+    }
+    return *head_;
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::begin() {
+    if (!head_) {
+        throw std::runtime_error("IntrusiveList is empty");
+    }
+    return iterator(head_);
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::end() {
+    return iterator(nullptr);
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::cbegin() const {
+    if (!head_) {
+        throw std::runtime_error("IntrusiveList is empty");
+    }
+    return const_iterator(head_);
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::cend() const {
+    return const_iterator(nullptr);
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::empty() const noexcept {
+    return head_ == nullptr;
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::push_front(T& value) noexcept {
+    next(&value) = head_;
+    head_ = &value;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::pop_front() noexcept {
+    if (head_) {
+        T* first = head_;
+        head_ = next(first);
+        next(first) = nullptr;
+    }
+}
+
+// объекты только отвязываются от головы, их крючки не обнуляются, поэтому clear работает за O(1)
+template <class T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::clear() noexcept {
+    head_ = nullptr;
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::insert_after(iterator pos, T& value) noexcept {
+    next(&value) = next(pos.value_);
+    next(pos.value_) = &value;
+    return iterator(&value);
+}
+
+// отвязывает элемент после pos и возвращает итератор на следующий за ним
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::erase_after(iterator pos) noexcept {
+    T* removed = next(pos.value_);
+    next(pos.value_) = next(removed);
+    next(removed) = nullptr;
+    return iterator(next(pos.value_));
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::find(const T& value) {
+    for (T* current = head_; current; current = next(current)) {
+        if (*current == value) {
+            return iterator(current);
+        }
+    }
+    return end();
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::find(const T& value) const {
+    for (const T* current = head_; current; current = (current->*Hook).next) {
+        if (*current == value) {
+            return const_iterator(current);
+        }
+    }
+    return cend();
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+T*& IntrusiveList<T, Hook>::next(T* value) noexcept {
+    return (value->*Hook).next;
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::iterator::iterator(T* value) : value_(value) {}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::reference IntrusiveList<T, Hook>::iterator::operator*() const {
+    return *value_;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator& IntrusiveList<T, Hook>::iterator::operator++() {
+    value_ = next(value_);
+    return *this;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::iterator::operator==(const iterator& other) const {
+    return value_ == other.value_;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+template <class T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::const_iterator::const_iterator(const T* value) : value_(value) {}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_reference IntrusiveList<T, Hook>::const_iterator::operator*() const {
+    return *value_;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator& IntrusiveList<T, Hook>::const_iterator::operator++() {
+    value_ = (value_->*Hook).next;
+    return *this;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::const_iterator::operator==(const const_iterator& other) const {
+    return value_ == other.value_;
+}
+
+template <class T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+#endif  // INTRUSIVE_LIST_H
@@ -1,307 +1,1150 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "list_stats.h"
+#include "pool_allocator.h"
 // реализованы правило пяти
 // реализованы итераторы
 // реализованы операторы присваивания
 // реализованы методы доступа к элементам
 // реализованы методы добавления и удаления
 // реалзиованы методы поиска
+// реализованы алгоритмы над узлами: sort, merge, reverse, unique, remove_if, insert_after, erase_after, splice_after
+// реализовано создание элементов на месте: emplace_front, emplace_after, поддерживаются типы только с перемещением
+// реализован режим очереди: size и back за O(1), push_back, emplace_back, append и assign пачкой
+// реализована необязательная статистика: третий параметр шаблона ListStats или сборка с -DLINKED_LIST_STATS
+// реализовано освобождение всех узлов одной цепочкой и отложенное уничтожение списка в фоновом потоке
+// реализованы параллельные for_each, count_if, find_first и копирование на пуле потоков (parallel_list.h)
 
 // изначально начал писать учитывая что head_ имеет тип unique_ptr
 // однако позже узнал, что есть не очевидная проблема в использование unique_ptr, связанная с рекусривный удалением
 // проблему решил написав деструктор
+// позже узлы перешли на выделение через аллокатор (по умолчанию PoolAllocator), а next стал обычным указателем,
+// поскольку unique_ptr с удалителем по умолчанию не умеет возвращать память в аллокатор
+// владение узлами теперь целиком на стороне списка: create_node и destroy_node
 // в остальном функционал повторяет forward_list из стандрантной библиотеки, тесты тому подтверждение
 
-template <class T>
+// для операций *_after голова хранится как узел-заглушка NodeBase без данных, на него указывает before_begin()
+// алгоритмы только перевязывают существующие узлы и не выделяют память и не копируют элементы
+// исключение - merge и splice_after между списками с неравными аллокаторами: чужие узлы нельзя освободить своим
+// аллокатором, поэтому элементы перемещаются в новые узлы; у списков с общим get_allocator() этого не происходит
+
+// элемент конструируется прямо в узле из аргументов emplace_*, rvalue в push_front и insert_after перемещается,
+// поэтому LinkedList<std::unique_ptr<X>> работает без копий; методы, которым нужна копия (копирование списка,
+// push_front(const T&), initializer_list), инстанцируются только при использовании
+// take_front перемещает первый элемент наружу и удаляет узел
+
+// pmr::LinkedList<T> берет узлы из std::pmr::memory_resource, который передается в конструктор
+// конструкторы с дополнительным аргументом-аллокатором позволяют выбрать ресурс для копии или перемещенного списка
+// если T тривиально разрушаем, а ресурс - monotonic_buffer_resource, освобождение узла ничего не делает,
+// поэтому clear и деструктор не обходят список, а просто забывают узлы: память вернется целиком вместе с ресурсом
+// сами элементы аллокатор списка не получают, pmr::LinkedList<std::pmr::string> хранит строки в ресурсе по умолчанию
+
+// список помнит последний узел tail_ (или &head_, если пуст) и число элементов, поэтому годится как очередь FIFO:
+// push_back в хвост, pop_front или take_front с головы; каждый метод, который перевязывает узлы, поправляет оба поля
+// clear, деструктор и присваивания отдают все узлы аллокатору одной цепочкой через deallocate_chain, если он это умеет:
+// с PoolAllocator уничтожение списка - один проход, который разрушает узлы и тут же связывает их память, без
+// поиска класса размера в пуле на каждый узел
+// чтобы не платить и за обход, большой список можно отдать фоновому потоку через ListReclaimer (list_reclaimer.h)
+// append и assign сначала строят из диапазона целую цепочку и только потом привязывают ее за одно действие,
+// при исключении цепочка освобождается, а список остается прежним; тем же путем идут копирование и initializer_list
+// если длина диапазона известна заранее (прямые итераторы), а аллокатор умеет allocate_run, как PoolAllocator,
+// узлы пачки берутся одним отрезком и лежат в памяти подряд в порядке списка
+
+// со Stats = ListStats список считает выделения, пиковый размер, копирования узлов, шаги итераторов
+// и длины find (см. list_stats.h), stats() возвращает снимок; с NoListStats подсчет компилируется в ничто
+
+// параллельные алгоритмы (parallel_list.h) обходят узлы напрямую и строят копию в одном отрезке узлов
+struct ListParallel;
+template <class List>
+class ListPartition;
+
+template <class T, class Allocator = PoolAllocator<T>, class Stats = DefaultListStats>
 class LinkedList {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
     using reference = T&;
     using const_reference = const T&;
 
     LinkedList();
+    explicit LinkedList(const Allocator& alloc);
     LinkedList(const T& data);
     LinkedList(const LinkedList& other);
+    LinkedList(const LinkedList& other, const Allocator& alloc);
     LinkedList(LinkedList&& other) noexcept;
+    LinkedList(LinkedList&& other, const Allocator& alloc);
     LinkedList(std::initializer_list<T> il);
+    LinkedList(std::initializer_list<T> il, const Allocator& alloc);
     ~LinkedList();
 
     LinkedList& operator=(const LinkedList& other);
-    LinkedList& operator=(LinkedList&& other) noexcept;
+    LinkedList& operator=(LinkedList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const;
 
     reference front();
     const_reference front() const;
+    reference back();
+    const_reference back() const;
 
     class iterator;
     class const_iterator;
+    iterator before_begin() noexcept;
+    const_iterator cbefore_begin() const noexcept;
     iterator begin();
     iterator end();
     const_iterator cbegin() const;
     const_iterator cend() const;
 
     bool empty() const noexcept;
+    std::size_t size() const noexcept;
 
     void push_front(const T& value);
-    void push_front(T&& value) noexcept;
+    void push_front(T&& value);
+    template <class... Args>
+    reference emplace_front(Args&&... args);
     void pop_front();
-    
+    value_type take_front();
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    template <class InputIt>
+    void append(InputIt first, InputIt last);
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> il);
+    void clear() noexcept;
+
+    iterator insert_after(const_iterator pos, const T& value);
+    iterator insert_after(const_iterator pos, T&& value);
+    template <class... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args);
+    iterator erase_after(const_iterator pos);
+    void splice_after(const_iterator pos, LinkedList& other);
+    void splice_after(const_iterator pos, LinkedList&& other);
+    void splice_after(const_iterator pos, LinkedList& other, const_iterator it);
+
+    void merge(LinkedList& other);
+    void merge(LinkedList&& other);
+    template <class Compare>
+    void merge(LinkedList& other, Compare compare);
+    void sort();
+    template <class Compare>
+    void sort(Compare compare);
+    void reverse() noexcept;
+    std::size_t unique();
+    template <class BinaryPredicate>
+    std::size_t unique(BinaryPredicate predicate);
+    template <class Predicate>
+    std::size_t remove_if(Predicate predicate);
+
     iterator find(const T& value);
     const_iterator find(const T& value) const;
 
+    ListStats stats() const noexcept;
+    void reset_stats() noexcept;
 
 private:
-    struct Node {
+    friend struct ListParallel;
+    template <class List>
+    friend class ListPartition;
+
+    struct NodeBase {
+        NodeBase* next;
+
+        NodeBase() : next(nullptr) {}
+    };
+
+    struct Node : NodeBase {
         value_type data;
-        std::unique_ptr<Node> next;
 
-        Node(const value_type& data) : data(data), next(nullptr) {}
+        template <class... Args>
+        Node(Args&&... args) : NodeBase(), data(std::forward<Args>(args)...) {}
     };
 
-    std::unique_ptr<Node> head_;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    // готовая, но еще не привязанная к списку цепочка узлов
+    struct Chain {
+        NodeBase* first;
+        NodeBase* last;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t kUnknownSize = static_cast<std::size_t>(-1);
+
+    static Node* as_node(NodeBase* node) noexcept;
+    static const Node* as_node(const NodeBase* node) noexcept;
+    template <class Compare>
+    static NodeBase* merge_nodes(NodeBase*& left, NodeBase*& right, Compare& compare);
+
+    template <class... Args>
+    Node* create_node(Args&&... args);
+    void destroy_node(NodeBase* node) noexcept;
+    bool skips_destruction() const noexcept;
+    void destroy_chain(NodeBase* first) noexcept;
+    void release_nodes(NodeBase* first, NodeBase* last, std::size_t count) noexcept;
+    template <class InputIt>
+    static std::size_t range_size(InputIt first, InputIt last);
+    template <class InputIt>
+    Chain make_chain(InputIt first, InputIt last, std::size_t count);
+    void link_chain_after(NodeBase* pos, const Chain& chain) noexcept;
+    template <class... Args>
+    iterator link_after(NodeBase* pos, Args&&... args);
+    void move_elements_after(NodeBase* pos, LinkedList& other);
+    void take_nodes(LinkedList& other) noexcept;
+    iterator make_iterator(NodeBase* node) const noexcept;
+    const_iterator make_const_iterator(const NodeBase* node) const noexcept;
+
+    node_allocator alloc_;
+    NodeBase head_;
+    NodeBase* tail_;
+    std::size_t size_;
+    [[no_unique_address]] mutable Stats stats_;
 
 public:
     class iterator {
     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
         iterator() = default;
-        explicit iterator(Node* node);
+        explicit iterator(NodeBase* node);
 
         reference operator*() const;
         iterator& operator++();
         bool operator==(const iterator& other) const;
         bool operator!=(const iterator& other) const;
     private:
-        Node* node_;
+        friend class LinkedList;
+        iterator(NodeBase* node, StatsLink<Stats> link);
+
+        NodeBase* node_;
+        [[no_unique_address]] StatsLink<Stats> link_;
     };
 
     class const_iterator {
     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
         const_iterator() = default;
-        explicit const_iterator(const Node* node);
-        
+        explicit const_iterator(const NodeBase* node);
+        const_iterator(const iterator& it);
+
         const_iterator& operator=(const const_iterator&) = delete;
         const_reference operator*() const;
         const_iterator& operator++();
         bool operator==(const const_iterator& other) const;
         bool operator!=(const const_iterator& other) const;
     private:
-        const Node* node_;
+        friend class LinkedList;
+        const_iterator(const NodeBase* node, StatsLink<Stats> link);
+
+        const NodeBase* node_;
+        [[no_unique_address]] StatsLink<Stats> link_;
     };
 
 };
 
 // =============================================================================
 
-template <class T>
-LinkedList<T>::LinkedList() : head_(nullptr) {} 
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList() : LinkedList(Allocator()) {}
 
-template <class T>
-LinkedList<T>::LinkedList(const T& data) : head_(std::make_unique<Node>(data)) {}
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(const Allocator& alloc)
+    : alloc_(alloc), head_(), tail_(&head_), size_(0), stats_() {}
 
-template <class T>
-LinkedList<T>::LinkedList(const LinkedList& other) : head_(nullptr) {
-    if (!other.head_) return;
-    head_ = std::make_unique<Node>(other.head_->data);
-    Node* current = head_.get();
-    Node* otherCurrent = other.head_->next.get();
-    while (otherCurrent) {
-        current->next = std::make_unique<Node>(otherCurrent->data);
-        current = current->next.get();
-        otherCurrent = otherCurrent->next.get();
-    }
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(const T& data) : LinkedList() {
+    link_after(&head_, data);
 }
 
+// копия получает собственный аллокатор через select_on_container_copy_construction
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(const LinkedList& other)
+    : LinkedList(other, node_traits::select_on_container_copy_construction(other.alloc_)) {}
 
-template <class T>
-LinkedList<T>::LinkedList(LinkedList&& other) noexcept : head_(std::move(other.head_)) {}
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(const LinkedList& other, const Allocator& alloc) : LinkedList(alloc) {
+    link_chain_after(&head_, make_chain(const_iterator(other.head_.next), const_iterator(nullptr), other.size_));
+    stats_.on_copy(size_);
+}
 
-template <class T>
-LinkedList<T>::LinkedList(std::initializer_list<T> il) : head_(nullptr) {
-    for (auto it = il.end(); it != il.begin();) {
-        --it;
-        push_front(*it);
-    }
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(LinkedList&& other) noexcept : LinkedList(Allocator(other.alloc_)) {
+    take_nodes(other);
 }
 
-template <class T>
-LinkedList<T>::~LinkedList() {
-    while (head_) {
-        head_ = std::move(head_->next);
+// узлы забираются, только если alloc равен аллокатору other, иначе элементы перемещаются в новые узлы
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(LinkedList&& other, const Allocator& alloc) : LinkedList(alloc) {
+    if (alloc_ == other.alloc_) {
+        take_nodes(other);
+    } else {
+        move_elements_after(&head_, other);
     }
 }
 
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(std::initializer_list<T> il) : LinkedList(il, Allocator()) {}
+
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::LinkedList(std::initializer_list<T> il, const Allocator& alloc) : LinkedList(alloc) {
+    link_chain_after(&head_, make_chain(il.begin(), il.end(), il.size()));
+}
+
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::~LinkedList() {
+    clear();
+}
+
 // =============================================================================
 
-template <class T>
-LinkedList<T>& LinkedList<T>::operator=(const LinkedList& other) {
+// новая цепочка строится аллокатором этого списка, старая освобождается только после успешного копирования
+// если аллокатор распространяется при копировании, старые узлы освобождаются прежним аллокатором
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>& LinkedList<T, Allocator, Stats>::operator=(const LinkedList& other) {
     if (this != &other) {
-        LinkedList temp(other);
-        std::swap(head_, temp.head_);
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) {
+                clear();
+                alloc_ = other.alloc_;
+            }
+        }
+        const Chain copy = make_chain(const_iterator(other.head_.next), const_iterator(nullptr), other.size_);
+        clear();
+        link_chain_after(&head_, copy);
+        stats_.on_copy(copy.size);
     }
     return *this;
 }
 
-template <class T>
-LinkedList<T>& LinkedList<T>::operator=(LinkedList&& other) noexcept {
+// если аллокатор не распространяется при перемещении и аллокаторы не равны,
+// узлы другого списка нельзя забрать себе, поэтому элементы перемещаются поштучно
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>& LinkedList<T, Allocator, Stats>::operator=(LinkedList&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
     if (this != &other) {
-        head_ = std::move(other.head_);
-        other.head_ = nullptr;
+        clear();
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = other.alloc_;
+        } else if (alloc_ != other.alloc_) {
+            move_elements_after(&head_, other);
+            return *this;
+        }
+        take_nodes(other);
     }
     return *this;
 }
 
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::allocator_type LinkedList<T, Allocator, Stats>::get_allocator() const {
+    return allocator_type(alloc_);
+}
+
 // =============================================================================
 
-template <class T>
-typename LinkedList<T>::reference LinkedList<T>::front() {
-    if (!head_) {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::reference LinkedList<T, Allocator, Stats>::front() {
+    if (!head_.next) {
         throw std::runtime_error("LinkedList is empty");
     }
-    return head_->data;
+    return as_node(head_.next)->data;
 }
 
-template <class T>
-typename LinkedList<T>::const_reference LinkedList<T>::front() const {
-    if (!head_) {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_reference LinkedList<T, Allocator, Stats>::front() const {
+    if (!head_.next) {
+        throw std::runtime_error("LinkedList is empty");
+    }
+    return as_node(head_.next)->data;
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::reference LinkedList<T, Allocator, Stats>::back() {
+    if (!head_.next) {
         throw std::runtime_error("LinkedList is empty");
     }
-    return head_->data;
+    return as_node(tail_)->data;
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_reference LinkedList<T, Allocator, Stats>::back() const {
+    if (!head_.next) {
+        throw std::runtime_error("LinkedList is empty");
+    }
+    return as_node(tail_)->data;
 }
 
 // =============================================================================
 
-template <class T>
-typename LinkedList<T>::iterator LinkedList<T>::begin() {
-    if (!head_) {
+// итератор перед первым элементом, разыменовывать его нельзя, он служит позицией для *_after
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::before_begin() noexcept {
+    return make_iterator(&head_);
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator LinkedList<T, Allocator, Stats>::cbefore_begin() const noexcept {
+    return make_const_iterator(&head_);
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::begin() {
+    if (!head_.next) {
         throw std::runtime_error("LinkedList is empty");
     }
-    return iterator(head_.get());
+    return make_iterator(head_.next);
 }
 
-template <class T>
-typename LinkedList<T>::iterator LinkedList<T>::end() {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::end() {
     return iterator(nullptr);
 }
 
-template <class T>
-typename LinkedList<T>::const_iterator LinkedList<T>::cbegin() const {
-    if (!head_) {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator LinkedList<T, Allocator, Stats>::cbegin() const {
+    if (!head_.next) {
         throw std::runtime_error("LinkedList is empty");
     }
-    return const_iterator(head_.get());
+    return make_const_iterator(head_.next);
 }
 
-template <class T>
-typename LinkedList<T>::const_iterator LinkedList<T>::cend() const {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator LinkedList<T, Allocator, Stats>::cend() const {
     return const_iterator(nullptr);
 }
 
 // =============================================================================
 
-template <class T>
-bool LinkedList<T>::empty() const noexcept {
-    return head_ == nullptr;
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::empty() const noexcept {
+    return head_.next == nullptr;
+}
+
+template <class T, class Allocator, class Stats>
+std::size_t LinkedList<T, Allocator, Stats>::size() const noexcept {
+    return size_;
 }
 
 // =============================================================================
 
-template <class T>
-void LinkedList<T>::push_front(const T& value) {
-    auto temp = std::make_unique<Node>(value);
-    temp->next = std::move(head_);
-    head_ = std::move(temp);
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::push_front(const T& value) {
+    link_after(&head_, value);
 }
 
-template <class T>
-void LinkedList<T>::push_front(T&& value) noexcept {
-    auto temp = std::make_unique<Node>(std::move(value));
-    temp->next = std::move(head_);
-    head_ = std::move(temp);
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::push_front(T&& value) {
+    link_after(&head_, std::move(value));
 }
 
-template <class T>
-void LinkedList<T>::pop_front() {
-    if (head_) {
-        head_ = std::move(head_->next);
+template <class T, class Allocator, class Stats>
+template <class... Args>
+typename LinkedList<T, Allocator, Stats>::reference LinkedList<T, Allocator, Stats>::emplace_front(Args&&... args) {
+    return *link_after(&head_, std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::pop_front() {
+    if (head_.next) {
+        erase_after(cbefore_begin());
+    }
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::value_type LinkedList<T, Allocator, Stats>::take_front() {
+    if (!head_.next) {
+        throw std::runtime_error("LinkedList is empty");
+    }
+    value_type value = std::move(as_node(head_.next)->data);
+    erase_after(cbefore_begin());
+    return value;
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::push_back(const T& value) {
+    link_after(tail_, value);
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::push_back(T&& value) {
+    link_after(tail_, std::move(value));
+}
+
+template <class T, class Allocator, class Stats>
+template <class... Args>
+typename LinkedList<T, Allocator, Stats>::reference LinkedList<T, Allocator, Stats>::emplace_back(Args&&... args) {
+    return *link_after(tail_, std::forward<Args>(args)...);
+}
+
+// добавляет элементы диапазона в конец, при исключении список не меняется
+template <class T, class Allocator, class Stats>
+template <class InputIt>
+void LinkedList<T, Allocator, Stats>::append(InputIt first, InputIt last) {
+    link_chain_after(tail_, make_chain(first, last, range_size(first, last)));
+}
+
+// старые элементы удаляются только после того, как построена новая цепочка, поэтому диапазон может быть частью этого же списка
+template <class T, class Allocator, class Stats>
+template <class InputIt>
+void LinkedList<T, Allocator, Stats>::assign(InputIt first, InputIt last) {
+    const Chain chain = make_chain(first, last, range_size(first, last));
+    clear();
+    link_chain_after(&head_, chain);
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::assign(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+}
+
+// узлы освобождаются в цикле, а не рекурсивно, поэтому длинный список не переполняет стек
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::clear() noexcept {
+    if (skips_destruction()) {
+        stats_.on_free(size_);
+    } else if (head_.next) {
+        release_nodes(head_.next, tail_, size_);
     }
+    head_.next = nullptr;
+    tail_ = &head_;
+    size_ = 0;
 }
 
 // =============================================================================
 
-template <class T>
-typename LinkedList<T>::iterator LinkedList<T>::find(const T& value) {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::insert_after(const_iterator pos, const T& value) {
+    return link_after(const_cast<NodeBase*>(pos.node_), value);
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::insert_after(const_iterator pos, T&& value) {
+    return link_after(const_cast<NodeBase*>(pos.node_), std::move(value));
+}
+
+template <class T, class Allocator, class Stats>
+template <class... Args>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::emplace_after(const_iterator pos, Args&&... args) {
+    return link_after(const_cast<NodeBase*>(pos.node_), std::forward<Args>(args)...);
+}
+
+// удаляет элемент после pos и возвращает итератор на следующий за удаленным
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::erase_after(const_iterator pos) {
+    NodeBase* prev = const_cast<NodeBase*>(pos.node_);
+    NodeBase* node = prev->next;
+    prev->next = node->next;
+    if (node == tail_) {
+        tail_ = prev;
+    }
+    --size_;
+    destroy_node(node);
+    return make_iterator(prev->next);
+}
+
+// переносит все элементы other после pos, other остается пустым
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::splice_after(const_iterator pos, LinkedList& other) {
+    NodeBase* prev = const_cast<NodeBase*>(pos.node_);
+    if (&other == this || !other.head_.next) {
+        return;
+    }
+    if (alloc_ != other.alloc_) {
+        move_elements_after(prev, other);
+        return;
+    }
+    NodeBase* last = other.tail_;
+    last->next = prev->next;
+    prev->next = other.head_.next;
+    if (prev == tail_) {
+        tail_ = last;
+    }
+    size_ += other.size_;
+    stats_.on_grow(size_);
+    other.head_.next = nullptr;
+    other.tail_ = &other.head_;
+    other.size_ = 0;
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::splice_after(const_iterator pos, LinkedList&& other) {
+    splice_after(pos, other);
+}
+
+// переносит один элемент, следующий за it в other, на место после pos, как forward_list::splice_after
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::splice_after(const_iterator pos, LinkedList& other, const_iterator it) {
+    NodeBase* prev = const_cast<NodeBase*>(pos.node_);
+    NodeBase* before = const_cast<NodeBase*>(it.node_);
+    NodeBase* node = before->next;
+    if (!node || node == prev || before == prev) {
+        return;
+    }
+    if (alloc_ != other.alloc_) {
+        link_after(prev, std::move(as_node(node)->data));
+        other.erase_after(it);
+        return;
+    }
+    before->next = node->next;
+    if (node == other.tail_) {
+        other.tail_ = before;
+    }
+    --other.size_;
+    node->next = prev->next;
+    prev->next = node;
+    if (prev == tail_) {
+        tail_ = node;
+    }
+    ++size_;
+    stats_.on_grow(size_);
+}
+
+// =============================================================================
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::merge(LinkedList& other) {
+    merge(other, std::less<T>());
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::merge(LinkedList&& other) {
+    merge(other, std::less<T>());
+}
+
+// оба списка должны быть отсортированы по compare, при равенстве элементы этого списка идут первыми
+template <class T, class Allocator, class Stats>
+template <class Compare>
+void LinkedList<T, Allocator, Stats>::merge(LinkedList& other, Compare compare) {
+    if (&other == this || !other.head_.next) {
+        return;
+    }
+    if (alloc_ != other.alloc_) {
+        NodeBase* prev = &head_;
+        while (other.head_.next) {
+            while (prev->next && !compare(as_node(other.head_.next)->data, as_node(prev->next)->data)) {
+                prev = prev->next;
+            }
+            link_after(prev, std::move(as_node(other.head_.next)->data));
+            prev = prev->next;
+            other.pop_front();
+        }
+        return;
+    }
+    // последним остается узел, у которого после слияния нет следующего: либо прежний хвост этого списка, либо хвост other
+    // если compare бросает исключение, все узлы other уже в этом списке (merge_nodes собирает их в head_.next)
+    NodeBase* own_tail = tail_;
+    try {
+        head_.next = merge_nodes(head_.next, other.head_.next, compare);
+        tail_ = own_tail != &head_ && !own_tail->next ? own_tail : other.tail_;
+    } catch (...) {
+        while (tail_->next) {
+            tail_ = tail_->next;
+        }
+        size_ += other.size_;
+        stats_.on_grow(size_);
+        other.tail_ = &other.head_;
+        other.size_ = 0;
+        throw;
+    }
+    size_ += other.size_;
+    stats_.on_grow(size_);
+    other.head_.next = nullptr;
+    other.tail_ = &other.head_;
+    other.size_ = 0;
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::sort() {
+    sort(std::less<T>());
+}
+
+// восходящая сортировка слиянием без выделения памяти: bins[i] хранит отсортированную серию из 2^i узлов,
+// каждый следующий узел сливается с заполненными сериями, как перенос при двоичном сложении
+// в bins с большим номером лежат более ранние элементы, поэтому слияние слева направо сохраняет устойчивость
+// если compare бросает исключение, carry, все непустые bins, результат и еще не разобранный остаток сцепляются
+// обратно в список: порядок элементов не определен, но ни один узел не теряется и size() не меняется
+template <class T, class Allocator, class Stats>
+template <class Compare>
+void LinkedList<T, Allocator, Stats>::sort(Compare compare) {
+    NodeBase* bins[64] = {};
+    int filled = 0;
+    NodeBase* node = head_.next;
+    NodeBase* carry = nullptr;
+    NodeBase* result = nullptr;
+    try {
+        while (node) {
+            carry = node;
+            node = node->next;
+            carry->next = nullptr;
+            int i = 0;
+            for (; i < filled && bins[i]; ++i) {
+                carry = merge_nodes(bins[i], carry, compare);
+            }
+            bins[i] = carry;
+            carry = nullptr;
+            if (i == filled) {
+                ++filled;
+            }
+        }
+        for (int i = 0; i < filled; ++i) {
+            result = merge_nodes(bins[i], result, compare);
+        }
+    } catch (...) {
+        tail_ = &head_;
+        auto append = [this](NodeBase* chain) {
+            tail_->next = chain;
+            while (tail_->next) {
+                tail_ = tail_->next;
+            }
+        };
+        append(result);
+        append(carry);
+        for (int i = 0; i < filled; ++i) {
+            append(bins[i]);
+        }
+        append(node);
+        throw;
+    }
+    head_.next = result;
+    tail_ = &head_;
+    while (tail_->next) {
+        tail_ = tail_->next;
+    }
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::reverse() noexcept {
+    if (head_.next) {
+        tail_ = head_.next;
+    }
+    NodeBase* reversed = nullptr;
+    NodeBase* node = head_.next;
+    while (node) {
+        NodeBase* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    head_.next = reversed;
+}
+
+template <class T, class Allocator, class Stats>
+std::size_t LinkedList<T, Allocator, Stats>::unique() {
+    return unique(std::equal_to<T>());
+}
+
+// из каждой серии подряд идущих равных остается первый элемент, возвращает число удаленных
+template <class T, class Allocator, class Stats>
+template <class BinaryPredicate>
+std::size_t LinkedList<T, Allocator, Stats>::unique(BinaryPredicate predicate) {
+    std::size_t removed = 0;
+    NodeBase* node = head_.next;
+    while (node && node->next) {
+        if (predicate(as_node(node)->data, as_node(node->next)->data)) {
+            erase_after(const_iterator(node));
+            ++removed;
+        } else {
+            node = node->next;
+        }
+    }
+    return removed;
+}
+
+template <class T, class Allocator, class Stats>
+template <class Predicate>
+std::size_t LinkedList<T, Allocator, Stats>::remove_if(Predicate predicate) {
+    std::size_t removed = 0;
+    NodeBase* prev = &head_;
+    while (prev->next) {
+        if (predicate(as_node(prev->next)->data)) {
+            erase_after(const_iterator(prev));
+            ++removed;
+        } else {
+            prev = prev->next;
+        }
+    }
+    return removed;
+}
+
+// =============================================================================
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::find(const T& value) {
+    std::size_t probes = 0;
     for (auto it = begin(); it != end(); ++it) {
+        ++probes;
         if (*it == value) {
+            stats_.on_find(true, probes);
             return it;
         }
     }
+    stats_.on_find(false, probes);
     return end();
 }
 
-template <class T>
-typename LinkedList<T>::const_iterator LinkedList<T>::find(const T& value) const {
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator LinkedList<T, Allocator, Stats>::find(const T& value) const {
+    std::size_t probes = 0;
     for (auto it = cbegin(); it != cend(); ++it) {
+        ++probes;
         if (*it == value) {
+            stats_.on_find(true, probes);
             return it;
         }
     }
+    stats_.on_find(false, probes);
     return cend();
 }
 
 // =============================================================================
 
-template <class T>
-LinkedList<T>::iterator::iterator(Node* node) : node_(node) {}
+template <class T, class Allocator, class Stats>
+ListStats LinkedList<T, Allocator, Stats>::stats() const noexcept {
+    return stats_.snapshot(size_);
+}
 
-template <class T>
-typename LinkedList<T>::reference LinkedList<T>::iterator::operator*() const { 
-    return node_->data;
+// счет начинается заново, пиковым становится текущий размер
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::reset_stats() noexcept {
+    stats_ = Stats();
+    stats_.on_grow(size_);
 }
 
-template <class T>
-typename LinkedList<T>::iterator& LinkedList<T>::iterator::operator++() { 
-    node_ = node_->next.get(); 
-    return *this; 
+// =============================================================================
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::Node* LinkedList<T, Allocator, Stats>::as_node(NodeBase* node) noexcept {
+    return static_cast<Node*>(node);
 }
 
-template <class T>
-bool LinkedList<T>::iterator::operator==(const iterator& other) const { 
+template <class T, class Allocator, class Stats>
+const typename LinkedList<T, Allocator, Stats>::Node* LinkedList<T, Allocator, Stats>::as_node(const NodeBase* node) noexcept {
+    return static_cast<const Node*>(node);
+}
+
+// сливает две отсортированные цепочки, при равенстве первым идет узел из left; обе цепочки забираются,
+// left и right становятся nullptr
+// если compare бросает исключение, все узлы обеих цепочек (уже слитые, затем остаток left, затем остаток right)
+// оказываются одной цепочкой в left, right становится nullptr, и исключение пробрасывается дальше
+template <class T, class Allocator, class Stats>
+template <class Compare>
+typename LinkedList<T, Allocator, Stats>::NodeBase* LinkedList<T, Allocator, Stats>::merge_nodes(NodeBase*& left, NodeBase*& right, Compare& compare) {
+    NodeBase merged;
+    NodeBase* tail = &merged;
+    try {
+        while (left && right) {
+            if (compare(as_node(right)->data, as_node(left)->data)) {
+                tail->next = right;
+                right = right->next;
+            } else {
+                tail->next = left;
+                left = left->next;
+            }
+            tail = tail->next;
+        }
+    } catch (...) {
+        tail->next = left;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        tail->next = right;
+        left = merged.next;
+        right = nullptr;
+        throw;
+    }
+    tail->next = left ? left : right;
+    left = nullptr;
+    right = nullptr;
+    return merged.next;
+}
+
+// если конструктор элемента бросает исключение, память узла возвращается аллокатору
+template <class T, class Allocator, class Stats>
+template <class... Args>
+typename LinkedList<T, Allocator, Stats>::Node* LinkedList<T, Allocator, Stats>::create_node(Args&&... args) {
+    Node* node = node_traits::allocate(alloc_, 1);
+    try {
+        node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    stats_.on_allocate();
+    return node;
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::destroy_node(NodeBase* node) noexcept {
+    Node* full = as_node(node);
+    node_traits::destroy(alloc_, full);
+    node_traits::deallocate(alloc_, full, 1);
+    stats_.on_free();
+}
+
+// узлы можно не обходить, если у элементов нет деструктора, а ресурс освобождает память только целиком
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::skips_destruction() const noexcept {
+    if constexpr (std::is_trivially_destructible<T>::value &&
+                  std::is_same<Allocator, std::pmr::polymorphic_allocator<T>>::value) {
+        return dynamic_cast<std::pmr::monotonic_buffer_resource*>(alloc_.resource()) != nullptr;
+    } else {
+        return false;
+    }
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::destroy_chain(NodeBase* first) noexcept {
+    while (first) {
+        NodeBase* next = first->next;
+        destroy_node(first);
+        first = next;
+    }
+}
+
+// освобождает цепочку узлов от first до last, в ней count узлов
+// если аллокатор умеет deallocate_chain, как PoolAllocator, узлы возвращаются одним действием: за один проход
+// у каждого узла читается next (как NodeBase*, пока узел жив), узел разрушается целиком и его память связывается
+// со следующим через link_free, так что пул получает уже готовый список свободных блоков; иначе узлы
+// освобождаются по одному
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::release_nodes(NodeBase* first, NodeBase* last, std::size_t count) noexcept {
+    if constexpr (supports_deallocate_chain<node_allocator>::value) {
+        Node* const head = as_node(first);
+        Node* const tail = as_node(last);
+        for (Node* node = head;;) {
+            Node* next = node == tail ? nullptr : as_node(node->next);
+            node_traits::destroy(alloc_, node);
+            node_allocator::link_free(node, next);
+            if (!next) {
+                break;
+            }
+            node = next;
+        }
+        alloc_.deallocate_chain(head, tail);
+        stats_.on_free(count);
+    } else {
+        destroy_chain(first);
+    }
+}
+
+// длину диапазона можно узнать заранее только у прямых итераторов, однопроходный читается один раз
+template <class T, class Allocator, class Stats>
+template <class InputIt>
+std::size_t LinkedList<T, Allocator, Stats>::range_size(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        return static_cast<std::size_t>(std::distance(first, last));
+    } else {
+        return kUnknownSize;
+    }
+}
+
+// строит цепочку из элементов диапазона за один проход, count - его длина или kUnknownSize
+// при известной длине узлы берутся у аллокатора одним отрезком через allocate_run, если он это умеет,
+// каждый узел отрезка потом освобождается отдельно, как выделенный поштучно
+// при исключении уже созданные узлы и неиспользованный остаток отрезка освобождаются, а исключение пробрасывается дальше
+template <class T, class Allocator, class Stats>
+template <class InputIt>
+typename LinkedList<T, Allocator, Stats>::Chain LinkedList<T, Allocator, Stats>::make_chain(InputIt first, InputIt last, std::size_t count) {
+    Node* run = nullptr;
+    std::size_t reserved = 0;
+    if constexpr (supports_allocate_run<node_allocator>::value) {
+        if (count != kUnknownSize && count > 1) {
+            run = alloc_.allocate_run(count);
+            reserved = run ? count : 0;
+        }
+    }
+    NodeBase head;
+    NodeBase* tail = &head;
+    std::size_t size = 0;
+    try {
+        for (; first != last; ++first) {
+            Node* node;
+            if (size < reserved) {
+                node = run + size;
+                node_traits::construct(alloc_, node, *first);
+                stats_.on_allocate();
+            } else {
+                node = create_node(*first);
+            }
+            tail->next = node;
+            tail = node;
+            ++size;
+        }
+    } catch (...) {
+        for (std::size_t i = size; i < reserved; ++i) {
+            node_traits::deallocate(alloc_, run + i, 1);
+        }
+        destroy_chain(head.next);
+        throw;
+    }
+    for (std::size_t i = size; i < reserved; ++i) {
+        node_traits::deallocate(alloc_, run + i, 1);
+    }
+    return Chain{head.next, size ? tail : nullptr, size};
+}
+
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::link_chain_after(NodeBase* pos, const Chain& chain) noexcept {
+    if (!chain.first) {
+        return;
+    }
+    chain.last->next = pos->next;
+    pos->next = chain.first;
+    if (pos == tail_) {
+        tail_ = chain.last;
+    }
+    size_ += chain.size;
+    stats_.on_grow(size_);
+}
+
+// узел связывается только после успешного конструирования элемента, поэтому при исключении список не меняется
+template <class T, class Allocator, class Stats>
+template <class... Args>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::link_after(NodeBase* pos, Args&&... args) {
+    Node* node = create_node(std::forward<Args>(args)...);
+    node->next = pos->next;
+    pos->next = node;
+    if (pos == tail_) {
+        tail_ = node;
+    }
+    ++size_;
+    stats_.on_grow(size_);
+    return make_iterator(node);
+}
+
+// перемещает элементы other в новые узлы после pos с сохранением порядка, other становится пустым
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::move_elements_after(NodeBase* pos, LinkedList& other) {
+    for (NodeBase* node = other.head_.next; node; node = node->next) {
+        link_after(pos, std::move(as_node(node)->data));
+        pos = pos->next;
+    }
+    other.clear();
+}
+
+// забирает узлы other целиком, этот список должен быть пуст; пустой хвост other указывает на его собственную заглушку,
+// поэтому tail_ переносится только вместе с узлами
+template <class T, class Allocator, class Stats>
+void LinkedList<T, Allocator, Stats>::take_nodes(LinkedList& other) noexcept {
+    if (!other.head_.next) {
+        return;
+    }
+    head_.next = other.head_.next;
+    tail_ = other.tail_;
+    size_ = other.size_;
+    stats_.on_grow(size_);
+    other.head_.next = nullptr;
+    other.tail_ = &other.head_;
+    other.size_ = 0;
+}
+
+// итераторы, которые отдает список, ведут счет шагов в его статистике
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator LinkedList<T, Allocator, Stats>::make_iterator(NodeBase* node) const noexcept {
+    return iterator(node, StatsLink<Stats>(&stats_));
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator LinkedList<T, Allocator, Stats>::make_const_iterator(const NodeBase* node) const noexcept {
+    return const_iterator(node, StatsLink<Stats>(&stats_));
+}
+
+// =============================================================================
+
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::iterator::iterator(NodeBase* node) : node_(node), link_() {}
+
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::iterator::iterator(NodeBase* node, StatsLink<Stats> link) : node_(node), link_(link) {}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::reference LinkedList<T, Allocator, Stats>::iterator::operator*() const {
+    return as_node(node_)->data;
+}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::iterator& LinkedList<T, Allocator, Stats>::iterator::operator++() {
+    node_ = node_->next;
+    link_.hop();
+    return *this;
+}
+
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::iterator::operator==(const iterator& other) const {
     return node_ == other.node_;
 }
 
-template <class T>
-bool LinkedList<T>::iterator::operator!=(const iterator& other) const {
-    return !(*this == other); 
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
 }
 
 // =============================================================================
 
-template <class T>
-LinkedList<T>::const_iterator::const_iterator(const Node* node) : node_(node) {}
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::const_iterator::const_iterator(const NodeBase* node) : node_(node), link_() {}
 
-template <class T>
-typename LinkedList<T>::const_reference LinkedList<T>::const_iterator::operator*() const { 
-    return node_->data; 
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::const_iterator::const_iterator(const NodeBase* node, StatsLink<Stats> link)
+    : node_(node), link_(link) {}
+
+template <class T, class Allocator, class Stats>
+LinkedList<T, Allocator, Stats>::const_iterator::const_iterator(const iterator& it) : node_(it.node_), link_(it.link_) {}
+
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_reference LinkedList<T, Allocator, Stats>::const_iterator::operator*() const {
+    return as_node(node_)->data;
 }
 
-template <class T>
-typename LinkedList<T>::const_iterator& LinkedList<T>::const_iterator::operator++() { 
-    node_ = node_->next.get(); 
+template <class T, class Allocator, class Stats>
+typename LinkedList<T, Allocator, Stats>::const_iterator& LinkedList<T, Allocator, Stats>::const_iterator::operator++() {
+    node_ = node_->next;
+    link_.hop();
     return *this;
 }
 
-template <class T>
-bool LinkedList<T>::const_iterator::operator==(const const_iterator& other) const { 
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::const_iterator::operator==(const const_iterator& other) const {
     return node_ == other.node_;
 }
 
-template <class T>
-bool LinkedList<T>::const_iterator::operator!=(const const_iterator& other) const { 
+template <class T, class Allocator, class Stats>
+bool LinkedList<T, Allocator, Stats>::const_iterator::operator!=(const const_iterator& other) const {
     return !(*this == other);
 }
 
 // =============================================================================
 
+namespace pmr {
+
+template <class T>
+using LinkedList = ::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
 
 #endif  // LINKED_LIST_H
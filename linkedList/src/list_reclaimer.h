@@ -0,0 +1,165 @@
+#ifndef LIST_RECLAIMER_H
+#define LIST_RECLAIMER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "mpsc_queue.h"
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+// отложенное уничтожение контейнеров в фоновом потоке
+// уничтожение большого списка - это обход всех узлов, и поток, которому важна задержка, не хочет ждать его на месте
+// retire за O(1) перемещает контейнер в небольшую обертку и кладет ее в MpscQueue, а поток-уборщик забирает
+// обертки пачками через drain и разрушает их вместе с контейнерами; retire можно звать из любых потоков сразу
+
+// узлы освобождает поток-уборщик, поэтому аллокатор контейнера должен это позволять: у std::allocator проблем нет,
+// PoolAllocator не потокобезопасен, но после retire пул принадлежит только обертке, так как отданному контейнеру
+// взамен выдается новый аллокатор (select_on_container_copy_construction, у PoolAllocator это новый пул);
+// контейнеры, которые делят пул через get_allocator() с еще используемыми, отдавать нельзя,
+// а для pmr ресурс должен быть потокобезопасным, например synchronized_pool_resource
+
+// уборщик засыпает на условной переменной, когда очередь пуста, и retire будит его, только если он спит
+// флаг sleeping_ ставится и читается под mutex_, а уборщик смотрит в очередь под тем же мьютексом перед сном:
+// либо retire видит флаг и будит, либо уборщик видит уже положенный контейнер и не засыпает, так что пробуждение
+// не теряется и ждать по таймауту не нужно
+// с ReclaimerPriority::Low уборщик работает с наименьшим приоритетом (nice 19, только в Linux, где он задается
+// отдельно для потока): иначе разбуженный поток сразу вытесняет вызвавший retire, если свободного ядра нет, и
+// отложенное уничтожение выполняется за его счет; на других системах Low ничего не меняет
+// flush дожидается, пока будет уничтожено все, что отдано до его вызова; деструктор уничтожает все, что осталось
+
+enum class ReclaimerPriority { Normal, Low };
+
+class ListReclaimer {
+public:
+    explicit ListReclaimer(ReclaimerPriority priority = ReclaimerPriority::Normal);
+    ListReclaimer(const ListReclaimer&) = delete;
+    ListReclaimer& operator=(const ListReclaimer&) = delete;
+    ~ListReclaimer();
+
+    template <class Container>
+    void retire(Container&& container);
+    void flush();
+
+    std::size_t pending() const noexcept;
+
+private:
+    struct Retired {
+        virtual ~Retired() = default;
+    };
+
+    template <class Container>
+    struct RetiredContainer : Retired {
+        Container container;
+
+        explicit RetiredContainer(Container&& other) : container(std::move(other)) {}
+    };
+
+    void run(ReclaimerPriority priority);
+    void wake();
+
+    MpscQueue<std::unique_ptr<Retired>> queue_;
+    std::atomic<std::size_t> retired_;
+    std::atomic<std::size_t> reclaimed_;
+    bool sleeping_;
+    bool stop_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::thread worker_;
+};
+
+// =============================================================================
+
+// поток запускается последним, когда все остальные поля уже готовы
+inline ListReclaimer::ListReclaimer(ReclaimerPriority priority)
+    : retired_(0), reclaimed_(0), sleeping_(false), stop_(false), worker_(&ListReclaimer::run, this, priority) {}
+
+// деструктор не может выполняться одновременно с retire
+inline ListReclaimer::~ListReclaimer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+// =============================================================================
+
+// контейнер передается только по rvalue, после вызова он пуст и пригоден к использованию со своим новым аллокатором
+template <class Container>
+void ListReclaimer::retire(Container&& container) {
+    static_assert(!std::is_lvalue_reference<Container>::value, "retire takes the container by rvalue");
+    using traits = std::allocator_traits<typename Container::allocator_type>;
+    auto retired = std::make_unique<RetiredContainer<Container>>(std::move(container));
+    container = Container(traits::select_on_container_copy_construction(container.get_allocator()));
+    retired_.fetch_add(1, std::memory_order_relaxed);
+    queue_.push(std::move(retired));
+    bool sleeping;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sleeping = sleeping_;
+    }
+    if (sleeping) {
+        wake_.notify_one();
+    }
+}
+
+inline void ListReclaimer::flush() {
+    const std::size_t target = retired_.load();
+    wake();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this, target] { return reclaimed_.load() >= target; });
+}
+
+// число отданных, но еще не уничтоженных контейнеров
+inline std::size_t ListReclaimer::pending() const noexcept {
+    const std::size_t reclaimed = reclaimed_.load();
+    const std::size_t retired = retired_.load();
+    return retired > reclaimed ? retired - reclaimed : 0;
+}
+
+// =============================================================================
+
+// после каждой пачки уборщик будит ждущих flush, а перед сном еще раз смотрит в очередь под мьютексом
+inline void ListReclaimer::run(ReclaimerPriority priority) {
+#ifdef __linux__
+    if (priority == ReclaimerPriority::Low) {
+        setpriority(PRIO_PROCESS, 0, 19);
+    }
+#else
+    (void)priority;
+#endif
+    for (;;) {
+        queue_.drain([this](std::unique_ptr<Retired> retired) {
+            retired.reset();
+            reclaimed_.fetch_add(1);
+        });
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.notify_all();
+        if (stop_ && queue_.empty()) {
+            return;
+        }
+        sleeping_ = true;
+        wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        sleeping_ = false;
+    }
+}
+
+inline void ListReclaimer::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    wake_.notify_one();
+}
+
+// =============================================================================
+
+#endif  // LIST_RECLAIMER_H
@@ -0,0 +1,191 @@
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// статистика работы LinkedList: выделения и освобождения узлов, пиковое число узлов, узлы, скопированные
+// при копировании списка, шаги итераторов и длины поиска find отдельно для найденных и не найденных значений
+// статистика - третий параметр шаблона LinkedList: ListStats считает, NoListStats пуст, все его методы пустые
+// и встраиваются в ничто, а поле и указатель в итераторах с [[no_unique_address]] не занимают места
+// по умолчанию используется NoListStats, сборка с -DLINKED_LIST_STATS делает ListStats умолчанием для всех списков
+// счетчики у каждого объекта списка свои, перемещенный список начинает счет заново
+// длины поиска собираются в гистограмму по степеням двойки: корзина 0 - длина 0 (пустой список),
+// корзина i - длины от 2^(i-1) до 2^i - 1, последняя корзина собирает все, что длиннее
+
+struct ListStats {
+    static constexpr bool enabled = true;
+    static constexpr std::size_t kProbeBuckets = 32;
+
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t live_nodes = 0;
+    std::uint64_t peak_nodes = 0;
+    std::uint64_t copied_nodes = 0;
+    std::uint64_t iterator_hops = 0;
+    std::uint64_t find_hits = 0;
+    std::uint64_t find_misses = 0;
+    std::array<std::uint64_t, kProbeBuckets> hit_probes{};
+    std::array<std::uint64_t, kProbeBuckets> miss_probes{};
+
+    void on_allocate(std::size_t count = 1) noexcept;
+    void on_free(std::size_t count = 1) noexcept;
+    void on_grow(std::size_t size) noexcept;
+    void on_copy(std::size_t count) noexcept;
+    void on_hop() noexcept;
+    void on_find(bool hit, std::size_t probes) noexcept;
+    ListStats snapshot(std::size_t size) const noexcept;
+
+    static std::size_t probe_bucket(std::size_t probes) noexcept;
+};
+
+struct NoListStats {
+    static constexpr bool enabled = false;
+
+    void on_allocate(std::size_t = 1) noexcept {}
+    void on_free(std::size_t = 1) noexcept {}
+    void on_grow(std::size_t) noexcept {}
+    void on_copy(std::size_t) noexcept {}
+    void on_hop() noexcept {}
+    void on_find(bool, std::size_t) noexcept {}
+    ListStats snapshot(std::size_t) const noexcept { return ListStats(); }
+};
+
+#ifdef LINKED_LIST_STATS
+using DefaultListStats = ListStats;
+#else
+using DefaultListStats = NoListStats;
+#endif
+
+// ссылка итератора на статистику списка, у NoListStats пустая
+template <class Stats>
+class StatsLink {
+public:
+    StatsLink() = default;
+    explicit StatsLink(Stats* stats) noexcept : stats_(stats) {}
+
+    void hop() const noexcept {
+        if (stats_) {
+            stats_->on_hop();
+        }
+    }
+private:
+    Stats* stats_ = nullptr;
+};
+
+template <>
+class StatsLink<NoListStats> {
+public:
+    StatsLink() = default;
+    explicit StatsLink(NoListStats*) noexcept {}
+
+    void hop() const noexcept {}
+};
+
+void write_text(std::ostream& out, const ListStats& stats);
+void write_json(std::ostream& out, const ListStats& stats);
+
+// =============================================================================
+
+inline void ListStats::on_allocate(std::size_t count) noexcept {
+    allocations += count;
+}
+
+inline void ListStats::on_free(std::size_t count) noexcept {
+    frees += count;
+}
+
+inline void ListStats::on_grow(std::size_t size) noexcept {
+    if (size > peak_nodes) {
+        peak_nodes = size;
+    }
+}
+
+inline void ListStats::on_copy(std::size_t count) noexcept {
+    copied_nodes += count;
+}
+
+inline void ListStats::on_hop() noexcept {
+    ++iterator_hops;
+}
+
+inline void ListStats::on_find(bool hit, std::size_t probes) noexcept {
+    if (hit) {
+        ++find_hits;
+        ++hit_probes[probe_bucket(probes)];
+    } else {
+        ++find_misses;
+        ++miss_probes[probe_bucket(probes)];
+    }
+}
+
+// текущее число узлов список знает сам, поэтому оно подставляется только в снимок
+inline ListStats ListStats::snapshot(std::size_t size) const noexcept {
+    ListStats result = *this;
+    result.live_nodes = size;
+    return result;
+}
+
+inline std::size_t ListStats::probe_bucket(std::size_t probes) noexcept {
+    std::size_t bucket = 0;
+    while (probes && bucket + 1 < kProbeBuckets) {
+        probes >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// =============================================================================
+
+// строки вида "имя значение", гистограммы - только непустые корзины в виде "нижняя_граница:число"
+inline void write_text(std::ostream& out, const ListStats& stats) {
+    out << "allocations " << stats.allocations << '\n'
+        << "frees " << stats.frees << '\n'
+        << "live_nodes " << stats.live_nodes << '\n'
+        << "peak_nodes " << stats.peak_nodes << '\n'
+        << "copied_nodes " << stats.copied_nodes << '\n'
+        << "iterator_hops " << stats.iterator_hops << '\n'
+        << "find_hits " << stats.find_hits << '\n'
+        << "find_misses " << stats.find_misses << '\n';
+    auto histogram = [&out](const char* name, const std::array<std::uint64_t, ListStats::kProbeBuckets>& buckets) {
+        out << name;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i]) {
+                out << ' ' << (i ? std::uint64_t(1) << (i - 1) : 0) << ':' << buckets[i];
+            }
+        }
+        out << '\n';
+    };
+    histogram("hit_probes", stats.hit_probes);
+    histogram("miss_probes", stats.miss_probes);
+}
+
+// гистограммы пишутся целиком, все kProbeBuckets корзин, чтобы снимки разных списков сравнивались поэлементно
+inline void write_json(std::ostream& out, const ListStats& stats) {
+    auto histogram = [&out](const std::array<std::uint64_t, ListStats::kProbeBuckets>& buckets) {
+        out << '[';
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            out << (i ? "," : "") << buckets[i];
+        }
+        out << ']';
+    };
+    out << "{\"allocations\":" << stats.allocations
+        << ",\"frees\":" << stats.frees
+        << ",\"live_nodes\":" << stats.live_nodes
+        << ",\"peak_nodes\":" << stats.peak_nodes
+        << ",\"copied_nodes\":" << stats.copied_nodes
+        << ",\"iterator_hops\":" << stats.iterator_hops
+        << ",\"find_hits\":" << stats.find_hits
+        << ",\"find_misses\":" << stats.find_misses
+        << ",\"hit_probes\":";
+    histogram(stats.hit_probes);
+    out << ",\"miss_probes\":";
+    histogram(stats.miss_probes);
+    out << '}';
+}
+
+// =============================================================================
+
+#endif  // LIST_STATS_H
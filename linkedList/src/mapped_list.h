@@ -0,0 +1,434 @@
+#ifndef MAPPED_LIST_H
+#define MAPPED_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "linked_list.h"
+
+// сохранение LinkedList<T> с тривиально копируемым T в файл и открытие его через mmap без десериализации
+// файл - заголовок MappedListHeader и узлы {T data; uint64_t next}, где next - смещение следующего узла
+// от начала файла, 0 означает конец списка; save_list пишет узлы в порядке обхода
+// смещения вместо указателей делают файл независимым от адреса, по которому он отображен,
+// поэтому открытие - это mmap и проверка заголовка, а страницы подгружаются ядром при первом обращении
+
+// MapMode::ReadOnly отображает файл только для чтения, элементы доступны как const T&
+// MapMode::CopyOnWrite отображает файл приватно: элементы можно менять через итераторы и front(),
+// измененные страницы копируются ядром и в файл не попадают
+// pop_front в обоих режимах только сдвигает голову в самом объекте MappedList
+// формат привязан к платформе (порядок байт, размер и выравнивание T), в заголовке проверяются размер и выравнивание узла,
+// содержимое узлов считается доверенным и при открытии не проверяется
+
+struct MappedListHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t node_size;
+    std::uint32_t node_align;
+    std::uint32_t reserved;
+    std::uint64_t size;
+    std::uint64_t head;
+};
+
+enum class MapMode { ReadOnly, CopyOnWrite };
+
+template <class T, MapMode Mode = MapMode::ReadOnly>
+class MappedList {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedList requires trivially copyable T");
+
+    struct Node {
+        T data;
+        std::uint64_t next;
+    };
+
+    static_assert(alignof(Node) <= 64, "MappedList node alignment must not exceed 64");
+
+public:
+    using value_type = T;
+    using reference = std::conditional_t<Mode == MapMode::CopyOnWrite, T&, const T&>;
+    using const_reference = const T&;
+
+    // узлы начинаются с этого смещения, чтобы быть выровненными при любом допустимом alignof(Node)
+    static constexpr std::uint64_t kFirstNodeOffset = 64;
+    static constexpr char kMagic[8] = {'L', 'L', 'M', 'A', 'P', 'v', '1', '\0'};
+    static constexpr std::uint32_t kVersion = 1;
+
+    explicit MappedList(const std::string& path);
+    MappedList(const MappedList&) = delete;
+    MappedList(MappedList&& other) noexcept;
+    ~MappedList();
+
+    MappedList& operator=(const MappedList&) = delete;
+    MappedList& operator=(MappedList&& other) noexcept;
+
+    reference front();
+    const_reference front() const;
+
+    class iterator;
+    class const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+
+    void pop_front();
+
+    const_iterator find(const T& value) const;
+
+    template <class Allocator, class Stats>
+    static void save(const LinkedList<T, Allocator, Stats>& list, const std::string& path);
+
+private:
+    using byte_pointer = std::conditional_t<Mode == MapMode::CopyOnWrite, char*, const char*>;
+    using node_pointer = std::conditional_t<Mode == MapMode::CopyOnWrite, Node*, const Node*>;
+
+    template <class Allocator, class Stats>
+    static void write_nodes(const LinkedList<T, Allocator, Stats>& list, std::ofstream& out);
+    static node_pointer node_at(byte_pointer base, std::uint64_t offset) noexcept;
+    void unmap() noexcept;
+
+    byte_pointer base_;
+    std::size_t bytes_;
+    std::size_t size_;
+    std::uint64_t head_;
+
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(byte_pointer base, std::uint64_t offset);
+
+        reference operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+    private:
+        byte_pointer base_;
+        std::uint64_t offset_;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        const_iterator(const char* base, std::uint64_t offset);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const char* base_;
+        std::uint64_t offset_;
+    };
+};
+
+template <class T, class Allocator, class Stats>
+void save_list(const LinkedList<T, Allocator, Stats>& list, const std::string& path);
+
+// =============================================================================
+
+// файл отображается целиком, но ядро читает страницы лениво, поэтому время открытия не зависит от длины списка
+template <class T, MapMode Mode>
+MappedList<T, Mode>::MappedList(const std::string& path) : base_(nullptr), bytes_(0), size_(0), head_(0) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open MappedList file " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < kFirstNodeOffset) {
+        ::close(fd);
+        throw std::runtime_error("MappedList file is invalid: " + path);
+    }
+    bytes_ = static_cast<std::size_t>(info.st_size);
+    const int protection = Mode == MapMode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* memory = ::mmap(nullptr, bytes_, protection, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("cannot map MappedList file " + path);
+    }
+    base_ = static_cast<byte_pointer>(memory);
+    MappedListHeader header;
+    std::memcpy(&header, base_, sizeof(header));
+    const bool valid = std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kVersion &&
+                       header.node_size == sizeof(Node) && header.node_align == alignof(Node) &&
+                       header.size <= (bytes_ - kFirstNodeOffset) / sizeof(Node) &&
+                       (header.size == 0) == (header.head == 0) && header.head <= bytes_ - sizeof(Node);
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("MappedList file is invalid: " + path);
+    }
+    size_ = static_cast<std::size_t>(header.size);
+    head_ = header.head;
+    ::madvise(memory, bytes_, MADV_SEQUENTIAL);
+}
+
+template <class T, MapMode Mode>
+MappedList<T, Mode>::MappedList(MappedList&& other) noexcept
+    : base_(other.base_), bytes_(other.bytes_), size_(other.size_), head_(other.head_) {
+    other.base_ = nullptr;
+    other.bytes_ = 0;
+    other.size_ = 0;
+    other.head_ = 0;
+}
+
+template <class T, MapMode Mode>
+MappedList<T, Mode>::~MappedList() {
+    unmap();
+}
+
+template <class T, MapMode Mode>
+MappedList<T, Mode>& MappedList<T, Mode>::operator=(MappedList&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        base_ = other.base_;
+        bytes_ = other.bytes_;
+        size_ = other.size_;
+        head_ = other.head_;
+        other.base_ = nullptr;
+        other.bytes_ = 0;
+        other.size_ = 0;
+        other.head_ = 0;
+    }
+    return *this;
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::reference MappedList<T, Mode>::front() {
+    if (!head_) {
+        throw std::runtime_error("MappedList is empty");
+    }
+    return node_at(base_, head_)->data;
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_reference MappedList<T, Mode>::front() const {
+    if (!head_) {
+        throw std::runtime_error("MappedList is empty");
+    }
+    return node_at(base_, head_)->data;
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::iterator MappedList<T, Mode>::begin() {
+    if (!head_) {
+        throw std::runtime_error("MappedList is empty");
+    }
+    return iterator(base_, head_);
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::iterator MappedList<T, Mode>::end() {
+    return iterator(base_, 0);
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_iterator MappedList<T, Mode>::cbegin() const {
+    if (!head_) {
+        throw std::runtime_error("MappedList is empty");
+    }
+    return const_iterator(base_, head_);
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_iterator MappedList<T, Mode>::cend() const {
+    return const_iterator(base_, 0);
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+bool MappedList<T, Mode>::empty() const noexcept {
+    return head_ == 0;
+}
+
+template <class T, MapMode Mode>
+std::size_t MappedList<T, Mode>::size() const noexcept {
+    return size_;
+}
+
+template <class T, MapMode Mode>
+void MappedList<T, Mode>::pop_front() {
+    if (head_) {
+        head_ = node_at(base_, head_)->next;
+        --size_;
+    }
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_iterator MappedList<T, Mode>::find(const T& value) const {
+    for (std::uint64_t offset = head_; offset; offset = node_at(base_, offset)->next) {
+        if (node_at(base_, offset)->data == value) {
+            return const_iterator(base_, offset);
+        }
+    }
+    return cend();
+}
+
+// =============================================================================
+
+// узлы пишутся пачками через буфер, заголовок записывается последним, когда известна длина
+// запись идет во временный файл path + ".tmp", который после fsync переименовывается в path: сбой или нехватка места
+// посреди записи не оставляют под именем path обрезанный файл, а уже открытый MappedList продолжает видеть старый
+template <class T, MapMode Mode>
+template <class Allocator, class Stats>
+void MappedList<T, Mode>::save(const LinkedList<T, Allocator, Stats>& list, const std::string& path) {
+    const std::string temporary = path + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open MappedList file " + temporary);
+    }
+    try {
+        write_nodes(list, out);
+        out.close();
+        if (!out) {
+            throw std::runtime_error("cannot write MappedList file " + temporary);
+        }
+        const int fd = ::open(temporary.c_str(), O_RDONLY);
+        const bool synced = fd >= 0 && ::fsync(fd) == 0;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (!synced) {
+            throw std::runtime_error("cannot sync MappedList file " + temporary);
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("cannot replace MappedList file " + path);
+        }
+    } catch (...) {
+        out.close();
+        std::remove(temporary.c_str());
+        throw;
+    }
+}
+
+template <class T, MapMode Mode>
+template <class Allocator, class Stats>
+void MappedList<T, Mode>::write_nodes(const LinkedList<T, Allocator, Stats>& list, std::ofstream& out) {
+    char padding[kFirstNodeOffset] = {};
+    out.write(padding, sizeof(padding));
+    std::uint64_t size = 0;
+    if (!list.empty()) {
+        constexpr std::size_t kBatch = 4096;
+        std::vector<Node> batch;
+        batch.reserve(kBatch);
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            if (batch.size() == kBatch) {
+                out.write(reinterpret_cast<const char*>(batch.data()), batch.size() * sizeof(Node));
+                batch.clear();
+            }
+            Node node;
+            std::memset(static_cast<void*>(&node), 0, sizeof(node));
+            node.data = *it;
+            ++size;
+            node.next = kFirstNodeOffset + size * sizeof(Node);
+            batch.push_back(node);
+        }
+        // последний узел всегда остается в буфере, его next обнуляется перед записью
+        batch.back().next = 0;
+        out.write(reinterpret_cast<const char*>(batch.data()), batch.size() * sizeof(Node));
+    }
+    MappedListHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.node_size = sizeof(Node);
+    header.node_align = alignof(Node);
+    header.size = size;
+    header.head = size ? kFirstNodeOffset : 0;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::node_pointer MappedList<T, Mode>::node_at(byte_pointer base, std::uint64_t offset) noexcept {
+    return reinterpret_cast<node_pointer>(base + offset);
+}
+
+template <class T, MapMode Mode>
+void MappedList<T, Mode>::unmap() noexcept {
+    if (base_) {
+        ::munmap(const_cast<char*>(base_), bytes_);
+        base_ = nullptr;
+    }
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+MappedList<T, Mode>::iterator::iterator(byte_pointer base, std::uint64_t offset) : base_(base), offset_(offset) {}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::reference MappedList<T, Mode>::iterator::operator*() const {
+    return node_at(base_, offset_)->data;
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::iterator& MappedList<T, Mode>::iterator::operator++() {
+    offset_ = node_at(base_, offset_)->next;
+    return *this;
+}
+
+template <class T, MapMode Mode>
+bool MappedList<T, Mode>::iterator::operator==(const iterator& other) const {
+    return base_ == other.base_ && offset_ == other.offset_;
+}
+
+template <class T, MapMode Mode>
+bool MappedList<T, Mode>::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+template <class T, MapMode Mode>
+MappedList<T, Mode>::const_iterator::const_iterator(const char* base, std::uint64_t offset) : base_(base), offset_(offset) {}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_reference MappedList<T, Mode>::const_iterator::operator*() const {
+    return reinterpret_cast<const Node*>(base_ + offset_)->data;
+}
+
+template <class T, MapMode Mode>
+typename MappedList<T, Mode>::const_iterator& MappedList<T, Mode>::const_iterator::operator++() {
+    offset_ = reinterpret_cast<const Node*>(base_ + offset_)->next;
+    return *this;
+}
+
+template <class T, MapMode Mode>
+bool MappedList<T, Mode>::const_iterator::operator==(const const_iterator& other) const {
+    return base_ == other.base_ && offset_ == other.offset_;
+}
+
+template <class T, MapMode Mode>
+bool MappedList<T, Mode>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+// формат файла не зависит от режима отображения, поэтому сохраняется через MappedList<T> только для чтения
+template <class T, class Allocator, class Stats>
+void save_list(const LinkedList<T, Allocator, Stats>& list, const std::string& path) {
+    MappedList<T>::save(list, path);
+}
+
+// =============================================================================
+
+#endif  // MAPPED_LIST_H
@@ -0,0 +1,201 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// очередь FIFO для передачи элементов между потоками: много производителей, один потребитель (алгоритм Вьюкова)
+// узлы устроены как в LinkedList: NodeBase со ссылкой next и Node с данными, только next здесь атомарный
+// голова head_ - последний опубликованный узел, производители меняют ее одним exchange и затем привязывают
+// свой узел к предыдущему, поэтому push без циклов и повторов: wait-free, если не считать выделения узла
+// хвост tail_ - узел-заглушка перед первым элементом, его читает и двигает только потребитель
+// в начале заглушкой служит член stub_, дальше ею становится последний извлеченный узел с уже разрушенным значением
+
+// между exchange и записью next производителя очередь на мгновение разорвана: элемент уже вставлен,
+// но потребитель его еще не видит; try_pop в этот момент возвращает nullopt, pop и drain дожидаются связи
+
+// try_pop, pop, drain и empty может вызывать только один поток-потребитель одновременно
+// узел освобождает потребитель, он же единственный, кто читает next, поэтому защита памяти эпохами не нужна
+// узлы выделяются через new, а не через PoolAllocator, потому что пул не потокобезопасен
+
+template <class T>
+class MpscQueue {
+public:
+    using value_type = T;
+
+    MpscQueue() noexcept;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    ~MpscQueue();
+
+    bool empty() const noexcept;
+
+    void push(const T& value);
+    void push(T&& value);
+    template <class... Args>
+    void emplace(Args&&... args);
+
+    std::optional<T> try_pop();
+    T pop();
+    template <class Consumer>
+    std::size_t drain(Consumer consume);
+
+private:
+    struct NodeBase {
+        std::atomic<NodeBase*> next;
+
+        NodeBase() noexcept : next(nullptr) {}
+    };
+
+    // значение лежит в объединении, чтобы разрушить его при извлечении, а сам узел оставить заглушкой
+    struct Node : NodeBase {
+        union {
+            value_type data;
+        };
+
+        template <class... Args>
+        explicit Node(Args&&... args) : NodeBase() {
+            ::new (static_cast<void*>(&data)) value_type(std::forward<Args>(args)...);
+        }
+        ~Node() {}
+    };
+
+    static Node* as_node(NodeBase* node) noexcept;
+    NodeBase* wait_next(NodeBase* node) const noexcept;
+    T take_after(NodeBase* tail, NodeBase* next);
+    void link(Node* node) noexcept;
+
+    alignas(64) std::atomic<NodeBase*> head_;
+    alignas(64) NodeBase* tail_;
+    NodeBase stub_;
+};
+
+// =============================================================================
+
+template <class T>
+MpscQueue<T>::MpscQueue() noexcept : head_(&stub_), tail_(&stub_), stub_() {}
+
+// деструктор не может выполняться одновременно с push, у заглушки значение уже разрушено
+template <class T>
+MpscQueue<T>::~MpscQueue() {
+    NodeBase* node = tail_;
+    NodeBase* next = node->next.load(std::memory_order_acquire);
+    if (node != &stub_) {
+        delete as_node(node);
+    }
+    while (next) {
+        node = next;
+        next = node->next.load(std::memory_order_acquire);
+        as_node(node)->data.~value_type();
+        delete as_node(node);
+    }
+}
+
+// =============================================================================
+
+// ответ верен только для потребителя, и элемент, чей производитель еще не привязал узел, не учитывается
+template <class T>
+bool MpscQueue<T>::empty() const noexcept {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+}
+
+// =============================================================================
+
+template <class T>
+void MpscQueue<T>::push(const T& value) {
+    link(new Node(value));
+}
+
+template <class T>
+void MpscQueue<T>::push(T&& value) {
+    link(new Node(std::move(value)));
+}
+
+template <class T>
+template <class... Args>
+void MpscQueue<T>::emplace(Args&&... args) {
+    link(new Node(std::forward<Args>(args)...));
+}
+
+// =============================================================================
+
+template <class T>
+std::optional<T> MpscQueue<T>::try_pop() {
+    NodeBase* next = tail_->next.load(std::memory_order_acquire);
+    if (!next) {
+        return std::nullopt;
+    }
+    return std::optional<T>(take_after(tail_, next));
+}
+
+// ждет, пока в очереди появится элемент, уступая процессор другим потокам
+template <class T>
+T MpscQueue<T>::pop() {
+    NodeBase* next = tail_->next.load(std::memory_order_acquire);
+    while (!next) {
+        std::this_thread::yield();
+        next = tail_->next.load(std::memory_order_acquire);
+    }
+    return take_after(tail_, next);
+}
+
+// забирает все элементы, опубликованные к моменту вызова, одним снимком головы и передает их consume по порядку
+// производители тем временем продолжают добавлять узлы после снимка, они достанутся следующему вызову
+// возвращает число переданных элементов; если consume бросает исключение, его элемент считается извлеченным
+template <class T>
+template <class Consumer>
+std::size_t MpscQueue<T>::drain(Consumer consume) {
+    NodeBase* const last = head_.load(std::memory_order_acquire);
+    std::size_t count = 0;
+    while (tail_ != last) {
+        consume(take_after(tail_, wait_next(tail_)));
+        ++count;
+    }
+    return count;
+}
+
+// =============================================================================
+
+template <class T>
+typename MpscQueue<T>::Node* MpscQueue<T>::as_node(NodeBase* node) noexcept {
+    return static_cast<Node*>(node);
+}
+
+// next узла, который уже не голова, появится, как только его производитель закончит push
+template <class T>
+typename MpscQueue<T>::NodeBase* MpscQueue<T>::wait_next(NodeBase* node) const noexcept {
+    NodeBase* next = node->next.load(std::memory_order_acquire);
+    while (!next) {
+        std::this_thread::yield();
+        next = node->next.load(std::memory_order_acquire);
+    }
+    return next;
+}
+
+// перемещает значение из next наружу, next становится новой заглушкой, старая освобождается
+template <class T>
+T MpscQueue<T>::take_after(NodeBase* tail, NodeBase* next) {
+    Node* node = as_node(next);
+    T value(std::move(node->data));
+    node->data.~value_type();
+    tail_ = next;
+    if (tail != &stub_) {
+        delete as_node(tail);
+    }
+    return value;
+}
+
+// exchange с acquire видит инициализацию предыдущего узла, store с release публикует значение потребителю
+template <class T>
+void MpscQueue<T>::link(Node* node) noexcept {
+    NodeBase* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+// =============================================================================
+
+#endif  // MPSC_QUEUE_H
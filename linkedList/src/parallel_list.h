@@ -0,0 +1,352 @@
+#ifndef PARALLEL_LIST_H
+#define PARALLEL_LIST_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "linked_list.h"
+#include "work_stealing_pool.h"
+
+// параллельные алгоритмы над LinkedList: for_each, count_if, find_first и копирование на WorkStealingPool
+// список нельзя разрезать без обхода, поэтому ListPartition один раз проходит его и запоминает начала кусков
+// по step элементов; разбиение можно построить заранее и использовать повторно, пока в списке не вставляют, не удаляют
+// и не перевязывают узлы (значения элементов менять можно), тогда каждый запуск обходит список только в кусках
+// перегрузки, которые принимают сам список, строят разбиение на kChunksPerThread кусков на поток при каждом вызове,
+// и тогда последовательный проход по списку остается: для дешевых операций выигрыш ограничен им
+
+// куски - задачи пула, неравные по времени куски разбирают освободившиеся потоки
+// function и predicate вызываются одновременно из разных потоков, поэтому должны это позволять
+// find_first_if возвращает тот же элемент, что и последовательный поиск: кусок, где совпадение нашлось, отменяет
+// только куски правее себя, а из найденных берется самый левый
+// parallel_copy берет все узлы копии у аллокатора одним отрезком через allocate_run, и потоки только конструируют
+// элементы на своих местах отрезка, так что аллокатор из потоков не вызывается; если аллокатор этого не умеет
+// (std::allocator, pmr), копия строится обычным последовательным копированием
+// алгоритмы обходят узлы напрямую, минуя итераторы, поэтому в ListStats шаги итераторов и find не учитываются
+
+template <class List>
+struct is_linked_list : std::false_type {};
+
+template <class T, class Allocator, class Stats>
+struct is_linked_list<LinkedList<T, Allocator, Stats>> : std::true_type {};
+
+// доступ к узлам списка и реализации алгоритмов, свободные функции ниже только передают им работу
+struct ListParallel {
+    template <class List>
+    using NodeBase = typename std::remove_const_t<List>::NodeBase;
+    template <class List>
+    using reference = std::conditional_t<std::is_const<List>::value, const typename List::value_type&,
+                                         typename List::value_type&>;
+    template <class List>
+    using iterator = std::conditional_t<std::is_const<List>::value, typename List::const_iterator,
+                                        typename List::iterator>;
+
+    static constexpr std::size_t kCancelCheck = 256;
+
+    template <class List>
+    static NodeBase<List>* first(List& list) noexcept;
+    template <class List>
+    static reference<List> value(NodeBase<List>* node) noexcept;
+    template <class List>
+    static iterator<List> make_iterator(List& list, NodeBase<List>* node) noexcept;
+
+    template <class List, class Function>
+    static void for_each(WorkStealingPool& pool, const ListPartition<List>& partition, Function& function);
+    template <class List, class Predicate>
+    static std::size_t count_if(WorkStealingPool& pool, const ListPartition<List>& partition, Predicate& predicate);
+    template <class List, class Predicate>
+    static iterator<List> find_first_if(WorkStealingPool& pool, const ListPartition<List>& partition, Predicate& predicate);
+    template <class List>
+    static std::remove_const_t<List> copy(WorkStealingPool& pool, const ListPartition<List>& partition);
+};
+
+template <class List>
+class ListPartition {
+public:
+    static constexpr std::size_t kChunksPerThread = 4;
+
+    ListPartition(List& list, std::size_t chunks);
+    ListPartition(List& list, const WorkStealingPool& pool);
+
+    List& list() const noexcept;
+    std::size_t size() const noexcept;
+    std::size_t chunks() const noexcept;
+
+private:
+    friend struct ListParallel;
+
+    std::size_t chunk_size(std::size_t chunk) const noexcept;
+
+    List* list_;
+    std::size_t size_;
+    std::size_t step_;
+    std::vector<typename std::remove_const_t<List>::NodeBase*> starts_;
+};
+
+template <class List, class Function>
+void parallel_for_each(WorkStealingPool& pool, const ListPartition<List>& partition, Function function);
+template <class List, class Function, class = std::enable_if_t<is_linked_list<std::remove_const_t<List>>::value>>
+void parallel_for_each(WorkStealingPool& pool, List& list, Function function);
+
+template <class List, class Predicate>
+std::size_t parallel_count_if(WorkStealingPool& pool, const ListPartition<List>& partition, Predicate predicate);
+template <class List, class Predicate, class = std::enable_if_t<is_linked_list<std::remove_const_t<List>>::value>>
+std::size_t parallel_count_if(WorkStealingPool& pool, List& list, Predicate predicate);
+
+template <class List, class Predicate>
+ListParallel::iterator<List> parallel_find_first_if(WorkStealingPool& pool, const ListPartition<List>& partition,
+                                                     Predicate predicate);
+template <class List, class Predicate, class = std::enable_if_t<is_linked_list<std::remove_const_t<List>>::value>>
+ListParallel::iterator<List> parallel_find_first_if(WorkStealingPool& pool, List& list, Predicate predicate);
+
+template <class List>
+ListParallel::iterator<List> parallel_find_first(WorkStealingPool& pool, const ListPartition<List>& partition,
+                                                  const typename List::value_type& value);
+template <class List, class = std::enable_if_t<is_linked_list<std::remove_const_t<List>>::value>>
+ListParallel::iterator<List> parallel_find_first(WorkStealingPool& pool, List& list,
+                                                  const typename List::value_type& value);
+
+template <class List>
+std::remove_const_t<List> parallel_copy(WorkStealingPool& pool, const ListPartition<List>& partition);
+template <class List, class = std::enable_if_t<is_linked_list<std::remove_const_t<List>>::value>>
+std::remove_const_t<List> parallel_copy(WorkStealingPool& pool, List& list);
+
+// =============================================================================
+
+// кусков не больше, чем элементов; обход останавливается на начале последнего куска
+template <class List>
+ListPartition<List>::ListPartition(List& list, std::size_t chunks) : list_(&list), size_(list.size()), step_(0) {
+    if (size_ == 0) {
+        return;
+    }
+    chunks = std::min(std::max<std::size_t>(chunks, 1), size_);
+    step_ = (size_ + chunks - 1) / chunks;
+    const std::size_t count = (size_ + step_ - 1) / step_;
+    starts_.reserve(count);
+    typename std::remove_const_t<List>::NodeBase* node = ListParallel::first(list);
+    starts_.push_back(node);
+    for (std::size_t chunk = 1; chunk < count; ++chunk) {
+        for (std::size_t i = 0; i < step_; ++i) {
+            node = node->next;
+        }
+        starts_.push_back(node);
+    }
+}
+
+// с одним потоком делить не на что, весь список - один кусок
+template <class List>
+ListPartition<List>::ListPartition(List& list, const WorkStealingPool& pool)
+    : ListPartition(list, pool.concurrency() > 1 ? pool.concurrency() * kChunksPerThread : 1) {}
+
+template <class List>
+List& ListPartition<List>::list() const noexcept {
+    return *list_;
+}
+
+template <class List>
+std::size_t ListPartition<List>::size() const noexcept {
+    return size_;
+}
+
+template <class List>
+std::size_t ListPartition<List>::chunks() const noexcept {
+    return starts_.size();
+}
+
+// все куски по step_ элементов, кроме последнего
+template <class List>
+std::size_t ListPartition<List>::chunk_size(std::size_t chunk) const noexcept {
+    return std::min(step_, size_ - chunk * step_);
+}
+
+// =============================================================================
+
+template <class List>
+ListParallel::NodeBase<List>* ListParallel::first(List& list) noexcept {
+    return list.head_.next;
+}
+
+template <class List>
+ListParallel::reference<List> ListParallel::value(NodeBase<List>* node) noexcept {
+    return std::remove_const_t<List>::as_node(node)->data;
+}
+
+// nullptr дает конец списка
+template <class List>
+ListParallel::iterator<List> ListParallel::make_iterator(List& list, NodeBase<List>* node) noexcept {
+    if constexpr (std::is_const<List>::value) {
+        return list.make_const_iterator(node);
+    } else {
+        return list.make_iterator(node);
+    }
+}
+
+// =============================================================================
+
+template <class List, class Function>
+void ListParallel::for_each(WorkStealingPool& pool, const ListPartition<List>& partition, Function& function) {
+    pool.run(partition.chunks(), [&](std::size_t chunk) {
+        NodeBase<List>* node = partition.starts_[chunk];
+        for (std::size_t i = partition.chunk_size(chunk); i > 0; --i, node = node->next) {
+            function(value<List>(node));
+        }
+    });
+}
+
+// каждый кусок пишет только свой счетчик, сумма считается после завершения всех
+template <class List, class Predicate>
+std::size_t ListParallel::count_if(WorkStealingPool& pool, const ListPartition<List>& partition, Predicate& predicate) {
+    std::vector<std::size_t> counts(partition.chunks(), 0);
+    pool.run(partition.chunks(), [&](std::size_t chunk) {
+        NodeBase<List>* node = partition.starts_[chunk];
+        std::size_t count = 0;
+        for (std::size_t i = partition.chunk_size(chunk); i > 0; --i, node = node->next) {
+            if (predicate(value<List>(node))) {
+                ++count;
+            }
+        }
+        counts[chunk] = count;
+    });
+    std::size_t total = 0;
+    for (std::size_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+// found - номер самого левого куска с совпадением; кусок правее него бросает поиск, проверяя found
+// раз в kCancelCheck элементов, а кусок левее всегда доходит до своего первого совпадения или до конца
+template <class List, class Predicate>
+ListParallel::iterator<List> ListParallel::find_first_if(WorkStealingPool& pool, const ListPartition<List>& partition,
+                                                         Predicate& predicate) {
+    const std::size_t chunks = partition.chunks();
+    std::atomic<std::size_t> found(chunks);
+    std::vector<NodeBase<List>*> hits(chunks, nullptr);
+    pool.run(chunks, [&](std::size_t chunk) {
+        NodeBase<List>* node = partition.starts_[chunk];
+        for (std::size_t i = 0, size = partition.chunk_size(chunk); i < size; ++i, node = node->next) {
+            if (i % kCancelCheck == 0 && found.load(std::memory_order_relaxed) < chunk) {
+                return;
+            }
+            if (predicate(value<List>(node))) {
+                hits[chunk] = node;
+                std::size_t current = found.load();
+                while (chunk < current && !found.compare_exchange_weak(current, chunk)) {
+                }
+                return;
+            }
+        }
+    });
+    const std::size_t chunk = found.load();
+    return make_iterator(partition.list(), chunk < chunks ? hits[chunk] : nullptr);
+}
+
+// кусок номер k занимает в отрезке места с k * step, потоки связывают next внутри своего куска,
+// а последний узел каждого куска сразу указывает на первый узел следующего
+// при исключении пул дожидается остальных кусков, после чего построенные элементы разрушаются, а отрезок освобождается
+template <class List>
+std::remove_const_t<List> ListParallel::copy(WorkStealingPool& pool, const ListPartition<List>& partition) {
+    using Plain = std::remove_const_t<List>;
+    using Node = typename Plain::Node;
+    using node_traits = typename Plain::node_traits;
+    const Plain& source = partition.list();
+    if constexpr (!supports_allocate_run<typename Plain::node_allocator>::value) {
+        return Plain(source);
+    } else {
+        Plain copy(typename Plain::allocator_type(node_traits::select_on_container_copy_construction(source.alloc_)));
+        const std::size_t size = partition.size();
+        Node* run = size > 1 ? copy.alloc_.allocate_run(size) : nullptr;
+        if (!run) {
+            return Plain(source);
+        }
+        std::vector<std::size_t> built(partition.chunks(), 0);
+        try {
+            pool.run(partition.chunks(), [&](std::size_t chunk) {
+                NodeBase<List>* from = partition.starts_[chunk];
+                Node* to = run + chunk * partition.step_;
+                for (std::size_t i = 0, count = partition.chunk_size(chunk); i < count; ++i, from = from->next) {
+                    node_traits::construct(copy.alloc_, to + i, value<List>(from));
+                    to[i].next = to + i + 1;
+                    ++built[chunk];
+                }
+            });
+        } catch (...) {
+            for (std::size_t chunk = 0; chunk < built.size(); ++chunk) {
+                for (std::size_t i = 0; i < built[chunk]; ++i) {
+                    node_traits::destroy(copy.alloc_, run + chunk * partition.step_ + i);
+                }
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                node_traits::deallocate(copy.alloc_, run + i, 1);
+            }
+            throw;
+        }
+        run[size - 1].next = nullptr;
+        copy.link_chain_after(&copy.head_, typename Plain::Chain{run, run + size - 1, size});
+        copy.stats_.on_allocate(size);
+        copy.stats_.on_copy(size);
+        return copy;
+    }
+}
+
+// =============================================================================
+
+template <class List, class Function>
+void parallel_for_each(WorkStealingPool& pool, const ListPartition<List>& partition, Function function) {
+    ListParallel::for_each(pool, partition, function);
+}
+
+template <class List, class Function, class>
+void parallel_for_each(WorkStealingPool& pool, List& list, Function function) {
+    ListParallel::for_each(pool, ListPartition<List>(list, pool), function);
+}
+
+template <class List, class Predicate>
+std::size_t parallel_count_if(WorkStealingPool& pool, const ListPartition<List>& partition, Predicate predicate) {
+    return ListParallel::count_if(pool, partition, predicate);
+}
+
+template <class List, class Predicate, class>
+std::size_t parallel_count_if(WorkStealingPool& pool, List& list, Predicate predicate) {
+    return ListParallel::count_if(pool, ListPartition<List>(list, pool), predicate);
+}
+
+template <class List, class Predicate>
+ListParallel::iterator<List> parallel_find_first_if(WorkStealingPool& pool, const ListPartition<List>& partition,
+                                                     Predicate predicate) {
+    return ListParallel::find_first_if(pool, partition, predicate);
+}
+
+template <class List, class Predicate, class>
+ListParallel::iterator<List> parallel_find_first_if(WorkStealingPool& pool, List& list, Predicate predicate) {
+    return ListParallel::find_first_if(pool, ListPartition<List>(list, pool), predicate);
+}
+
+template <class List>
+ListParallel::iterator<List> parallel_find_first(WorkStealingPool& pool, const ListPartition<List>& partition,
+                                                  const typename List::value_type& value) {
+    return parallel_find_first_if(pool, partition, [&value](const typename List::value_type& element) {
+        return element == value;
+    });
+}
+
+template <class List, class>
+ListParallel::iterator<List> parallel_find_first(WorkStealingPool& pool, List& list,
+                                                  const typename List::value_type& value) {
+    return parallel_find_first(pool, ListPartition<List>(list, pool), value);
+}
+
+template <class List>
+std::remove_const_t<List> parallel_copy(WorkStealingPool& pool, const ListPartition<List>& partition) {
+    return ListParallel::copy(pool, partition);
+}
+
+template <class List, class>
+std::remove_const_t<List> parallel_copy(WorkStealingPool& pool, List& list) {
+    return ListParallel::copy(pool, ListPartition<List>(list, pool));
+}
+
+// =============================================================================
+
+#endif  // PARALLEL_LIST_H
@@ -0,0 +1,385 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// аллокатор узлов, который LinkedList использует по умолчанию
+// вместо отдельного обращения к куче на каждый узел память берется из больших непрерывных блоков (slab),
+// освобожденные узлы попадают в список свободных и переиспользуются при следующем выделении,
+// поэтому соседние узлы оказываются рядом в памяти и обход списка затрагивает меньше кеш-линий
+
+// SlabPool раздает блоки фиксированных размеров: для каждой пары размер/выравнивание заводится свой класс
+// со своими slab и списком свободных блоков, поэтому один пул обслуживает и узлы, и служебные структуры контейнера
+// классов не больше kMaxClasses, запросы сверх этого или больше одного объекта уходят в обычный operator new,
+// при этом освобождение однозначно определяет, откуда был взят блок, по тому же размеру
+// вся память slab возвращается системе только при уничтожении пула
+// allocate_run выдает n блоков подряд из одного slab, каждый из них потом освобождается отдельно,
+// так контейнер может разместить узлы пачки рядом друг с другом
+// deallocate_chain возвращает сразу цепочку блоков, уже связанных через первое слово, как в списке свободных:
+// пул присоединяет ее к своему списку за O(1), не обходя, так контейнер освобождает все свои узлы разом
+// связывает блоки link_free: он создает в блоке звено списка свободных, поэтому объект, который жил в блоке, должен
+// быть уже разрушен (его время жизни закончено), а адрес следующего блока прочитан из объекта заранее
+// пул не потокобезопасен, как и сам LinkedList
+
+class SlabPool {
+public:
+    SlabPool() = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+    ~SlabPool();
+
+    void* allocate(std::size_t size, std::size_t align);
+    void deallocate(void* block, std::size_t size, std::size_t align) noexcept;
+    void* allocate_run(std::size_t size, std::size_t align, std::size_t count);
+    void deallocate_chain(void* first, void* last, std::size_t size, std::size_t align) noexcept;
+    static void link_free(void* block, void* next) noexcept;
+
+    std::size_t block_size(std::size_t size, std::size_t align) const noexcept;
+    std::size_t capacity() const noexcept;
+    std::size_t bytes_reserved() const noexcept;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        std::size_t size;
+        std::size_t align;
+        std::size_t block_size;
+        std::size_t block_align;
+        std::size_t next_chunk_bytes;
+        FreeBlock* free_list;
+        char* bump;
+        char* bump_end;
+    };
+
+    struct Chunk {
+        void* memory;
+        std::size_t align;
+    };
+
+    static constexpr std::size_t kMaxClasses = 8;
+    static constexpr std::size_t kFirstChunkBytes = 4096;
+    static constexpr std::size_t kMaxChunkBytes = 1 << 20;
+
+    SizeClass* find_class(std::size_t size, std::size_t align) noexcept;
+    const SizeClass* find_class(std::size_t size, std::size_t align) const noexcept;
+    SizeClass* add_class(std::size_t size, std::size_t align);
+    void grow(SizeClass& size_class, std::size_t min_blocks = 1);
+
+    std::size_t capacity_ = 0;
+    std::size_t bytes_reserved_ = 0;
+    std::vector<SizeClass> classes_;
+    std::vector<Chunk> chunks_;
+};
+
+// копии аллокатора, в том числе перепривязанные к другому типу, разделяют один пул,
+// поэтому get_allocator() списка можно передать другому списку, чтобы они работали с общей памятью
+// при копировании контейнера select_on_container_copy_construction создает новый пул,
+// чтобы копия не удерживала память оригинала
+// пул создается сразу в конструкторе, а не при первом выделении: так все перепривязанные копии, которые контейнер
+// делает из одного аллокатора, гарантированно попадают в один пул, а равенство аллокаторов не меняется со временем
+// (от него зависит, перевязывают ли контейнеры узлы или переносят элементы); пустой список стоит одного выделения
+
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    PoolAllocator();
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept;
+
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+
+    T* allocate(std::size_t n);
+    void deallocate(T* p, std::size_t n) noexcept;
+    T* allocate_run(std::size_t count);
+    void deallocate_chain(T* first, T* last) noexcept;
+    static void link_free(T* block, T* next) noexcept;
+
+    PoolAllocator select_on_container_copy_construction() const;
+
+    const SlabPool& pool() const noexcept;
+
+    template <class U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept;
+    template <class U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept;
+
+private:
+    template <class U>
+    friend class PoolAllocator;
+
+    std::shared_ptr<SlabPool> pool_;
+};
+
+// =============================================================================
+
+inline SlabPool::~SlabPool() {
+    for (const Chunk& chunk : chunks_) {
+        ::operator delete(chunk.memory, std::align_val_t(chunk.align));
+    }
+}
+
+// первый запрос нового размера заводит для него класс, последующие запросы того же размера обслуживаются пулом
+inline void* SlabPool::allocate(std::size_t size, std::size_t align) {
+    SizeClass* size_class = find_class(size, align);
+    if (!size_class) {
+        size_class = add_class(size, align);
+    }
+    if (!size_class) {
+        return ::operator new(size, std::align_val_t(align));
+    }
+    if (size_class->free_list) {
+        FreeBlock* block = size_class->free_list;
+        size_class->free_list = block->next;
+        return block;
+    }
+    if (size_class->bump == size_class->bump_end) {
+        grow(*size_class);
+    }
+    void* block = size_class->bump;
+    size_class->bump += size_class->block_size;
+    return block;
+}
+
+inline void SlabPool::deallocate(void* block, std::size_t size, std::size_t align) noexcept {
+    SizeClass* size_class = find_class(size, align);
+    if (!size_class) {
+        ::operator delete(block, std::align_val_t(align));
+        return;
+    }
+    auto free_block = static_cast<FreeBlock*>(block);
+    free_block->next = size_class->free_list;
+    size_class->free_list = free_block;
+}
+
+// отрезок используется как массив объектов размера size, поэтому выдается, только если блок класса равен size
+// возвращает nullptr, если классов уже kMaxClasses или блок больше объекта (объекты меньше указателя)
+// если в текущем slab не хватает места, его остаток уходит в список свободных, а новый slab вмещает весь отрезок
+inline void* SlabPool::allocate_run(std::size_t size, std::size_t align, std::size_t count) {
+    SizeClass* size_class = find_class(size, align);
+    if (!size_class) {
+        size_class = add_class(size, align);
+    }
+    if (!size_class || size_class->block_size != size) {
+        return nullptr;
+    }
+    const std::size_t bytes = count * size_class->block_size;
+    if (static_cast<std::size_t>(size_class->bump_end - size_class->bump) < bytes) {
+        for (; size_class->bump != size_class->bump_end; size_class->bump += size_class->block_size) {
+            auto free_block = reinterpret_cast<FreeBlock*>(size_class->bump);
+            free_block->next = size_class->free_list;
+            size_class->free_list = free_block;
+        }
+        grow(*size_class, count);
+    }
+    void* run = size_class->bump;
+    size_class->bump += bytes;
+    return run;
+}
+
+// цепочка от first до last включительно, каждый блок связан со следующим через link_free
+// блоки размера, который пул не обслуживает, были выделены через operator new, их приходится освобождать по одному
+inline void SlabPool::deallocate_chain(void* first, void* last, std::size_t size, std::size_t align) noexcept {
+    SizeClass* size_class = find_class(size, align);
+    auto tail = static_cast<FreeBlock*>(last);
+    if (!size_class) {
+        for (auto block = static_cast<FreeBlock*>(first);;) {
+            FreeBlock* next = block->next;
+            ::operator delete(block, std::align_val_t(align));
+            if (block == tail) {
+                break;
+            }
+            block = next;
+        }
+        return;
+    }
+    tail->next = size_class->free_list;
+    size_class->free_list = static_cast<FreeBlock*>(first);
+}
+
+// block - память, объект в которой уже разрушен, next - следующий блок цепочки (его объект может быть еще жив)
+inline void SlabPool::link_free(void* block, void* next) noexcept {
+    ::new (block) FreeBlock{static_cast<FreeBlock*>(next)};
+}
+
+// =============================================================================
+
+// размер блока, которым пул обслуживает объекты такого размера, или 0, если пул их не обслуживает
+inline std::size_t SlabPool::block_size(std::size_t size, std::size_t align) const noexcept {
+    const SizeClass* size_class = find_class(size, align);
+    return size_class ? size_class->block_size : 0;
+}
+
+// количество блоков во всех slab, включая еще не выданные
+inline std::size_t SlabPool::capacity() const noexcept {
+    return capacity_;
+}
+
+inline std::size_t SlabPool::bytes_reserved() const noexcept {
+    return bytes_reserved_;
+}
+
+// =============================================================================
+
+// классов немного, обычно один или два, поэтому линейный поиск дешевле любой таблицы
+inline SlabPool::SizeClass* SlabPool::find_class(std::size_t size, std::size_t align) noexcept {
+    for (SizeClass& size_class : classes_) {
+        if (size_class.size == size && size_class.align == align) {
+            return &size_class;
+        }
+    }
+    return nullptr;
+}
+
+inline const SlabPool::SizeClass* SlabPool::find_class(std::size_t size, std::size_t align) const noexcept {
+    for (const SizeClass& size_class : classes_) {
+        if (size_class.size == size && size_class.align == align) {
+            return &size_class;
+        }
+    }
+    return nullptr;
+}
+
+inline SlabPool::SizeClass* SlabPool::add_class(std::size_t size, std::size_t align) {
+    if (classes_.size() == kMaxClasses) {
+        return nullptr;
+    }
+    if (classes_.capacity() == 0) {
+        classes_.reserve(kMaxClasses);
+    }
+    SizeClass size_class{};
+    size_class.size = size;
+    size_class.align = align;
+    size_class.block_align = align < alignof(FreeBlock) ? alignof(FreeBlock) : align;
+    size_class.block_size = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+    size_class.block_size = (size_class.block_size + size_class.block_align - 1) / size_class.block_align * size_class.block_align;
+    size_class.next_chunk_bytes = kFirstChunkBytes;
+    classes_.push_back(size_class);
+    return &classes_.back();
+}
+
+// каждый следующий slab класса вдвое больше предыдущего, пока не достигнет kMaxChunkBytes
+// slab под отрезок allocate_run может быть больше, чтобы вместить min_blocks блоков
+inline void SlabPool::grow(SizeClass& size_class, std::size_t min_blocks) {
+    std::size_t blocks = size_class.next_chunk_bytes / size_class.block_size;
+    if (blocks < min_blocks) {
+        blocks = min_blocks;
+    }
+    const std::size_t bytes = blocks * size_class.block_size;
+    chunks_.reserve(chunks_.size() + 1);
+    size_class.bump = static_cast<char*>(::operator new(bytes, std::align_val_t(size_class.block_align)));
+    size_class.bump_end = size_class.bump + bytes;
+    chunks_.push_back(Chunk{size_class.bump, size_class.block_align});
+    capacity_ += blocks;
+    bytes_reserved_ += bytes;
+    if (size_class.next_chunk_bytes < kMaxChunkBytes) {
+        size_class.next_chunk_bytes *= 2;
+    }
+}
+
+// =============================================================================
+
+template <class T>
+PoolAllocator<T>::PoolAllocator() : pool_(std::make_shared<SlabPool>()) {}
+
+template <class T>
+template <class U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+// =============================================================================
+
+template <class T>
+T* PoolAllocator<T>::allocate(std::size_t n) {
+    if (n != 1) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+    return static_cast<T*>(pool_->allocate(sizeof(T), alignof(T)));
+}
+
+template <class T>
+void PoolAllocator<T>::deallocate(T* p, std::size_t n) noexcept {
+    if (n != 1) {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+        return;
+    }
+    pool_->deallocate(p, sizeof(T), alignof(T));
+}
+
+// count отдельных объектов подряд, каждый освобождается через deallocate(p, 1), или nullptr, если пул не может их выдать
+template <class T>
+T* PoolAllocator<T>::allocate_run(std::size_t count) {
+    return static_cast<T*>(pool_->allocate_run(sizeof(T), alignof(T), count));
+}
+
+// блоки от first до last, выделенные по одному; объекты в них уже разрушены, а блоки связаны через link_free
+template <class T>
+void PoolAllocator<T>::deallocate_chain(T* first, T* last) noexcept {
+    pool_->deallocate_chain(first, last, sizeof(T), alignof(T));
+}
+
+template <class T>
+void PoolAllocator<T>::link_free(T* block, T* next) noexcept {
+    SlabPool::link_free(block, next);
+}
+
+template <class T>
+PoolAllocator<T> PoolAllocator<T>::select_on_container_copy_construction() const {
+    return PoolAllocator();
+}
+
+template <class T>
+const SlabPool& PoolAllocator<T>::pool() const noexcept {
+    return *pool_;
+}
+
+// =============================================================================
+
+template <class T>
+template <class U>
+bool PoolAllocator<T>::operator==(const PoolAllocator<U>& other) const noexcept {
+    return pool_ == other.pool_;
+}
+
+template <class T>
+template <class U>
+bool PoolAllocator<T>::operator!=(const PoolAllocator<U>& other) const noexcept {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+// аллокаторы с allocate_run, контейнеры проверяют это при сборке пачки узлов
+template <class Alloc, class = void>
+struct supports_allocate_run : std::false_type {};
+
+template <class Alloc>
+struct supports_allocate_run<Alloc, std::void_t<decltype(std::declval<Alloc&>().allocate_run(std::size_t()))>>
+    : std::true_type {};
+
+// аллокаторы с deallocate_chain и link_free, контейнеры проверяют это при освобождении всех узлов
+template <class Alloc, class = void>
+struct supports_deallocate_chain : std::false_type {};
+
+template <class Alloc>
+struct supports_deallocate_chain<Alloc, std::void_t<decltype(std::declval<Alloc&>().deallocate_chain(
+    std::declval<typename Alloc::value_type*>(), std::declval<typename Alloc::value_type*>())),
+    decltype(Alloc::link_free(std::declval<typename Alloc::value_type*>(), std::declval<typename Alloc::value_type*>()))>>
+    : std::true_type {};
+
+// =============================================================================
+
+#endif  // POOL_ALLOCATOR_H
@@ -0,0 +1,285 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_SEARCH_X86 1
+#else
+#define SIMD_SEARCH_X86 0
+#endif
+
+// поиск и подсчет значения в непрерывном массиве арифметических элементов с помощью SSE2/AVX2
+// набор инструкций выбирается один раз при первом вызове по возможностям процессора,
+// AVX2-ядра собираются атрибутом target, поэтому весь проект можно собирать без -mavx2
+// на других архитектурах и для неподдерживаемых типов (long double) используется обычный цикл
+// сравнение векторное, но с той же семантикой, что и ==: NaN не равен ничему, -0.0 равен 0.0
+
+namespace simd {
+
+enum class Level { Scalar, Sse2, Avx2 };
+
+template <class T>
+constexpr bool is_searchable() {
+    return std::is_arithmetic<T>::value &&
+           (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+}
+
+Level level() noexcept;
+
+template <class T>
+const T* find(const T* first, const T* last, T value) noexcept;
+template <class T>
+std::size_t count(const T* first, const T* last, T value) noexcept;
+
+template <class T>
+const T* find_scalar(const T* first, const T* last, T value) noexcept;
+template <class T>
+std::size_t count_scalar(const T* first, const T* last, T value) noexcept;
+
+// ядра find_sse2, count_sse2, find_avx2, count_avx2 определяются до диспетчера без предварительных объявлений:
+// объявление без атрибута target и определение с ним GCC считает разными версиями функции
+
+// =============================================================================
+
+inline Level detect_level() noexcept {
+#if SIMD_SEARCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Level::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Level::Sse2;
+    }
+#endif
+    return Level::Scalar;
+}
+
+inline Level level() noexcept {
+    static const Level detected = detect_level();
+    return detected;
+}
+
+// =============================================================================
+
+template <class T>
+const T* find_scalar(const T* first, const T* last, T value) noexcept {
+    for (; first != last; ++first) {
+        if (*first == value) {
+            return first;
+        }
+    }
+    return last;
+}
+
+template <class T>
+std::size_t count_scalar(const T* first, const T* last, T value) noexcept {
+    std::size_t result = 0;
+    for (; first != last; ++first) {
+        result += *first == value;
+    }
+    return result;
+}
+
+// =============================================================================
+
+#if SIMD_SEARCH_X86
+
+// значения всех типов лежат в целочисленных регистрах, равенство дает маску из единиц в совпавших элементах,
+// после movemask на каждый элемент приходится sizeof(T) одинаковых бит
+// искомое значение хранится в поле матчера, чтобы векторы не передавались через аргументы функций
+
+template <class T>
+struct Sse2Matcher {
+    __m128i needle;
+
+    __attribute__((target("sse2"), always_inline)) explicit Sse2Matcher(T value) {
+        if constexpr (std::is_same<T, float>::value) {
+            needle = _mm_castps_si128(_mm_set1_ps(value));
+        } else if constexpr (std::is_same<T, double>::value) {
+            needle = _mm_castpd_si128(_mm_set1_pd(value));
+        } else if constexpr (sizeof(T) == 1) {
+            needle = _mm_set1_epi8(static_cast<char>(value));
+        } else if constexpr (sizeof(T) == 2) {
+            needle = _mm_set1_epi16(static_cast<short>(value));
+        } else if constexpr (sizeof(T) == 4) {
+            needle = _mm_set1_epi32(static_cast<int>(value));
+        } else {
+            needle = _mm_set1_epi64x(static_cast<long long>(value));
+        }
+    }
+
+    // в SSE2 нет сравнения 64-битных целых, поэтому сравниваются половины и результат объединяется с переставленным
+    __attribute__((target("sse2"), always_inline)) unsigned equal_bits(const T* p) const {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i equal;
+        if constexpr (std::is_same<T, float>::value) {
+            equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+        } else if constexpr (std::is_same<T, double>::value) {
+            equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+        } else if constexpr (sizeof(T) == 1) {
+            equal = _mm_cmpeq_epi8(block, needle);
+        } else if constexpr (sizeof(T) == 2) {
+            equal = _mm_cmpeq_epi16(block, needle);
+        } else if constexpr (sizeof(T) == 4) {
+            equal = _mm_cmpeq_epi32(block, needle);
+        } else {
+            const __m128i halves = _mm_cmpeq_epi32(block, needle);
+            equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+        return static_cast<unsigned>(_mm_movemask_epi8(equal));
+    }
+};
+
+template <class T>
+__attribute__((target("sse2"))) const T* find_sse2(const T* first, const T* last, T value) noexcept {
+    constexpr std::ptrdiff_t kLanes = 16 / sizeof(T);
+    const Sse2Matcher<T> matcher(value);
+    for (; last - first >= kLanes; first += kLanes) {
+        const unsigned bits = matcher.equal_bits(first);
+        if (bits) {
+            return first + __builtin_ctz(bits) / sizeof(T);
+        }
+    }
+    return find_scalar(first, last, value);
+}
+
+template <class T>
+__attribute__((target("sse2"))) std::size_t count_sse2(const T* first, const T* last, T value) noexcept {
+    constexpr std::ptrdiff_t kLanes = 16 / sizeof(T);
+    const Sse2Matcher<T> matcher(value);
+    std::size_t bits = 0;
+    for (; last - first >= kLanes; first += kLanes) {
+        bits += static_cast<std::size_t>(__builtin_popcount(matcher.equal_bits(first)));
+    }
+    return bits / sizeof(T) + count_scalar(first, last, value);
+}
+
+// =============================================================================
+
+template <class T>
+struct Avx2Matcher {
+    __m256i needle;
+
+    __attribute__((target("avx2"), always_inline)) explicit Avx2Matcher(T value) {
+        if constexpr (std::is_same<T, float>::value) {
+            needle = _mm256_castps_si256(_mm256_set1_ps(value));
+        } else if constexpr (std::is_same<T, double>::value) {
+            needle = _mm256_castpd_si256(_mm256_set1_pd(value));
+        } else if constexpr (sizeof(T) == 1) {
+            needle = _mm256_set1_epi8(static_cast<char>(value));
+        } else if constexpr (sizeof(T) == 2) {
+            needle = _mm256_set1_epi16(static_cast<short>(value));
+        } else if constexpr (sizeof(T) == 4) {
+            needle = _mm256_set1_epi32(static_cast<int>(value));
+        } else {
+            needle = _mm256_set1_epi64x(static_cast<long long>(value));
+        }
+    }
+
+    __attribute__((target("avx2"), always_inline)) __m256i equal(const T* p) const {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        if constexpr (std::is_same<T, float>::value) {
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+        } else if constexpr (std::is_same<T, double>::value) {
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+        } else if constexpr (sizeof(T) == 1) {
+            return _mm256_cmpeq_epi8(block, needle);
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_cmpeq_epi16(block, needle);
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_cmpeq_epi32(block, needle);
+        } else {
+            return _mm256_cmpeq_epi64(block, needle);
+        }
+    }
+
+    __attribute__((target("avx2"), always_inline)) unsigned equal_bits(const T* p) const {
+        return static_cast<unsigned>(_mm256_movemask_epi8(equal(p)));
+    }
+
+    // есть ли совпадение среди четырех подряд идущих векторов, без вычисления позиции
+    __attribute__((target("avx2"), always_inline)) bool any_equal4(const T* p) const {
+        constexpr std::size_t kLanes = 32 / sizeof(T);
+        const __m256i first = equal(p);
+        const __m256i second = equal(p + kLanes);
+        const __m256i third = equal(p + 2 * kLanes);
+        const __m256i fourth = equal(p + 3 * kLanes);
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(first, second), _mm256_or_si256(third, fourth));
+        return !_mm256_testz_si256(any, any);
+    }
+};
+
+template <class T>
+__attribute__((target("avx2"))) const T* find_avx2(const T* first, const T* last, T value) noexcept {
+    constexpr std::ptrdiff_t kLanes = 32 / sizeof(T);
+    const Avx2Matcher<T> matcher(value);
+    // длинные участки сначала проверяются по четыре вектора за раз, позиция ищется уже внутри найденной четверки
+    for (; last - first >= 4 * kLanes; first += 4 * kLanes) {
+        if (matcher.any_equal4(first)) {
+            break;
+        }
+    }
+    for (; last - first >= kLanes; first += kLanes) {
+        const unsigned bits = matcher.equal_bits(first);
+        if (bits) {
+            return first + __builtin_ctz(bits) / sizeof(T);
+        }
+    }
+    return find_sse2(first, last, value);
+}
+
+template <class T>
+__attribute__((target("avx2"))) std::size_t count_avx2(const T* first, const T* last, T value) noexcept {
+    constexpr std::ptrdiff_t kLanes = 32 / sizeof(T);
+    const Avx2Matcher<T> matcher(value);
+    std::size_t bits = 0;
+    for (; last - first >= kLanes; first += kLanes) {
+        bits += static_cast<std::size_t>(__builtin_popcount(matcher.equal_bits(first)));
+    }
+    return bits / sizeof(T) + count_sse2(first, last, value);
+}
+
+#endif
+
+// =============================================================================
+
+template <class T>
+const T* find(const T* first, const T* last, T value) noexcept {
+#if SIMD_SEARCH_X86
+    if constexpr (is_searchable<T>()) {
+        switch (level()) {
+        case Level::Avx2:
+            return find_avx2(first, last, value);
+        case Level::Sse2:
+            return find_sse2(first, last, value);
+        case Level::Scalar:
+            break;
+        }
+    }
+#endif
+    return find_scalar(first, last, value);
+}
+
+template <class T>
+std::size_t count(const T* first, const T* last, T value) noexcept {
+#if SIMD_SEARCH_X86
+    if constexpr (is_searchable<T>()) {
+        switch (level()) {
+        case Level::Avx2:
+            return count_avx2(first, last, value);
+        case Level::Sse2:
+            return count_sse2(first, last, value);
+        case Level::Scalar:
+            break;
+        }
+    }
+#endif
+    return count_scalar(first, last, value);
+}
+
+}  // namespace simd
+
+#endif  // SIMD_SEARCH_H
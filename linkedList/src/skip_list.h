@@ -0,0 +1,547 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include "pool_allocator.h"
+
+// упорядоченный односвязный список со списками пропусков (skip list)
+// нижний уровень устроен так же, как LinkedList, и хранит все элементы по возрастанию,
+// поэтому обычный итератор обходит элементы в отсортированном порядке
+// над ним лежат экспресс-полосы: на уровне l из узлов Index, каждый ссылается на узел нижнего уровня,
+// на соседний Index справа и на Index того же узла уровнем ниже
+// высота узла выбирается случайно с вероятностью 1/4 на каждый следующий уровень,
+// поэтому find, insert и erase спускаются по полосам за ожидаемое O(log n)
+
+// равные элементы допускаются, insert ставит новый элемент после уже имеющихся равных,
+// а find и erase работают с первым из равных, как линейный поиск в LinkedList
+// узлы и Index выделяются одним аллокатором, для PoolAllocator это два класса размеров одного пула
+
+template <class T, class Compare = std::less<T>, class Allocator = PoolAllocator<T>>
+class SkipList {
+public:
+    using value_type = T;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = T&;
+    using const_reference = const T&;
+
+    SkipList();
+    explicit SkipList(const Allocator& alloc);
+    explicit SkipList(const Compare& compare, const Allocator& alloc = Allocator());
+    SkipList(const SkipList& other);
+    SkipList(SkipList&& other) noexcept;
+    SkipList(std::initializer_list<T> il);
+    ~SkipList();
+
+    SkipList& operator=(const SkipList& other);
+    SkipList& operator=(SkipList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const;
+
+    const_reference front() const;
+
+    class const_iterator;
+    using iterator = const_iterator;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+
+    const_iterator insert(const T& value);
+    const_iterator insert(T&& value);
+    bool erase(const T& value);
+    void pop_front();
+    void clear() noexcept;
+
+    const_iterator find(const T& value) const;
+
+private:
+    static constexpr int kMaxLevel = 16;
+
+    struct Node {
+        value_type data;
+        Node* next;
+
+        Node(const value_type& data) : data(data), next(nullptr) {}
+        Node(value_type&& data) : data(std::move(data)), next(nullptr) {}
+    };
+
+    struct Index {
+        Node* node;
+        Index* right;
+        Index* down;
+    };
+
+    // предшественники искомой позиции на каждом уровне, nullptr означает начало уровня
+    struct Path {
+        Index* lanes[kMaxLevel];
+        Node* base;
+    };
+
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+    using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Index>;
+    using index_traits = std::allocator_traits<index_allocator>;
+
+    bool before(const T& lhs, const T& rhs) const;
+    template <bool AfterEqual>
+    void search(const T& value, Path& path) const;
+    template <class U>
+    const_iterator insert_value(U&& value);
+    void link(Node* node, Path& path);
+    void append(Node* node, Path& tails);
+    int random_level();
+
+    template <class... Args>
+    Node* create_node(Args&&... args);
+    void destroy_node(Node* node) noexcept;
+    Index* create_index(Node* node, Index* right, Index* down);
+    void destroy_index(Index* index) noexcept;
+    void copy_from(const SkipList& other);
+
+    Compare compare_;
+    node_allocator node_alloc_;
+    index_allocator index_alloc_;
+    Node* head_;
+    Index* lanes_[kMaxLevel];
+    int levels_;
+    std::size_t size_;
+    std::minstd_rand random_;
+
+public:
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        explicit const_iterator(const Node* node);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const Node* node_;
+    };
+};
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList() : SkipList(Compare(), Allocator()) {}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList(const Allocator& alloc) : SkipList(Compare(), alloc) {}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList(const Compare& compare, const Allocator& alloc)
+    : compare_(compare), node_alloc_(alloc), index_alloc_(alloc), head_(nullptr), lanes_{}, levels_(0), size_(0) {}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList(const SkipList& other)
+    : SkipList(other.compare_, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
+    copy_from(other);
+}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList(SkipList&& other) noexcept
+    : compare_(other.compare_), node_alloc_(other.node_alloc_), index_alloc_(other.index_alloc_),
+      head_(other.head_), levels_(other.levels_), size_(other.size_) {
+    std::copy(other.lanes_, other.lanes_ + kMaxLevel, lanes_);
+    other.head_ = nullptr;
+    std::fill(other.lanes_, other.lanes_ + kMaxLevel, nullptr);
+    other.levels_ = 0;
+    other.size_ = 0;
+}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::SkipList(std::initializer_list<T> il) : SkipList() {
+    try {
+        for (const T& value : il) {
+            insert(value);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::~SkipList() {
+    clear();
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>& SkipList<T, Compare, Allocator>::operator=(const SkipList& other) {
+    if (this != &other) {
+        clear();
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+            node_alloc_ = other.node_alloc_;
+            index_alloc_ = other.index_alloc_;
+        }
+        compare_ = other.compare_;
+        copy_from(other);
+    }
+    return *this;
+}
+
+// при неравных и нераспространяемых аллокаторах элементы перемещаются поштучно в новые узлы
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>& SkipList<T, Compare, Allocator>::operator=(SkipList&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this != &other) {
+        clear();
+        compare_ = other.compare_;
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            node_alloc_ = other.node_alloc_;
+            index_alloc_ = other.index_alloc_;
+        } else if (node_alloc_ != other.node_alloc_) {
+            Path tails{};
+            for (Node* node = other.head_; node; node = node->next) {
+                append(create_node(std::move(node->data)), tails);
+            }
+            other.clear();
+            return *this;
+        }
+        head_ = other.head_;
+        std::copy(other.lanes_, other.lanes_ + kMaxLevel, lanes_);
+        levels_ = other.levels_;
+        size_ = other.size_;
+        other.head_ = nullptr;
+        std::fill(other.lanes_, other.lanes_ + kMaxLevel, nullptr);
+        other.levels_ = 0;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::allocator_type SkipList<T, Compare, Allocator>::get_allocator() const {
+    return allocator_type(node_alloc_);
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_reference SkipList<T, Compare, Allocator>::front() const {
+    if (!head_) {
+        throw std::runtime_error("SkipList is empty");
+    }
+    return head_->data;
+}
+
+// элементы меняются только через insert и erase, иначе нарушился бы порядок, поэтому итератор только константный
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::begin() const {
+    return cbegin();
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::end() const {
+    return cend();
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::cbegin() const {
+    if (!head_) {
+        throw std::runtime_error("SkipList is empty");
+    }
+    return const_iterator(head_);
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::cend() const {
+    return const_iterator(nullptr);
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+bool SkipList<T, Compare, Allocator>::empty() const noexcept {
+    return head_ == nullptr;
+}
+
+template <class T, class Compare, class Allocator>
+std::size_t SkipList<T, Compare, Allocator>::size() const noexcept {
+    return size_;
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::insert(const T& value) {
+    return insert_value(value);
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::insert(T&& value) {
+    return insert_value(std::move(value));
+}
+
+// первый из равных элементов является первым узлом после предшественников на каждом уровне,
+// поэтому его Index, если они есть, стоят сразу за path.lanes[level]
+template <class T, class Compare, class Allocator>
+bool SkipList<T, Compare, Allocator>::erase(const T& value) {
+    Path path;
+    search<false>(value, path);
+    Node* target = path.base ? path.base->next : head_;
+    if (!target || before(value, target->data)) {
+        return false;
+    }
+    for (int level = 0; level < levels_; ++level) {
+        Index*& slot = path.lanes[level] ? path.lanes[level]->right : lanes_[level];
+        if (!slot || slot->node != target) {
+            break;
+        }
+        Index* index = slot;
+        slot = index->right;
+        destroy_index(index);
+    }
+    (path.base ? path.base->next : head_) = target->next;
+    destroy_node(target);
+    --size_;
+    while (levels_ > 0 && !lanes_[levels_ - 1]) {
+        --levels_;
+    }
+    return true;
+}
+
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::pop_front() {
+    if (head_) {
+        erase(head_->data);
+    }
+}
+
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::clear() noexcept {
+    for (int level = 0; level < levels_; ++level) {
+        while (lanes_[level]) {
+            Index* right = lanes_[level]->right;
+            destroy_index(lanes_[level]);
+            lanes_[level] = right;
+        }
+    }
+    while (head_) {
+        Node* next = head_->next;
+        destroy_node(head_);
+        head_ = next;
+    }
+    levels_ = 0;
+    size_ = 0;
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::find(const T& value) const {
+    Path path;
+    search<false>(value, path);
+    const Node* node = path.base ? path.base->next : head_;
+    if (node && !before(value, node->data)) {
+        return const_iterator(node);
+    }
+    return cend();
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+bool SkipList<T, Compare, Allocator>::before(const T& lhs, const T& rhs) const {
+    return compare_(lhs, rhs);
+}
+
+// спуск сверху вниз: на каждом уровне идем вправо, пока следующий элемент меньше value
+// (или не больше value, если AfterEqual), затем опускаемся по down, а с нижней полосы переходим на узлы
+template <class T, class Compare, class Allocator>
+template <bool AfterEqual>
+void SkipList<T, Compare, Allocator>::search(const T& value, Path& path) const {
+    auto goes_before = [this, &value](const T& data) {
+        return AfterEqual ? !before(value, data) : before(data, value);
+    };
+    Index* pred = nullptr;
+    for (int level = levels_ - 1; level >= 0; --level) {
+        Index* next = pred ? pred->right : lanes_[level];
+        while (next && goes_before(next->node->data)) {
+            pred = next;
+            next = next->right;
+        }
+        path.lanes[level] = pred;
+        if (level > 0 && pred) {
+            pred = pred->down;
+        }
+    }
+    Node* base = pred ? pred->node : nullptr;
+    Node* next = base ? base->next : head_;
+    while (next && goes_before(next->data)) {
+        base = next;
+        next = next->next;
+    }
+    path.base = base;
+}
+
+template <class T, class Compare, class Allocator>
+template <class U>
+typename SkipList<T, Compare, Allocator>::const_iterator SkipList<T, Compare, Allocator>::insert_value(U&& value) {
+    Path path;
+    search<true>(value, path);
+    Node* node = create_node(std::forward<U>(value));
+    try {
+        link(node, path);
+    } catch (...) {
+        destroy_node(node);
+        throw;
+    }
+    return const_iterator(node);
+}
+
+// Index создаются до изменения списка, поэтому исключение при выделении памяти ничего не ломает
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::link(Node* node, Path& path) {
+    const int height = random_level();
+    for (int level = levels_; level < height; ++level) {
+        path.lanes[level] = nullptr;
+    }
+    Index* tower[kMaxLevel];
+    int built = 0;
+    try {
+        for (; built < height; ++built) {
+            tower[built] = create_index(node, nullptr, built > 0 ? tower[built - 1] : nullptr);
+        }
+    } catch (...) {
+        while (built > 0) {
+            destroy_index(tower[--built]);
+        }
+        throw;
+    }
+    for (int level = 0; level < height; ++level) {
+        Index*& slot = path.lanes[level] ? path.lanes[level]->right : lanes_[level];
+        tower[level]->right = slot;
+        slot = tower[level];
+    }
+    Node*& base = path.base ? path.base->next : head_;
+    node->next = base;
+    base = node;
+    if (height > levels_) {
+        levels_ = height;
+    }
+    ++size_;
+}
+
+// добавляет узел в конец списка, tails хранит последние Index каждого уровня и последний узел
+// используется при копировании, когда элементы уже идут по порядку, и работает за O(1) на элемент
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::append(Node* node, Path& tails) {
+    try {
+        link(node, tails);
+    } catch (...) {
+        destroy_node(node);
+        throw;
+    }
+    tails.base = node;
+    for (int level = 0; level < levels_; ++level) {
+        if (Index* next = tails.lanes[level] ? tails.lanes[level]->right : lanes_[level]) {
+            tails.lanes[level] = next;
+        }
+    }
+}
+
+template <class T, class Compare, class Allocator>
+int SkipList<T, Compare, Allocator>::random_level() {
+    const std::uint32_t bits = static_cast<std::uint32_t>(random_());
+    int level = 0;
+    while (level < kMaxLevel && ((bits >> (2 * level)) & 3) == 0) {
+        ++level;
+    }
+    return level;
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+template <class... Args>
+typename SkipList<T, Compare, Allocator>::Node* SkipList<T, Compare, Allocator>::create_node(Args&&... args) {
+    Node* node = node_traits::allocate(node_alloc_, 1);
+    try {
+        node_traits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+        node_traits::deallocate(node_alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::destroy_node(Node* node) noexcept {
+    node_traits::destroy(node_alloc_, node);
+    node_traits::deallocate(node_alloc_, node, 1);
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::Index* SkipList<T, Compare, Allocator>::create_index(Node* node, Index* right, Index* down) {
+    Index* index = index_traits::allocate(index_alloc_, 1);
+    *index = Index{node, right, down};
+    return index;
+}
+
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::destroy_index(Index* index) noexcept {
+    index_traits::deallocate(index_alloc_, index, 1);
+}
+
+// элементы other уже отсортированы, поэтому копия строится добавлением в конец с новыми случайными высотами
+template <class T, class Compare, class Allocator>
+void SkipList<T, Compare, Allocator>::copy_from(const SkipList& other) {
+    Path tails{};
+    try {
+        for (const Node* node = other.head_; node; node = node->next) {
+            append(create_node(node->data), tails);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// =============================================================================
+
+template <class T, class Compare, class Allocator>
+SkipList<T, Compare, Allocator>::const_iterator::const_iterator(const Node* node) : node_(node) {}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_reference SkipList<T, Compare, Allocator>::const_iterator::operator*() const {
+    return node_->data;
+}
+
+template <class T, class Compare, class Allocator>
+typename SkipList<T, Compare, Allocator>::const_iterator& SkipList<T, Compare, Allocator>::const_iterator::operator++() {
+    node_ = node_->next;
+    return *this;
+}
+
+template <class T, class Compare, class Allocator>
+bool SkipList<T, Compare, Allocator>::const_iterator::operator==(const const_iterator& other) const {
+    return node_ == other.node_;
+}
+
+template <class T, class Compare, class Allocator>
+bool SkipList<T, Compare, Allocator>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+#endif  // SKIP_LIST_H
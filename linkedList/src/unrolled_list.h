@@ -0,0 +1,565 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include "pool_allocator.h"
+#include "simd_search.h"
+
+// развернутый (unrolled) односвязный список с тем же интерфейсом, что и LinkedList
+// каждый блок хранит до Capacity элементов подряд, поэтому обход и find идут по непрерывной памяти,
+// а переход по указателю происходит только раз на блок
+// по умолчанию Capacity подбирается так, чтобы блок занимал две кеш-линии
+
+// поскольку вставка и удаление бывают только в начале, заполнен не до конца может быть лишь головной блок
+// элементы блока лежат в ячейках [begin, Capacity), push_front кладет новый элемент в ячейку begin - 1,
+// поэтому порядок обхода совпадает с порядком адресов внутри блока
+// у всех блоков кроме головного begin == 0
+
+// для арифметических T блок выровнен по кеш-линии, так что занимает ровно две линии, а find и count сравнивают
+// элементы блока векторно (simd_search.h)
+// find_if и count_if проверяют блок целиком без раннего выхода, что компилятор может векторизовать: find_if за тот же
+// проход запоминает позицию первого совпадения, поэтому предикат вызывается по одному разу для каждого элемента
+// просмотренных блоков, в том числе для элементов после совпадения в его блоке
+
+template <class T>
+constexpr std::size_t UnrolledCapacity() {
+    constexpr std::size_t block_bytes = 128;
+    constexpr std::size_t header_bytes = sizeof(void*) + sizeof(std::size_t);
+    return sizeof(T) + header_bytes < block_bytes ? (block_bytes - header_bytes) / sizeof(T) : 1;
+}
+
+template <class T, std::size_t Capacity = UnrolledCapacity<T>(), class Allocator = PoolAllocator<T>>
+class UnrolledList {
+    static_assert(Capacity > 0, "UnrolledList block capacity must be positive");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr std::size_t block_capacity = Capacity;
+
+    UnrolledList();
+    explicit UnrolledList(const Allocator& alloc);
+    UnrolledList(const T& data);
+    UnrolledList(const UnrolledList& other);
+    UnrolledList(UnrolledList&& other) noexcept;
+    UnrolledList(std::initializer_list<T> il);
+    ~UnrolledList();
+
+    UnrolledList& operator=(const UnrolledList& other);
+    UnrolledList& operator=(UnrolledList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const;
+
+    reference front();
+    const_reference front() const;
+
+    class iterator;
+    class const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    bool empty() const noexcept;
+
+    void push_front(const T& value);
+    void push_front(T&& value);
+    void pop_front();
+    void clear() noexcept;
+
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+    template <class Predicate>
+    iterator find_if(Predicate predicate);
+    template <class Predicate>
+    const_iterator find_if(Predicate predicate) const;
+    std::size_t count(const T& value) const;
+    template <class Predicate>
+    std::size_t count_if(Predicate predicate) const;
+
+private:
+    static constexpr std::size_t kBlockAlign = std::is_arithmetic<T>::value ? 64 : 1;
+
+    // элементы идут первыми, чтобы у выровненного блока они начинались с границы кеш-линии
+    struct alignas(T) alignas(void*) alignas(kBlockAlign) Block {
+        alignas(T) unsigned char storage[sizeof(T) * Capacity];
+        Block* next;
+        std::size_t begin;
+
+        Block() : next(nullptr), begin(Capacity) {}
+
+        T* slot(std::size_t index) { return std::launder(reinterpret_cast<T*>(storage) + index); }
+        const T* slot(std::size_t index) const { return std::launder(reinterpret_cast<const T*>(storage) + index); }
+    };
+
+    using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using block_traits = std::allocator_traits<block_allocator>;
+
+    Block* create_block();
+    void destroy_block(Block* block) noexcept;
+    template <class U>
+    void emplace_front_value(U&& value);
+    Block* copy_blocks(const Block* first);
+    void destroy_chain(Block* block) noexcept;
+    const T* find_in_block(const Block* block, const T& value) const;
+    template <class Predicate>
+    static const T* find_if_in_block(const Block* block, Predicate& predicate);
+
+    block_allocator alloc_;
+    Block* head_;
+
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(Block* block, std::size_t index);
+
+        reference operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+    private:
+        Block* block_;
+        std::size_t index_;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator() = default;
+        const_iterator(const Block* block, std::size_t index);
+
+        const_reference operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        const Block* block_;
+        std::size_t index_;
+    };
+};
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList() : UnrolledList(Allocator()) {}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList(const Allocator& alloc) : alloc_(alloc), head_(nullptr) {}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList(const T& data) : UnrolledList() {
+    push_front(data);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList(const UnrolledList& other)
+    : alloc_(block_traits::select_on_container_copy_construction(other.alloc_)), head_(nullptr) {
+    head_ = copy_blocks(other.head_);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList(UnrolledList&& other) noexcept
+    : alloc_(other.alloc_), head_(other.head_) {
+    other.head_ = nullptr;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::UnrolledList(std::initializer_list<T> il) : UnrolledList() {
+    try {
+        for (auto it = il.end(); it != il.begin();) {
+            --it;
+            push_front(*it);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::~UnrolledList() {
+    clear();
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>& UnrolledList<T, Capacity, Allocator>::operator=(const UnrolledList& other) {
+    if (this != &other) {
+        if constexpr (block_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) {
+                clear();
+                alloc_ = other.alloc_;
+            }
+        }
+        Block* copy = copy_blocks(other.head_);
+        clear();
+        head_ = copy;
+    }
+    return *this;
+}
+
+// при неравных и нераспространяемых аллокаторах блоки копируются поэлементно с перемещением
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>& UnrolledList<T, Capacity, Allocator>::operator=(UnrolledList&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this != &other) {
+        clear();
+        if constexpr (block_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = other.alloc_;
+        } else if (alloc_ != other.alloc_) {
+            Block** tail = &head_;
+            for (Block* block = other.head_; block; block = block->next) {
+                *tail = create_block();
+                for (std::size_t i = Capacity; i > block->begin; --i) {
+                    ::new (static_cast<void*>((*tail)->slot(i - 1))) T(std::move(*block->slot(i - 1)));
+                    --(*tail)->begin;
+                }
+                tail = &(*tail)->next;
+            }
+            other.clear();
+            return *this;
+        }
+        head_ = other.head_;
+        other.head_ = nullptr;
+    }
+    return *this;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::allocator_type UnrolledList<T, Capacity, Allocator>::get_allocator() const {
+    return allocator_type(alloc_);
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::reference UnrolledList<T, Capacity, Allocator>::front() {
+    if (!head_) {
+        throw std::runtime_error("UnrolledList is empty");
+    }
+    return *head_->slot(head_->begin);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_reference UnrolledList<T, Capacity, Allocator>::front() const {
+    if (!head_) {
+        throw std::runtime_error("UnrolledList is empty");
+    }
+    return *head_->slot(head_->begin);
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::iterator UnrolledList<T, Capacity, Allocator>::begin() {
+    if (!head_) {
+        throw std::runtime_error("UnrolledList is empty");
+    }
+    return iterator(head_, head_->begin);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::iterator UnrolledList<T, Capacity, Allocator>::end() {
+    return iterator(nullptr, 0);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_iterator UnrolledList<T, Capacity, Allocator>::cbegin() const {
+    if (!head_) {
+        throw std::runtime_error("UnrolledList is empty");
+    }
+    return const_iterator(head_, head_->begin);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_iterator UnrolledList<T, Capacity, Allocator>::cend() const {
+    return const_iterator(nullptr, 0);
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+bool UnrolledList<T, Capacity, Allocator>::empty() const noexcept {
+    return head_ == nullptr;
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::push_front(const T& value) {
+    emplace_front_value(value);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::push_front(T&& value) {
+    emplace_front_value(std::move(value));
+}
+
+// опустевший головной блок сразу освобождается, поэтому пустых блоков в списке не бывает
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::pop_front() {
+    if (head_) {
+        head_->slot(head_->begin)->~T();
+        if (++head_->begin == Capacity) {
+            Block* next = head_->next;
+            destroy_block(head_);
+            head_ = next;
+        }
+    }
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::clear() noexcept {
+    destroy_chain(head_);
+    head_ = nullptr;
+}
+
+// =============================================================================
+
+// внутри блока сравнение идет по подряд лежащим элементам без переходов по указателям
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::iterator UnrolledList<T, Capacity, Allocator>::find(const T& value) {
+    for (Block* block = head_; block; block = block->next) {
+        if (const T* hit = find_in_block(block, value)) {
+            return iterator(block, static_cast<std::size_t>(hit - block->slot(0)));
+        }
+    }
+    return end();
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_iterator UnrolledList<T, Capacity, Allocator>::find(const T& value) const {
+    for (const Block* block = head_; block; block = block->next) {
+        if (const T* hit = find_in_block(block, value)) {
+            return const_iterator(block, static_cast<std::size_t>(hit - block->slot(0)));
+        }
+    }
+    return cend();
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+template <class Predicate>
+typename UnrolledList<T, Capacity, Allocator>::iterator UnrolledList<T, Capacity, Allocator>::find_if(Predicate predicate) {
+    for (Block* block = head_; block; block = block->next) {
+        if (const T* hit = find_if_in_block(block, predicate)) {
+            return iterator(block, static_cast<std::size_t>(hit - block->slot(0)));
+        }
+    }
+    return end();
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+template <class Predicate>
+typename UnrolledList<T, Capacity, Allocator>::const_iterator UnrolledList<T, Capacity, Allocator>::find_if(Predicate predicate) const {
+    for (const Block* block = head_; block; block = block->next) {
+        if (const T* hit = find_if_in_block(block, predicate)) {
+            return const_iterator(block, static_cast<std::size_t>(hit - block->slot(0)));
+        }
+    }
+    return cend();
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+std::size_t UnrolledList<T, Capacity, Allocator>::count(const T& value) const {
+    std::size_t result = 0;
+    for (const Block* block = head_; block; block = block->next) {
+        if constexpr (simd::is_searchable<T>()) {
+            result += simd::count(block->slot(block->begin), block->slot(0) + Capacity, value);
+        } else {
+            for (std::size_t i = block->begin; i < Capacity; ++i) {
+                result += *block->slot(i) == value;
+            }
+        }
+    }
+    return result;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+template <class Predicate>
+std::size_t UnrolledList<T, Capacity, Allocator>::count_if(Predicate predicate) const {
+    std::size_t result = 0;
+    for (const Block* block = head_; block; block = block->next) {
+        const T* values = block->slot(0);
+        for (std::size_t i = block->begin; i < Capacity; ++i) {
+            result += static_cast<bool>(predicate(values[i]));
+        }
+    }
+    return result;
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::Block* UnrolledList<T, Capacity, Allocator>::create_block() {
+    Block* block = block_traits::allocate(alloc_, 1);
+    ::new (static_cast<void*>(block)) Block();
+    return block;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::destroy_block(Block* block) noexcept {
+    block->~Block();
+    block_traits::deallocate(alloc_, block, 1);
+}
+
+// если головной блок заполнен, перед ним ставится новый
+// если конструктор элемента бросает исключение, только что созданный пустой блок освобождается
+template <class T, std::size_t Capacity, class Allocator>
+template <class U>
+void UnrolledList<T, Capacity, Allocator>::emplace_front_value(U&& value) {
+    if (head_ && head_->begin > 0) {
+        ::new (static_cast<void*>(head_->slot(head_->begin - 1))) T(std::forward<U>(value));
+        --head_->begin;
+        return;
+    }
+    Block* block = create_block();
+    try {
+        ::new (static_cast<void*>(block->slot(Capacity - 1))) T(std::forward<U>(value));
+    } catch (...) {
+        destroy_block(block);
+        throw;
+    }
+    block->begin = Capacity - 1;
+    block->next = head_;
+    head_ = block;
+}
+
+// копия повторяет раскладку оригинала, включая заполненность головного блока
+// блок подключается к цепочке до заполнения и заполняется с конца,
+// поэтому при исключении destroy_chain корректно уничтожает уже скопированное
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::Block* UnrolledList<T, Capacity, Allocator>::copy_blocks(const Block* first) {
+    Block* head = nullptr;
+    Block** tail = &head;
+    try {
+        for (; first; first = first->next) {
+            *tail = create_block();
+            for (std::size_t i = Capacity; i > first->begin; --i) {
+                ::new (static_cast<void*>((*tail)->slot(i - 1))) T(*first->slot(i - 1));
+                --(*tail)->begin;
+            }
+            tail = &(*tail)->next;
+        }
+    } catch (...) {
+        destroy_chain(head);
+        throw;
+    }
+    return head;
+}
+
+// указатель на первое совпадение в блоке или nullptr
+template <class T, std::size_t Capacity, class Allocator>
+const T* UnrolledList<T, Capacity, Allocator>::find_in_block(const Block* block, const T& value) const {
+    const T* first = block->slot(block->begin);
+    const T* last = block->slot(0) + Capacity;
+    if constexpr (simd::is_searchable<T>()) {
+        const T* hit = simd::find(first, last, value);
+        return hit != last ? hit : nullptr;
+    } else {
+        for (; first != last; ++first) {
+            if (*first == value) {
+                return first;
+            }
+        }
+        return nullptr;
+    }
+}
+
+// блок проходится с конца без ветвлений внутри цикла, и последняя записанная позиция - первое совпадение
+template <class T, std::size_t Capacity, class Allocator>
+template <class Predicate>
+const T* UnrolledList<T, Capacity, Allocator>::find_if_in_block(const Block* block, Predicate& predicate) {
+    const T* values = block->slot(0);
+    std::size_t hit = Capacity;
+    for (std::size_t i = Capacity; i > block->begin; --i) {
+        hit = predicate(values[i - 1]) ? i - 1 : hit;
+    }
+    return hit < Capacity ? values + hit : nullptr;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+void UnrolledList<T, Capacity, Allocator>::destroy_chain(Block* block) noexcept {
+    while (block) {
+        Block* next = block->next;
+        for (std::size_t i = block->begin; i < Capacity; ++i) {
+            block->slot(i)->~T();
+        }
+        destroy_block(block);
+        block = next;
+    }
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::iterator::iterator(Block* block, std::size_t index) : block_(block), index_(index) {}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::reference UnrolledList<T, Capacity, Allocator>::iterator::operator*() const {
+    return *block_->slot(index_);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::iterator& UnrolledList<T, Capacity, Allocator>::iterator::operator++() {
+    if (++index_ == Capacity) {
+        block_ = block_->next;
+        index_ = 0;
+    }
+    return *this;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+bool UnrolledList<T, Capacity, Allocator>::iterator::operator==(const iterator& other) const {
+    return block_ == other.block_ && index_ == other.index_;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+bool UnrolledList<T, Capacity, Allocator>::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+template <class T, std::size_t Capacity, class Allocator>
+UnrolledList<T, Capacity, Allocator>::const_iterator::const_iterator(const Block* block, std::size_t index)
+    : block_(block), index_(index) {}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_reference UnrolledList<T, Capacity, Allocator>::const_iterator::operator*() const {
+    return *block_->slot(index_);
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+typename UnrolledList<T, Capacity, Allocator>::const_iterator& UnrolledList<T, Capacity, Allocator>::const_iterator::operator++() {
+    if (++index_ == Capacity) {
+        block_ = block_->next;
+        index_ = 0;
+    }
+    return *this;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+bool UnrolledList<T, Capacity, Allocator>::const_iterator::operator==(const const_iterator& other) const {
+    return block_ == other.block_ && index_ == other.index_;
+}
+
+template <class T, std::size_t Capacity, class Allocator>
+bool UnrolledList<T, Capacity, Allocator>::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+// =============================================================================
+
+#endif  // UNROLLED_LIST_H
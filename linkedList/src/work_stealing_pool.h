@@ -0,0 +1,214 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// пул потоков с кражей работы для параллельных алгоритмов над списками (parallel_list.h)
+// у каждого рабочего потока своя очередь: свои задачи он берет с конца, а закончив их, крадет с начала чужих очередей,
+// поэтому неравные по времени куски работы сами распределяются между потоками
+// очереди - std::deque под своим мьютексом: задач в одном запуске немного (несколько на поток), и блокировка
+// на задачу не заметна на фоне обхода куска списка, а очередь Чейза-Лева без блокировок здесь ничего не даст
+
+// run(count, task) вызывает task(0) ... task(count - 1) и возвращается, когда все вызовы закончились
+// вызвавший поток не ждет без дела, а выполняет задачи наравне с рабочими, поэтому concurrency() потоков - это
+// concurrency() - 1 рабочих и сам вызывающий; run можно звать изнутри задачи и из нескольких потоков одновременно
+// если задача бросает исключение, еще не начатые задачи того же run пропускаются, а первое исключение
+// пробрасывается из run после завершения уже начатых
+
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t concurrency = std::thread::hardware_concurrency());
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool();
+
+    std::size_t concurrency() const noexcept;
+
+    template <class Task>
+    void run(std::size_t count, Task&& task);
+
+private:
+    // один вызов run: счетчик невыполненных задач и первое исключение
+    struct Job {
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> failed;
+        std::exception_ptr error;
+        bool done;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        explicit Job(std::size_t count) : remaining(count), failed(false), done(false) {}
+    };
+
+    struct Item {
+        void (*invoke)(void* task, std::size_t index);
+        void* task;
+        std::size_t index;
+        Job* job;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Item> items;
+    };
+
+    bool pop(std::size_t self, Item& item);
+    bool steal(std::size_t self, Item& item);
+    void execute(const Item& item) noexcept;
+    void work(std::size_t self);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> pending_;
+    bool stop_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+};
+
+// =============================================================================
+
+// concurrency 0 (hardware_concurrency не смог ответить) считается за 1: все задачи выполняет вызывающий поток
+inline WorkStealingPool::WorkStealingPool(std::size_t concurrency) : pending_(0), stop_(false) {
+    const std::size_t workers = concurrency > 1 ? concurrency - 1 : 0;
+    for (std::size_t i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+// деструктор не может выполняться одновременно с run
+inline WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+inline std::size_t WorkStealingPool::concurrency() const noexcept {
+    return threads_.size() + 1;
+}
+
+// =============================================================================
+
+// задачи раскладываются по очередям по кругу и в обратном порядке, так что каждый поток начинает со своей
+// задачи с наименьшим номером; вызывающий поток своей очереди не имеет и только крадет
+template <class Task>
+void WorkStealingPool::run(std::size_t count, Task&& task) {
+    if (queues_.empty() || count <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    using Callable = std::remove_reference_t<Task>;
+    auto invoke = [](void* callable, std::size_t index) { (*static_cast<Callable*>(callable))(index); };
+    void* callable = const_cast<void*>(static_cast<const void*>(std::addressof(task)));
+    Job job(count);
+    pending_.fetch_add(count);
+    for (std::size_t i = count; i-- > 0;) {
+        Queue& queue = *queues_[i % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(Item{invoke, callable, i, &job});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+    Item item;
+    while (job.remaining.load() > 0 && steal(queues_.size(), item)) {
+        execute(item);
+    }
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.finished.wait(lock, [&job] { return job.done; });
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+// =============================================================================
+
+inline bool WorkStealingPool::pop(std::size_t self, Item& item) {
+    Queue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.items.empty()) {
+        return false;
+    }
+    item = queue.items.back();
+    queue.items.pop_back();
+    pending_.fetch_sub(1);
+    return true;
+}
+
+// обходит чужие очереди, начиная со следующей за своей; self == queues_.size() - вызывающий поток без очереди
+inline bool WorkStealingPool::steal(std::size_t self, Item& item) {
+    const std::size_t count = queues_.size();
+    for (std::size_t i = 1; i <= count; ++i) {
+        Queue& queue = *queues_[(self + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.items.empty()) {
+            item = queue.items.front();
+            queue.items.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// последняя задача запуска будит его владельца под мьютексом, поэтому Job на его стеке живет, пока о нем помнят
+inline void WorkStealingPool::execute(const Item& item) noexcept {
+    Job& job = *item.job;
+    if (!job.failed.load()) {
+        try {
+            item.invoke(item.task, item.index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+            job.failed.store(true);
+        }
+    }
+    if (job.remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        job.done = true;
+        job.finished.notify_all();
+    }
+}
+
+// pending_ растет раньше, чем задачи попадают в очереди, поэтому проснувшийся поток может пару раз обойти их впустую
+inline void WorkStealingPool::work(std::size_t self) {
+    Item item;
+    for (;;) {
+        if (pop(self, item) || steal(self, item)) {
+            execute(item);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+// =============================================================================
+
+#endif  // WORK_STEALING_POOL_H